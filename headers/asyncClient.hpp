@@ -0,0 +1,337 @@
+#pragma once
+#include "reactor.hpp"
+#include "task.hpp"
+
+#include <sys/uio.h>        // For struct iovec
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <coroutine>
+#include <cstdint>
+#include <cerrno>
+
+namespace socketstuffs{
+
+/*what co_await recvFrame() gives back*/
+struct AsyncFrame{
+    int status;                         // 1, or the error tryGetPacket() returned
+    std::string id;
+    std::string message;
+};
+
+/*A connected Client driven by a Reactor, for coroutines:
+    co_await recvFrame()            -> the next packet
+    co_await sendFrame(id, message) -> once it's all been sent
+so request/response code reads like sendQuery(), but a coroutine
+waiting on one of them is just suspended (no thread, no poll()),
+and one Reactor thread keeps thousands of conversations going
+
+the fd is added to the Reactor (edge-triggered, READABLE and
+WRITABLE), and its handler does the tryGetPacket()s and sends for
+whoever is waiting, then resumes them. Everything (the co_awaits,
+making and destroying it) has to happen on the Reactor's thread
+
+one recvFrame() at a time (another one while it's waiting gets
+ALREADYBUSY). Any number of sendFrame()s can wait at once, their
+packets go out in the order they were co_await-ed
+
+sendFrame() sends raw (no compression, like sendPackets()), first
+straight from message and, if the socket is full, from a copy of
+what's left that's kept until the socket has room again
+
+don't use the Client directly while this is watching it (and don't
+give it the reader thread or io_uring), and destroy this before the
+Client is closed. Nothing may be waiting on it when it's destroyed
+(it can be destroyed by a coroutine it just resumed)
+*/
+template<typename Codec>
+class BasicAsyncClient{
+    public:
+        class RecvAwaiter{
+            private:
+                BasicAsyncClient& owner;
+                AsyncFrame frame;
+                std::coroutine_handle<> waiting;
+
+                friend class BasicAsyncClient;
+
+            public:
+                inline explicit RecvAwaiter(BasicAsyncClient& owner) : owner(owner), frame{0, {}, {}}{}
+
+                /*ready if a packet (or an error) is already there*/
+                inline bool await_ready(){
+                    if(owner.reader != nullptr){
+                        frame.status = ALREADYBUSY;
+                        return true;
+                    }
+                    return owner.receive(frame);
+                }
+
+                inline void await_suspend(std::coroutine_handle<> handle){
+                    waiting = handle;
+                    owner.reader = this;
+                }
+
+                inline AsyncFrame await_resume(){
+                    return std::move(frame);
+                }
+        };
+
+        class SendAwaiter{
+            private:
+                BasicAsyncClient& owner;
+                std::string_view id;
+                std::string_view message;
+                uint64_t target;                // done once this many bytes were sent
+                int status;
+                std::coroutine_handle<> waiting;
+
+                friend class BasicAsyncClient;
+
+            public:
+                inline SendAwaiter(BasicAsyncClient& owner, std::string_view id, std::string_view message) :
+                                    owner(owner), id(id), message(message), target(0), status(0){}
+
+                /*ready if it all went out right away (or can't go out)*/
+                inline bool await_ready(){
+                    return owner.queue(*this);
+                }
+
+                inline void await_suspend(std::coroutine_handle<> handle){
+                    waiting = handle;
+                    owner.senders.push_back(this);
+                }
+
+                inline int await_resume(){
+                    return status;
+                }
+        };
+
+    private:
+        BasicClient<Codec>& client;
+        Reactor& reactor;
+        int fd;
+
+        RecvAwaiter* reader;                // waiting for a packet
+        std::deque<SendAwaiter*> senders;   // waiting for their bytes, oldest first
+
+        //bytes the socket had no room for yet, from outboxHead on
+        std::string outbox;
+        size_t outboxHead;
+        uint64_t queuedBytes;               // everything sendFrame() took so far
+        uint64_t sentBytes;                 // and how much of it went out
+        int sendError;                      // once sending failed it stays failed
+
+        /*tryGetPacket() until there's a packet or an error (true) or
+        the socket is drained (false, wait for the next edge)*/
+        inline bool receive(AsyncFrame& frame){
+            while(true){
+                int val = client.tryGetPacket(frame.id, frame.message);
+                if(val != 0){
+                    frame.status = val;
+                    return true;
+                }
+                if(client.isDrained()){
+                    return false;
+                }
+            }
+        }
+
+        /*sends as much of the outbox as the socket takes
+        returns 1, or BADSEND or SENDCLOSE*/
+        inline int flush(){
+            while(outboxHead < outbox.size()){
+                ssize_t val = ::send(fd, outbox.data() + outboxHead, outbox.size() - outboxHead,
+                                        MSG_DONTWAIT | MSG_NOSIGNAL);
+                if(val == -1){
+                    if(errno == EINTR){
+                        continue;
+                    }
+                    if(errno == EAGAIN || errno == EWOULDBLOCK){
+                        return 1;
+                    }
+                    return errno == EPIPE || errno == ECONNRESET ? SENDCLOSE : BADSEND;
+                }
+                outboxHead += val;
+                sentBytes += val;
+            }
+            //all out, start over at the front (keeping the capacity)
+            outbox.clear();
+            outboxHead = 0;
+            return 1;
+        }
+
+        /*what SendAwaiter::await_ready() does: sends the packet (or
+        what it can of it) right away, and keeps the rest
+        returns true if it's done (status says how it went)*/
+        inline bool queue(SendAwaiter& sender){
+            if(sendError != 1){
+                sender.status = sendError;
+                return true;
+            }
+            if(!Codec::idFits(sender.id.size())){
+                sender.status = IDTOOBIG;
+                return true;
+            }
+            if(!Codec::messageFits(sender.message.size())){
+                sender.status = MSGTOOBIG;
+                return true;
+            }
+
+            typename Codec::Header header;
+            Codec::encode(header, sender.message.size(), sender.id);
+            size_t total = header.size() + sender.message.size();
+            queuedBytes += total;
+            sender.target = queuedBytes;
+
+            size_t sent = 0;
+            if(outboxHead == outbox.size()){
+                //nothing ahead of it, so try without copying it first
+                struct iovec parts[2];
+                parts[0].iov_base = header.data();
+                parts[0].iov_len = header.size();
+                parts[1].iov_base = const_cast<char*>(sender.message.data());
+                parts[1].iov_len = sender.message.size();
+                struct msghdr msg = {};
+                msg.msg_iov = parts;
+                msg.msg_iovlen = 2;
+                ssize_t val;
+                do{
+                    val = ::sendmsg(fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+                }while(val == -1 && errno == EINTR);
+                if(val == -1 && errno != EAGAIN && errno != EWOULDBLOCK){
+                    fail(errno == EPIPE || errno == ECONNRESET ? SENDCLOSE : BADSEND);
+                    sender.status = sendError;
+                    return true;
+                }
+                if(val > 0){
+                    sent = val;
+                    sentBytes += sent;
+                }
+                if(sent == total){
+                    sender.status = 1;
+                    return true;
+                }
+            }
+
+            //keep whatever didn't go out
+            if(sent < header.size()){
+                outbox.append(header.data() + sent, header.size() - sent);
+                outbox.append(sender.message);
+            }
+            else{
+                outbox.append(sender.message.substr(sent - header.size()));
+            }
+            return false;
+        }
+
+        /*every send from now on fails with error*/
+        inline void fail(int error){
+            sendError = error;
+            outbox.clear();
+            outboxHead = 0;
+        }
+
+        /*the Reactor handler: does the work for whoever waits and then
+        resumes them (last, a resumed coroutine may destroy this)*/
+        inline void onEvents(uint32_t events){
+            std::coroutine_handle<> readerDone;
+            if(reader != nullptr && (events & (READABLE | HANGUP))){
+                if(receive(reader->frame)){
+                    readerDone = reader->waiting;
+                    reader = nullptr;
+                }
+            }
+
+            std::vector<std::coroutine_handle<>> sendersDone;
+            if(!senders.empty() && (events & (WRITABLE | HANGUP))){
+                int val = flush();
+                if(val != 1){
+                    fail(val);
+                }
+                while(!senders.empty() && (sendError != 1 || senders.front()->target <= sentBytes)){
+                    senders.front()->status = sendError;
+                    sendersDone.push_back(senders.front()->waiting);
+                    senders.pop_front();
+                }
+            }
+
+            for(std::coroutine_handle<> sender : sendersDone){
+                sender.resume();
+            }
+            if(readerDone){
+                readerDone.resume();
+            }
+        }
+
+    public:
+        /*starts watching client (connected) on reactor
+        throws a runtime_error if it isn't connected or the Reactor
+        doesn't take it*/
+        inline BasicAsyncClient(BasicClient<Codec>& client, Reactor& reactor) :
+                                client(client), reactor(reactor), fd(client.getFd()), reader(nullptr),
+                                outboxHead(0), queuedBytes(0), sentBytes(0), sendError(1){
+            if(fd == -1){
+                throw std::runtime_error("ERROR: client is not connected\n"
+                                         "in the constructor of AsyncClient in asyncClient.hpp");
+            }
+            if(reactor.add(fd, READABLE | WRITABLE, [this](uint32_t events){ onEvents(events); }) != 1){
+                throw std::runtime_error("ERROR: the Reactor would not watch the client\n"
+                                         "in the constructor of AsyncClient in asyncClient.hpp");
+            }
+        }
+
+        //Removed copy constructor because the Reactor's handler points at this one
+        BasicAsyncClient(const BasicAsyncClient&) = delete;
+        BasicAsyncClient& operator=(const BasicAsyncClient&) = delete;
+
+        inline ~BasicAsyncClient(){
+            reactor.remove(fd);
+        }
+
+        /*co_await it for the next packet, status is:
+            1 with id and message filled in
+            ALREADYBUSY if another recvFrame() is still waiting
+            MSGTOOBIG, BADRECV, READCLOSE, ... like tryGetPacket()*/
+        inline RecvAwaiter recvFrame(){
+            return RecvAwaiter(*this);
+        }
+
+        /*co_await it to send a packet (same format as sendPacket),
+        gives back:
+            1 once it's all been handed to the socket
+            IDTOOBIG or MSGTOOBIG (nothing is sent)
+            BADSEND or SENDCLOSE (and so does every send after it)
+
+        id and message only have to last until the co_await starts*/
+        inline SendAwaiter sendFrame(std::string_view id, std::string_view message){
+            return SendAwaiter(*this, id, message);
+        }
+
+        /*sends message and waits for the packet that comes back, the
+        sendQuery() of coroutines (status is the send's error if that
+        failed)*/
+        inline tasks::Task<AsyncFrame> query(std::string id, std::string message){
+            int val = co_await sendFrame(id, message);
+            if(val != 1){
+                co_return AsyncFrame{val, {}, {}};
+            }
+            co_return co_await recvFrame();
+        }
+
+        /*bytes taken by sendFrame() that haven't gone out yet*/
+        inline size_t getPendingBytes(){
+            return outbox.size() - outboxHead;
+        }
+
+        inline BasicClient<Codec>& getClient(){
+            return client;
+        }
+};
+
+/*the AsyncClient everything uses (Clients with the 3 byte size)*/
+using AsyncClient = BasicAsyncClient<framing::DefaultCodec>;
+
+}
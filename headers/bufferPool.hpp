@@ -0,0 +1,173 @@
+#pragma once
+#include "sharedstuff.hpp"
+
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <cstddef>
+
+namespace bufferpool{
+    const size_t SMALLESTCLASS = 256;               // the smallest buffer handed out
+    const size_t CLASSCOUNT = 13;                   // 256 B, 512 B, ..., 1 MB
+    const size_t LARGESTCLASS = SMALLESTCLASS << (CLASSCOUNT - 1);
+    const size_t MAXPERCLASS = 8;                   // how many free buffers each
+                                                    // class keeps around
+
+    static_assert(LARGESTCLASS == sharedstuff::Megabyte);
+
+    /*the free buffers of a pool, shared with every handle it gave out
+    so a handle can still give its buffer back (or just free it) even
+    if the pool is gone by then*/
+    struct Shelves{
+        std::mutex lock;
+        std::array<std::vector<std::string>, CLASSCOUNT> free;
+        size_t reused = 0;          // get() calls that didn't allocate
+        size_t allocated = 0;       // and ones that did
+    };
+
+    /*A message buffer borrowed from a BufferPool
+    (RAII, it goes back to the pool when the handle is destroyed or
+    release() is called)
+
+    move-only, so a buffer only ever has one owner
+    */
+    class PooledBuffer{
+    private:
+        std::string data;
+        std::shared_ptr<Shelves> shelves;      // where it goes back to (none if empty)
+
+    public:
+        PooledBuffer() = default;
+
+        inline PooledBuffer(std::string data, std::shared_ptr<Shelves> shelves) :
+                                data(std::move(data)), shelves(std::move(shelves)){}
+
+        PooledBuffer(const PooledBuffer&) = delete;
+        PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+        inline PooledBuffer(PooledBuffer&& other) noexcept :
+                                data(std::move(other.data)), shelves(std::move(other.shelves)){}
+
+        inline PooledBuffer& operator=(PooledBuffer&& other) noexcept{
+            if(this != &other){
+                release();
+                data = std::move(other.data);
+                shelves = std::move(other.shelves);
+            }
+            return *this;
+        }
+
+        inline ~PooledBuffer(){
+            release();
+        }
+
+        /*the buffer itself (fill it like any string, but keep it
+        in its size class or it won't be reused)*/
+        inline std::string& str(){
+            return data;
+        }
+
+        inline const std::string& str() const{
+            return data;
+        }
+
+        inline std::string_view view() const{
+            return data;
+        }
+
+        inline size_t size() const{
+            return data.size();
+        }
+
+        /*gives the buffer back to its pool now (the handle ends up empty)*/
+        inline void release(){
+            if(!shelves){
+                return;
+            }
+            size_t capacity = data.capacity();
+            if(capacity >= SMALLESTCLASS && capacity <= 2 * LARGESTCLASS){
+                //the biggest class that fits in it
+                size_t sizeClass = 0;
+                while(sizeClass + 1 < CLASSCOUNT && (SMALLESTCLASS << (sizeClass + 1)) <= capacity){
+                    sizeClass++;
+                }
+                data.clear();
+                std::lock_guard<std::mutex> guard(shelves->lock);
+                std::vector<std::string>& shelf = shelves->free[sizeClass];
+                if(shelf.size() < MAXPERCLASS){
+                    shelf.push_back(std::move(data));
+                }
+            }
+            data = std::string();
+            shelves.reset();
+        }
+    };
+
+    /*Hands out message buffers in power of two size classes
+    (SMALLESTCLASS up to LARGESTCLASS) and takes them back when their
+    PooledBuffer is done with them, so once a connection has seen
+    its usual message sizes, receiving doesn't allocate anymore
+
+    safe to use from more than one thread (it's a mutex, but it's
+    only held to move one string in or out)
+    */
+    class BufferPool{
+    private:
+        std::shared_ptr<Shelves> shelves;
+
+    public:
+        inline BufferPool() : shelves(std::make_shared<Shelves>()){}
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        /*an empty buffer that can hold at least size bytes without
+        allocating (bigger than LARGESTCLASS is allocated every time
+        and never pooled)*/
+        inline PooledBuffer get(size_t size){
+            size_t sizeClass = 0;
+            while(sizeClass < CLASSCOUNT && (SMALLESTCLASS << sizeClass) < size){
+                sizeClass++;
+            }
+
+            std::string data;
+            if(sizeClass < CLASSCOUNT){
+                std::unique_lock<std::mutex> guard(shelves->lock);
+                std::vector<std::string>& shelf = shelves->free[sizeClass];
+                if(!shelf.empty()){
+                    data = std::move(shelf.back());
+                    shelf.pop_back();
+                    shelves->reused++;
+                    return PooledBuffer(std::move(data), shelves);
+                }
+                shelves->allocated++;
+                guard.unlock();
+                data.reserve(SMALLESTCLASS << sizeClass);
+            }
+            else{
+                std::lock_guard<std::mutex> guard(shelves->lock);
+                shelves->allocated++;
+            }
+            if(data.capacity() < size){
+                data.reserve(size);
+            }
+            return PooledBuffer(std::move(data), shelves);
+        }
+
+        /*how many get() calls were handed a buffer that was given back*/
+        inline size_t getReused(){
+            std::lock_guard<std::mutex> guard(shelves->lock);
+            return shelves->reused;
+        }
+
+        /*how many get() calls had to allocate a new buffer*/
+        inline size_t getAllocated(){
+            std::lock_guard<std::mutex> guard(shelves->lock);
+            return shelves->allocated;
+        }
+    };
+}
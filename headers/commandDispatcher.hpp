@@ -0,0 +1,136 @@
+#pragma once
+#include "server.hpp"
+#include "workStealingPool.hpp"
+#include "commandListings.hpp"
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+namespace socketstuffs{
+
+/*Runs the commands that come in as packets on a WorkStealingPool,
+instead of on the Reactor thread that received them, and sends
+each one's reply back once it's done
+
+a packet's message is the command: its first word (up to the first
+space) picks which added command runs, and the whole message is
+what executeCommand() gets. The reply goes to the same client with
+the same id, through the Reactor of the Server it came from, so
+every sendPacket() still happens on the I/O thread and one slow
+command only holds up a worker, not the other peers
+
+replies to one client can come back in a different order than the
+commands went in (they run at the same time). A reply for a client
+that hung up (or whose fd is already someone else's) is dropped, and
+so is one the Reactor had no room for within REPLYPOSTTIMER ms (it
+was stopped and isn't emptying its queue), so the worker doesn't
+wait on it forever
+
+add every command before packets start coming in, the table isn't
+locked. Stop the pool before the Server (or its Reactor) goes away,
+a command still running would post its reply to it
+*/
+template<typename Codec>
+class BasicCommandDispatcher{
+    private:
+        executor::WorkStealingPool& pool;
+        std::map<std::string, std::shared_ptr<commands::AbstractCommand>, std::less<>> registry;
+
+        std::atomic<uint64_t> completed;    // replies sent
+        std::atomic<uint64_t> dropped;      // replies whose client was gone (or
+                                            // that couldn't be posted)
+
+        /*runs on the Reactor thread once command is done*/
+        inline void finish(BasicServer<Codec>& server, int fd, uint64_t serial,
+                            const std::string& id, const std::string& reply){
+            BasicClient<Codec>* client = server.getClient(fd);
+            if(client == nullptr || server.getClientSerial(fd) != serial){
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            client->sendPacket(id, reply);
+            completed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    public:
+        inline BasicCommandDispatcher(executor::WorkStealingPool& pool) : pool(pool), completed(0), dropped(0){}
+
+        BasicCommandDispatcher(const BasicCommandDispatcher&) = delete;
+        BasicCommandDispatcher& operator=(const BasicCommandDispatcher&) = delete;
+
+        /*packets whose first word is name run command (replaces one
+        that was added with the same name)*/
+        inline void addCommand(const std::string& name, std::shared_ptr<commands::AbstractCommand> command){
+            registry[name] = std::move(command);
+        }
+
+        /*what the Server's onPacket calls (on its Reactor thread):
+        hands message to its command on the pool
+
+        returns 1 once it's queued
+        returns UNKNOWNCOMMAND if no command has that name (that's
+            sent back as the reply right away)
+        returns NOTOPENED if the pool was stopped*/
+        inline int dispatch(BasicServer<Codec>& server, BasicClient<Codec>& client,
+                            const std::string& id, const std::string& message){
+            std::string_view name(message);
+            name = name.substr(0, name.find(' '));
+            auto found = registry.find(name);
+            if(found == registry.end()){
+                client.sendPacket(id, std::to_string(UNKNOWNCOMMAND));
+                return UNKNOWNCOMMAND;
+            }
+
+            int fd = client.getFd();
+            uint64_t serial = server.getClientSerial(fd);
+            std::shared_ptr<commands::AbstractCommand> command = found->second;
+            bool queued = pool.submit([this, &server, fd, serial, command, id, message]{
+                std::string reply;
+                try{
+                    command->executeCommand(message, reply);
+                }
+                catch(const std::exception&){
+                    reply = std::to_string(COMMANDFAILED);
+                }
+                //the Reactor's queue can be full for a moment if a lot
+                // finish at once, the worker just waits its turn (but
+                // not forever, a stopped Reactor never empties it)
+                Reactor& reactor = server.getReactor();
+                auto done = [this, &server, fd, serial, id, reply = std::move(reply)]{
+                    finish(server, fd, serial, id, reply);
+                };
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(REPLYPOSTTIMER);
+                while(reactor.post(done) != 1){
+                    if(std::chrono::steady_clock::now() >= deadline){
+                        dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    std::this_thread::yield();
+                }
+            });
+            return queued ? 1 : NOTOPENED;
+        }
+
+        /*how many replies were sent*/
+        inline uint64_t getCompleted(){
+            return completed.load(std::memory_order_relaxed);
+        }
+
+        /*how many replies were dropped because their client left (or
+        the Reactor had no room for them)*/
+        inline uint64_t getDropped(){
+            return dropped.load(std::memory_order_relaxed);
+        }
+};
+
+/*the CommandDispatcher everything uses (Clients with the 3 byte size)*/
+using CommandDispatcher = BasicCommandDispatcher<framing::DefaultCodec>;
+
+}
@@ -1,15 +1,28 @@
-#include <string>
-
-namespace commands{
-
-/*The very big list of commands*/
-
-/*Undefined Generalized Command*/
-class AbstractCommand{
-public:
-    inline int virtual executeCommand(const std::string& command) = 0;
-};
-
-/**/
-
-}
\ No newline at end of file
+#pragma once
+#include <string>
+
+namespace commands{
+
+/*The very big list of commands*/
+
+/*Undefined Generalized Command*/
+class AbstractCommand{
+public:
+    inline int virtual executeCommand(const std::string& command) = 0;
+
+    /*same as above, but also fills in what goes back to whoever sent
+    the command (CommandDispatcher sends it as the reply). Unless a
+    command has more to say, the reply is just what executeCommand()
+    returned*/
+    inline int virtual executeCommand(const std::string& command, std::string& reply){
+        int val = executeCommand(command);
+        reply = std::to_string(val);
+        return val;
+    }
+
+    inline virtual ~AbstractCommand() = default;
+};
+
+/**/
+
+}
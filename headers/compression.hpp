@@ -0,0 +1,177 @@
+#pragma once
+
+#include <zlib.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <span>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+namespace compression{
+    enum{
+        BADDATA                         = -10,
+        TOOBIG                          = -11
+    };
+
+    /*A compressed message is
+        4 bytes             - the size of the original message (big endian)
+        the rest            - the message run through zlib (deflate)
+    so the receiver knows how big a buffer to make before inflating*/
+    const size_t SIZEPREFIX = 4;
+
+    /*the original size written at the front of a compressed message
+    (0 if there isn't even a prefix)*/
+    inline uint32_t originalSize(std::string_view compressed){
+        if(compressed.size() < SIZEPREFIX){
+            return 0;
+        }
+        uint32_t size = 0;
+        for(size_t i = 0;i<SIZEPREFIX;i++){
+            size = (size << 8) | (unsigned char)compressed[i];
+        }
+        return size;
+    }
+
+    /*compresses input into out (out is overwritten, but its capacity
+    is kept so a reused out stops allocating)
+    level is zlib's (Z_BEST_SPEED = 1 up to Z_BEST_COMPRESSION = 9)
+
+    returns 1 on success, BADDATA if zlib fails*/
+    inline int compress(std::string_view input, std::string& out, int level = Z_BEST_SPEED){
+        uLongf bound = compressBound(input.size());
+        out.resize(SIZEPREFIX + bound);
+        uint32_t size = input.size();
+        for(size_t i = 0;i<SIZEPREFIX;i++){
+            out[SIZEPREFIX - i - 1] = (char)(size & 0xFF);
+            size >>= 8;
+        }
+        int res = compress2((Bytef*)out.data() + SIZEPREFIX, &bound,
+                            (const Bytef*)input.data(), input.size(), level);
+        if(res != Z_OK){
+            out.clear();
+            return BADDATA;
+        }
+        out.resize(SIZEPREFIX + bound);
+        return 1;
+    }
+
+    /*inflates a message made by compress() and APPENDS it to out
+    (like the ring buffers' pop())
+
+    returns 1 on success
+    returns TOOBIG if it says it's bigger than maxSize
+    returns BADDATA if it isn't valid or isn't the size it says*/
+    inline int decompress(std::string_view input, std::string& out, size_t maxSize){
+        if(input.size() < SIZEPREFIX){
+            return BADDATA;
+        }
+        uint32_t size = originalSize(input);
+        if(size > maxSize){
+            return TOOBIG;
+        }
+        size_t oldSize = out.size();
+        out.resize(oldSize + size);
+        uLongf got = size;
+        int res = uncompress((Bytef*)out.data() + oldSize, &got,
+                                (const Bytef*)input.data() + SIZEPREFIX, input.size() - SIZEPREFIX);
+        if(res != Z_OK || got != size){
+            out.resize(oldSize);
+            return BADDATA;
+        }
+        return 1;
+    }
+
+    /*Inflates a compressed message as pieces of it come in
+    (for Client::getPacketStream(), which never has all of it)
+    the size prefix is skipped over, then every piece that comes out
+    of zlib goes to onChunk*/
+    class Inflater{
+    private:
+        z_stream stream;
+        bool started;
+        size_t prefixSeen;          // how much of the size prefix went by
+        size_t remaining;           // how much the prefix said is left to come out
+        std::array<char, 16 * 1024> chunk;
+
+    public:
+        inline Inflater() : started(false), prefixSeen(0), remaining(0){
+            stream = {};
+        }
+
+        Inflater(const Inflater&) = delete;
+        Inflater& operator=(const Inflater&) = delete;
+
+        inline ~Inflater(){
+            if(started){
+                inflateEnd(&stream);
+            }
+        }
+
+        /*gets ready for a new compressed message (drops anything
+        left of the last one)
+        returns 1, or BADDATA if zlib can't start*/
+        inline int reset(){
+            prefixSeen = 0;
+            remaining = 0;
+            if(started){
+                return inflateReset(&stream) == Z_OK ? 1 : BADDATA;
+            }
+            if(inflateInit(&stream) != Z_OK){
+                return BADDATA;
+            }
+            started = true;
+            return 1;
+        }
+
+        /*takes the next piece of the compressed message
+        returns 1 on success
+        returns TOOBIG if the prefix says it's bigger than maxSize
+        returns BADDATA if zlib doesn't like it*/
+        inline int feed(std::span<const char> input, size_t maxSize,
+                        const std::function<void(std::span<const char>)>& onChunk){
+            while(prefixSeen < SIZEPREFIX && !input.empty()){
+                remaining = (remaining << 8) | (unsigned char)input[0];
+                input = input.subspan(1);
+                prefixSeen++;
+                if(prefixSeen == SIZEPREFIX && remaining > maxSize){
+                    return TOOBIG;
+                }
+            }
+            stream.next_in = (Bytef*)input.data();
+            stream.avail_in = input.size();
+            while(true){
+                stream.next_out = (Bytef*)chunk.data();
+                stream.avail_out = chunk.size();
+                int res = ::inflate(&stream, Z_NO_FLUSH);
+                if(res == Z_BUF_ERROR){
+                    //nothing more it can do until more input comes
+                    break;
+                }
+                if(res != Z_OK && res != Z_STREAM_END){
+                    return BADDATA;
+                }
+                size_t produced = chunk.size() - stream.avail_out;
+                if(produced > remaining){
+                    return BADDATA;
+                }
+                remaining -= produced;
+                if(produced > 0){
+                    onChunk(std::span<const char>(chunk.data(), produced));
+                }
+                //a full chunk means zlib may still be holding more
+                if(res == Z_STREAM_END || (stream.avail_in == 0 && stream.avail_out > 0)){
+                    break;
+                }
+            }
+            return 1;
+        }
+
+        /*whether everything the prefix promised came out*/
+        inline bool finished(){
+            return prefixSeen == SIZEPREFIX && remaining == 0;
+        }
+    };
+}
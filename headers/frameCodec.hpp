@@ -0,0 +1,146 @@
+#pragma once
+#include "sharedstuff.hpp"
+#include "frameId.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace framing{
+
+    /*The wire layout of a packet header, all worked out at compile time:
+        SizeBytes bytes     - size of message (big endian), the top bit
+                                is the COMPRESSEDFLAG (see compression.hpp)
+        IdBytes bytes       - the username (padded with spaces)
+        the message         - up to MaxMessage bytes
+
+    A header lives in a fixed std::array (Header), so encoding or
+    decoding one never allocates anything.
+
+    Everything is static, so a codec is only ever used as a template
+    argument (Client, FrameDecoder) and never made
+    */
+    template<size_t SizeBytes, size_t IdBytes,
+                uint32_t MaxMessage = sharedstuff::Megabyte - (SizeBytes + IdBytes)>
+    struct FrameCodec{
+        static_assert(SizeBytes >= 1 && SizeBytes <= 4, "the size has to fit in a uint32_t");
+        static_assert(IdBytes >= 1, "there has to be room for an id");
+
+        //the top bit of the size says the message is compressed
+        static constexpr uint32_t COMPRESSEDFLAG = 1u << (8 * SizeBytes - 1);
+        static_assert(MaxMessage < COMPRESSEDFLAG,
+                        "MaxMessage has to fit in SizeBytes bytes (without the flag)");
+
+        static constexpr size_t SIZEOFFSET = 0;
+        static constexpr size_t SIZEBYTES = SizeBytes;
+        static constexpr size_t IDOFFSET = SIZEOFFSET + SizeBytes;
+        static constexpr size_t IDBYTES = IdBytes;
+        static constexpr size_t HEADERSIZE = IDOFFSET + IdBytes;
+        static constexpr uint32_t MAXMESSAGE = MaxMessage;
+
+        using Header = std::array<char, HEADERSIZE>;
+
+        /*the size field as it is on the wire (flag included)
+        (bytes are read as unsigned so 0x80 and up don't sign extend)*/
+        static constexpr uint32_t decodeField(const char* header){
+            uint32_t field = 0;
+            for(size_t i = 0;i<SizeBytes;i++){
+                field = (field << 8) | (unsigned char)header[SIZEOFFSET + i];
+            }
+            return field;
+        }
+
+        /*the size out of the front of a header (without the flag)*/
+        static constexpr uint32_t decodeSize(const char* header){
+            return decodeField(header) & ~COMPRESSEDFLAG;
+        }
+
+        static constexpr uint32_t decodeSize(const Header& header){
+            return decodeSize(header.data());
+        }
+
+        /*whether the message after this header is compressed*/
+        static constexpr bool isCompressed(const char* header){
+            return (decodeField(header) & COMPRESSEDFLAG) != 0;
+        }
+
+        static constexpr bool isCompressed(const Header& header){
+            return isCompressed(header.data());
+        }
+
+        /*the id in a header without its padding (points into header)*/
+        static constexpr std::string_view decodeId(const Header& header){
+            size_t length = IdBytes;
+            while(length > 0 && header[IDOFFSET + length - 1] == ' '){
+                length--;
+            }
+            return std::string_view(header.data() + IDOFFSET, length);
+        }
+
+        /*the id in a header as a FrameId (no padding to scan off later,
+        no allocation), only for codecs with FrameId sized ids*/
+        static inline FrameId decodeFrameId(const Header& header) requires (IdBytes == FrameId::SIZE){
+            return FrameId::fromWire(header.data() + IDOFFSET);
+        }
+
+        /*whether an id/message of these sizes can be sent at all*/
+        static constexpr bool idFits(size_t idSize){
+            return idSize <= IdBytes;
+        }
+        static constexpr bool messageFits(size_t messageSize){
+            return messageSize <= MaxMessage;
+        }
+
+        /*writes the size field (and the flag if compressed)*/
+        static constexpr void encodeSize(Header& header, uint32_t messageSize, bool compressed){
+            uint32_t field = messageSize | (compressed ? COMPRESSEDFLAG : 0);
+            for(size_t i = 0;i<SizeBytes;i++){
+                header[SIZEOFFSET + SizeBytes - i - 1] = (char)(field & 0xFF);
+                field >>= 8;
+            }
+        }
+
+        /*writes the header for a message of messageSize bytes from id
+        (the caller checks idFits() and messageFits() first)*/
+        static constexpr void encode(Header& header, uint32_t messageSize, std::string_view id,
+                                        bool compressed = false){
+            encodeSize(header, messageSize, compressed);
+            for(size_t i = 0;i<IdBytes;i++){
+                header[IDOFFSET + i] = i < id.size() ? id[i] : ' ';
+            }
+        }
+
+        /*same, but the id is already padded so it's one copy*/
+        static inline void encode(Header& header, uint32_t messageSize, const FrameId& id,
+                                    bool compressed = false) requires (IdBytes == FrameId::SIZE){
+            encodeSize(header, messageSize, compressed);
+            std::memcpy(header.data() + IDOFFSET, id.wire(), IdBytes);
+        }
+
+        static constexpr Header encode(uint32_t messageSize, std::string_view id,
+                                        bool compressed = false){
+            Header header{};
+            encode(header, messageSize, id, compressed);
+            return header;
+        }
+    };
+
+    /*the layout everything has always used:
+    3 byte size + 13 byte id, messages up to 1 Megabyte - 16*/
+    using DefaultCodec = FrameCodec<sharedstuff::MSGSIZEBYTECOUNT, sharedstuff::IDSIZEBYTECOUNT>;
+
+    /*a 4 byte size with the same 13 byte id (17 byte header), so
+    messages can go up to 2 Megabytes (minus the header), which is
+    as big as a Client's buffer gets*/
+    using WideCodec = FrameCodec<4, sharedstuff::IDSIZEBYTECOUNT,
+                                    2 * sharedstuff::Megabyte - (4 + sharedstuff::IDSIZEBYTECOUNT)>;
+
+    static_assert(DefaultCodec::HEADERSIZE == sharedstuff::HEADERSIZE);
+    static_assert(DefaultCodec::decodeSize(DefaultCodec::encode(0x0BCDEF, "")) == 0x0BCDEF);
+    static_assert(DefaultCodec::isCompressed(DefaultCodec::encode(0x0BCDEF, "", true)));
+    static_assert(DefaultCodec::decodeSize(DefaultCodec::encode(0x0BCDEF, "", true)) == 0x0BCDEF);
+    static_assert(WideCodec::decodeSize(WideCodec::encode(0x1FFFEF, "x")) == 0x1FFFEF);
+}
@@ -0,0 +1,166 @@
+#pragma once
+#include "frameCodec.hpp"
+
+#include <string>
+#include <span>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+
+namespace framing{
+    enum{
+        NEEDMORE                        = 0,
+        FRAMEREADY                      = 1,
+        BADSIZE                         = -10
+    };
+
+    /*What the decoder is waiting on, in the order a packet comes in:
+        Codec::SIZEBYTES bytes      - size of message   (AWAITSIZE)
+        Codec::IDBYTES bytes        - the username      (AWAITID)
+        size bytes                  - the message       (AWAITBODY)
+    or FAILED once a size was too big (until reset())
+    */
+    enum DecoderState{
+        AWAITSIZE,
+        AWAITID,
+        AWAITBODY,
+        FAILED
+    };
+
+    /*Turns bytes into packets without ever waiting on a socket
+
+    Give it whatever bytes showed up with feed(), in as many pieces
+    as they came in. It remembers how far into the packet it is, so
+    it never needs the whole packet at once and never has to block
+    for the rest of it. That way one thread can keep a FrameDecoder
+    per socket and drive all of them from a poll()/epoll() loop.
+
+    The verification of the id/message DOES NOT happen here
+    (same as Client)
+
+    Codec is the header layout (a FrameCodec)
+    */
+    template<typename Codec>
+    class BasicFrameDecoder{
+    private:
+        int state;
+        typename Codec::Header header;          // the size + id as they come in
+        size_t headerHave;                      // how much of header we have
+        uint32_t messageSize;
+        std::string id;
+        std::string message;
+        bool ready;                             // a whole packet is waiting for take()
+        bool compressed;                        // the COMPRESSEDFLAG of that packet
+
+    public:
+        inline BasicFrameDecoder(){
+            reset();
+        }
+
+        /*takes bytes from the front of input until a packet is
+        complete (or input runs out)
+        used is set to how many bytes of input were taken, the
+        rest belongs to the next packet, so feed it again after take()
+
+        returns FRAMEREADY when a packet is complete (take() it)
+        returns NEEDMORE when input ran out partway through one
+        returns BADSIZE if the size in the header is bigger than
+            a packet can hold (the stream can't be trusted after that,
+            so every feed() returns BADSIZE without taking anything
+            until reset())
+        */
+        inline int feed(std::span<const char> input, size_t& used){
+            used = 0;
+            if(state == FAILED){
+                return BADSIZE;
+            }
+            while(!ready && used < input.size()){
+                if(state == AWAITSIZE || state == AWAITID){
+                    size_t want = state == AWAITSIZE ? Codec::IDOFFSET : Codec::HEADERSIZE;
+                    size_t amount = std::min(want - headerHave, input.size() - used);
+                    std::memcpy(header.data() + headerHave, input.data() + used, amount);
+                    headerHave += amount;
+                    used += amount;
+                    if(headerHave < want){
+                        return NEEDMORE;
+                    }
+
+                    if(state == AWAITSIZE){
+                        messageSize = Codec::decodeSize(header);
+                        compressed = Codec::isCompressed(header);
+                        if(!Codec::messageFits(messageSize)){
+                            state = FAILED;
+                            return BADSIZE;
+                        }
+                        state = AWAITID;
+                    }
+                    else{
+                        id.assign(Codec::decodeId(header));
+                        message.clear();
+                        message.reserve(messageSize);
+                        state = AWAITBODY;
+                    }
+                }
+                if(state == AWAITBODY){
+                    size_t amount = std::min<size_t>(messageSize - message.size(),
+                                                        input.size() - used);
+                    message.append(input.data() + used, amount);
+                    used += amount;
+                    if(message.size() == messageSize){
+                        ready = true;
+                        state = AWAITSIZE;
+                        headerHave = 0;
+                    }
+                }
+            }
+            if(ready){
+                return FRAMEREADY;
+            }
+            return NEEDMORE;
+        }
+
+        /*hands over the packet feed() finished (swapped out, not copied)
+        returns FRAMEREADY, or NEEDMORE if there isn't one yet*/
+        inline int take(std::string& id, std::string& message){
+            if(!ready){
+                return NEEDMORE;
+            }
+            std::swap(id, this->id);
+            std::swap(message, this->message);
+            ready = false;
+            return FRAMEREADY;
+        }
+
+        /*whether the packet take() hands over (or just handed over)
+        is compressed (the decoder doesn't inflate it itself)*/
+        inline bool isCompressed(){
+            return compressed;
+        }
+
+        /*which of AWAITSIZE, AWAITID, AWAITBODY or FAILED it is in*/
+        inline int getState(){
+            return state;
+        }
+
+        /*true if some of a packet has been fed but it hasn't
+        been taken yet (or it FAILED on one)*/
+        inline bool inProgress(){
+            return ready || state != AWAITSIZE || headerHave > 0;
+        }
+
+        /*forgets everything about the packet it was in the middle of*/
+        inline void reset(){
+            state = AWAITSIZE;
+            headerHave = 0;
+            messageSize = 0;
+            id.clear();
+            message.clear();
+            ready = false;
+            compressed = false;
+        }
+    };
+
+    /*the decoder for the layout everything has always used*/
+    using FrameDecoder = BasicFrameDecoder<DefaultCodec>;
+}
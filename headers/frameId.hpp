@@ -0,0 +1,137 @@
+#pragma once
+#include "sharedstuff.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <functional>
+
+namespace framing{
+
+    /*A packet id kept the way it goes over the wire (IDSIZEBYTECOUNT
+    bytes padded with spaces) right inside the object, so it never
+    allocates and can be copied around like an int
+
+    The bytes are stored in 16 (the last 3 always 0), so comparing
+    two ids is two 8 byte loads each, and the hash is worked out once
+    when the id is made, so using it as a key in an unordered_map
+    doesn't scan the bytes again
+    */
+    class FrameId{
+    public:
+        static constexpr size_t SIZE = sharedstuff::IDSIZEBYTECOUNT;
+
+    private:
+        alignas(8) std::array<char, 16> bytes;  // SIZE bytes padded with ' ', then 0s
+        uint8_t length;                         // without the padding
+        size_t hashValue;
+
+        static_assert(SIZE <= 16, "the id has to fit in two words");
+
+        inline void computeHash(){
+            uint64_t words[2];
+            std::memcpy(words, bytes.data(), sizeof(words));
+            //mixes both words (splitmix64 finalizer) so ids that only
+            // differ in the last few characters still spread out
+            uint64_t x = words[0] ^ (words[1] * 0x9E3779B97F4A7C15ull);
+            x ^= x >> 30;
+            x *= 0xBF58476D1CE4E5B9ull;
+            x ^= x >> 27;
+            x *= 0x94D049BB133111EBull;
+            x ^= x >> 31;
+            hashValue = (size_t)x;
+        }
+
+    public:
+        /*the empty id (all padding)*/
+        inline FrameId(){
+            bytes.fill(0);
+            std::memset(bytes.data(), ' ', SIZE);
+            length = 0;
+            computeHash();
+        }
+
+        /*id has to be at most SIZE characters
+        (it's explicit so a string literal still picks the std::string
+        overloads of Client)*/
+        inline explicit FrameId(std::string_view id){
+            if(!fits(id)){
+                throw std::invalid_argument("FATAL ERROR: the id is longer than " + std::to_string(SIZE) +
+                                            " characters\n"
+                                            "FrameId could not be created");
+            }
+            bytes.fill(0);
+            std::memcpy(bytes.data(), id.data(), id.size());
+            std::memset(bytes.data() + id.size(), ' ', SIZE - id.size());
+            //trailing spaces are padding, the same as on the wire
+            length = (uint8_t)id.size();
+            while(length > 0 && bytes[length - 1] == ' '){
+                length--;
+            }
+            computeHash();
+        }
+
+        /*straight from SIZE padded bytes (like in a packet header)*/
+        static inline FrameId fromWire(const char* padded){
+            FrameId id;
+            std::memcpy(id.bytes.data(), padded, SIZE);
+            id.length = SIZE;
+            while(id.length > 0 && id.bytes[id.length - 1] == ' '){
+                id.length--;
+            }
+            id.computeHash();
+            return id;
+        }
+
+        static inline bool fits(std::string_view id){
+            return id.size() <= SIZE;
+        }
+
+        /*the SIZE padded bytes, ready to go in a header*/
+        inline const char* wire() const{
+            return bytes.data();
+        }
+
+        /*the id without the padding*/
+        inline std::string_view view() const{
+            return std::string_view(bytes.data(), length);
+        }
+
+        inline std::string toString() const{
+            return std::string(view());
+        }
+
+        inline size_t size() const{
+            return length;
+        }
+
+        inline size_t hash() const{
+            return hashValue;
+        }
+
+        inline bool operator==(const FrameId& other) const{
+            uint64_t a[2], b[2];
+            std::memcpy(a, bytes.data(), sizeof(a));
+            std::memcpy(b, other.bytes.data(), sizeof(b));
+            return ((a[0] ^ b[0]) | (a[1] ^ b[1])) == 0;
+        }
+
+        inline bool operator==(std::string_view other) const{
+            return view() == other;
+        }
+    };
+
+    static_assert(std::is_trivially_copyable_v<FrameId>);
+}
+
+template<>
+struct std::hash<framing::FrameId>{
+    inline size_t operator()(const framing::FrameId& id) const{
+        return id.hash();
+    }
+};
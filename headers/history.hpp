@@ -1,42 +1,52 @@
-#include <list>
-#include <string>
-
-namespace history{
-
-const int MAXHISTORYSIZE            = 50;
-
-/*A debug-convenience object that's just a wrapper for 
-a list of strings
-
-essentially, holds up to 50 messages (up to the design of the user)
-that may indicate information such as, 
-    - what happened
-    - where it happened
-    - what state it happened
-*/
-class History{
-private:
-    std::list<std::string> messages;
-
-public:
-    inline History(const History& other){
-        this->messages = other.messages;
-    }
-    inline friend void swap(History& a, History& b){
-        std::swap(a.messages, b.messages);
-    }
-    inline History& operator=(History other){
-        swap(*this, other);
-        return *this;
-    }
-
-
-    void addMessage(std::string message);
-    const std::list<std::string>& getMessage();
-};
-
-/*prints the content of the messages list in history*/
-void printHistory(History& h);
-
-
+#pragma once
+#include <list>
+#include <string>
+#include <mutex>
+
+namespace history{
+
+const int MAXHISTORYSIZE            = 50;
+
+/*A debug-convenience object that's just a wrapper for 
+a list of strings
+
+essentially, holds up to 50 messages (up to the design of the user)
+that may indicate information such as, 
+    - what happened
+    - where it happened
+    - what state it happened
+
+addMessage() and getMessage() can be called from many threads at once
+*/
+class History{
+private:
+    std::list<std::string> messages;
+    mutable std::mutex lock;
+
+public:
+    inline History(){}
+    inline History(const History& other){
+        std::lock_guard<std::mutex> guard(other.lock);
+        this->messages = other.messages;
+    }
+    inline friend void swap(History& a, History& b){
+        std::swap(a.messages, b.messages);
+    }
+    inline History& operator=(History other){
+        std::lock_guard<std::mutex> guard(lock);
+        swap(*this, other);
+        return *this;
+    }
+
+
+    void addMessage(std::string message);
+    /*a copy of the messages (taken under the lock, so another
+    thread can keep adding while it's looked at)*/
+    std::list<std::string> getMessage();
+};
+
+/*prints the content of the messages list in history*/
+void printHistory(History& h);
+
+
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#pragma once
+#include "ring.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <bit>
+#include <cstdint>
+
+namespace ringbuffer{
+
+/*A bounded queue that MANY threads can push into at once
+but only ONE thread pops from, without any locks
+(based on Dmitry Vyukov's bounded queue:
+    -> https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue)
+
+Every cell has a sequence number that says whose turn it is:
+    sequence == pos         -> empty, the producer that claims pos can fill it
+    sequence == pos + 1     -> full, the consumer at pos can take it
+    sequence == pos + cap   -> emptied, ready for the producer one lap later
+Producers claim a position by a compare-exchange on enqueuePos, so
+two of them never write the same cell. The consumer owns dequeuePos
+by itself.
+
+capacity is rounded up to a power of two
+*/
+template<typename T>
+class MPSCQueue{
+private:
+    struct Cell{
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+
+    //producers fight over this one
+    alignas(CACHELINESIZE) std::atomic<size_t> enqueuePos;
+    //only the consumer writes this one (atomic so size() can read it)
+    alignas(CACHELINESIZE) std::atomic<size_t> dequeuePos;
+
+    /*claims the next cell for a producer (pos is its position)
+    returns nullptr if the queue is full*/
+    inline Cell* claim(size_t& pos){
+        pos = enqueuePos.load(std::memory_order_relaxed);
+        while(true){
+            Cell* cell = &cells[pos & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if(diff == 0){
+                //our turn, try to claim it
+                if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                    return cell;
+                }
+            }
+            else if(diff < 0){
+                //the consumer hasn't emptied this cell yet
+                return nullptr;
+            }
+            else{
+                //another producer got it first
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    /* makes a queue for (at least) capacity entries
+        and must be > 0*/
+    inline MPSCQueue(size_t capacity){
+        if(capacity == 0){
+            throw std::invalid_argument("FATAL ERROR: the capacity cannot be 0.\n"
+                                        "MPSCQueue could not be created");
+        }
+        capacity = std::bit_ceil(capacity);
+        cells = std::make_unique<Cell[]>(capacity);
+        for(size_t i = 0;i<capacity;i++){
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        mask = capacity - 1;
+        enqueuePos.store(0, std::memory_order_relaxed);
+        dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    /*adds value to the queue (safe from any thread)
+    returns false right away if the queue is full
+
+    value is only copied (or moved from, below) once a cell is
+    claimed, so a failed try leaves it alone and costs no copy*/
+    inline bool tryPush(const T& value){
+        size_t pos;
+        Cell* cell = claim(pos);
+        if(cell == nullptr){
+            return false;
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    inline bool tryPush(T&& value){
+        size_t pos;
+        Cell* cell = claim(pos);
+        if(cell == nullptr){
+            return false;
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*adds value to the queue (safe from any thread)
+    waits for the consumer to make room if the queue is full*/
+    inline void push(T value){
+        int spins = 0;
+        //value is only moved from by the try that gets a cell
+        while(!tryPush(std::move(value))){
+            //yield for a bit before we actually go to sleep
+            if(spins < 64){
+                spins++;
+                std::this_thread::yield();
+            }
+            else{
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    /*takes the oldest value out of the queue (consumer thread ONLY)
+    returns false if the queue is empty*/
+    inline bool tryPop(T& out){
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell& cell = cells[pos & mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if((intptr_t)sequence - (intptr_t)(pos + 1) < 0){
+            return false;
+        }
+        out = std::move(cell.value);
+        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+        dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /*takes up to max values out of the queue and appends them to out
+    (consumer thread ONLY)
+    returns how many were taken*/
+    inline size_t popBatch(std::vector<T>& out, size_t max){
+        size_t taken = 0;
+        T value;
+        while(taken < max && tryPop(value)){
+            out.push_back(std::move(value));
+            taken++;
+        }
+        return taken;
+    }
+
+    /*how many entries are in the queue right now
+    (only a snapshot when other threads are pushing)*/
+    inline size_t size(){
+        size_t popped = dequeuePos.load(std::memory_order_relaxed);
+        size_t pushed = enqueuePos.load(std::memory_order_relaxed);
+        return pushed > popped ? pushed - popped : 0;
+    }
+
+    inline size_t capacity(){
+        return mask + 1;
+    }
+};
+
+}
@@ -0,0 +1,203 @@
+#pragma once
+#include "socketLib.hpp"
+#include "mpscQueue.hpp"
+
+#include <sys/epoll.h>      // For epoll_create1, epoll_ctl and epoll_wait
+#include <sys/eventfd.h>    // For eventfd (waking epoll_wait up)
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+namespace socketstuffs{
+
+/*what a Reactor handler is told about its fd (any mix of them)*/
+enum ReactorEvents : uint32_t{
+    READABLE =                      EPOLLIN,
+    WRITABLE =                      EPOLLOUT,
+    HANGUP =                        EPOLLHUP | EPOLLERR | EPOLLRDHUP
+};
+
+/*One thread looking after a lot of sockets with epoll, instead of
+every Socket and Client doing its own poll() with POLLTIMER
+
+every fd is added EDGE-triggered: its handler is only called when
+something new happens (bytes came in, room opened up to send), so
+a handler has to take everything there is (until EAGAIN) before
+returning, otherwise it won't hear about the rest. What runOnce()
+costs only depends on how many fds are ready, not how many are
+watched.
+
+Other threads talk to it through post() (a lock-free MPSCQueue) and
+stop(), which write to an eventfd so a waiting epoll_wait() wakes up
+
+The Reactor doesn't own the fds, only watches them: remove() an fd
+BEFORE closing it (a closed fd number can be handed out again and
+would end up with the old handler)
+
+everything except post() and stop() has to be called on the thread
+running the Reactor (or before it starts)
+*/
+class Reactor{
+    public:
+        /*gets the ReactorEvents that happened*/
+        using Handler = std::function<void(uint32_t events)>;
+        /*gets a new (non-blocking) connection from watchSocket()*/
+        using AcceptHandler = std::function<void(int clientFd)>;
+
+    private:
+        struct Watch{
+            int fd;
+            bool active;                    // false once it's remove()-ed
+            Handler handler;
+        };
+
+        int epollFd;
+        int wakeFd;                         // the eventfd post() and stop() write to
+
+        //indexed by fd (fds are small numbers), so finding one is
+        // just an index and epoll hands back the Watch* directly
+        std::vector<std::unique_ptr<Watch>> watches;
+        //removed while runOnce() was going through events, they
+        // can't be freed until it's done (a later event might point
+        // at them, or the handler being run might be the one removed)
+        std::vector<std::unique_ptr<Watch>> retired;
+        bool dispatching;
+        size_t watchCount;
+
+        std::vector<struct epoll_event> events;
+        std::atomic<bool> stopping;         // stop() was called, run() hasn't returned for it yet
+        ringbuffer::MPSCQueue<std::function<void()>> posted;
+
+        /*empties the eventfd and runs what was post()-ed
+            returns how many tasks ran*/
+        int runPosted();
+
+    public:
+        /*makes the epoll instance and the eventfd
+        throws a runtime_error if either can't be made*/
+        Reactor();
+
+        //Removed copy constructor because the epoll fd should not be copied
+        Reactor(const Reactor&) = delete;
+        Reactor& operator=(const Reactor&) = delete;
+
+        /*closes the epoll instance and the eventfd (not the watched fds)*/
+        ~Reactor();
+
+        /*starts watching fd (edge-triggered) for interest
+        (READABLE and/or WRITABLE, HANGUP is always reported)
+
+        returns 1 on success
+        returns ALREADYWATCHED if fd is already watched
+        returns BADEPOLL if epoll doesn't take it*/
+        int add(int fd, uint32_t interest, Handler handler);
+
+        /*changes what fd is watched for (like turning WRITABLE on while
+        there is something waiting to be sent)
+        returns 1, NOTWATCHED or BADEPOLL*/
+        int modify(int fd, uint32_t interest);
+
+        /*stops watching fd (safe from inside any handler, even fd's own)
+        returns 1 or NOTWATCHED*/
+        int remove(int fd);
+
+        /*watches a Socket that openIt() was called on, and every
+        connection that comes in is accept4()-ed (non-blocking) and
+        handed to onAccept (give it to Client::connectIt(int) and
+        watchClient() to receive from it)
+
+        s has to outlive the watch
+
+        returns like add(), or NOTOPENED if s isn't open*/
+        int watchSocket(Socket& s, AcceptHandler onAccept);
+
+        /*watches a connected Client: when it's readable, tryGetPacket()
+        is called until the socket is drained and every packet goes to
+        onPacket (message can be moved out of, and onPacket can
+        remove() the client and then destroy it)
+
+        if tryGetPacket() returns an error (READCLOSE when the other
+        side hangs up), the client is remove()-ed first and then
+        onError gets the error, so onError can closeIt() it
+
+        client has to outlive the watch (remove() it before destroying it)
+
+        returns like add(), or NOTOPENED if client isn't connected*/
+        template<typename Codec>
+        int watchClient(BasicClient<Codec>& client,
+                        std::function<void(const std::string& id, std::string& message)> onPacket,
+                        std::function<void(int error)> onError);
+
+        /*one epoll_wait() (up to timeoutMs, -1 waits forever) and the
+        handlers of whatever is ready, then anything post()-ed
+
+        returns how many handlers and tasks were run (0 if it timed out)
+        returns BADEPOLL if epoll_wait() fails*/
+        int runOnce(int timeoutMs);
+
+        /*runOnce() until stop() is called
+        returns 1 after stop(), or BADEPOLL*/
+        int run();
+
+        /*makes run() return (safe from any thread, and from handlers)
+
+        if run() hasn't started yet (another thread is only about to
+        call it) it returns right away once it does, so a stop() can't
+        get lost. Each stop() ends one run(), a later run() goes on
+        until the next stop()*/
+        void stop();
+
+        /*runs task on the Reactor's thread during its next runOnce()
+        (safe from any thread, wakes the Reactor up)
+        returns 1, or QUEUEFULL if REACTORQUEUESIZE tasks are waiting*/
+        int post(std::function<void()> task);
+
+        /*how many fds are watched (without the eventfd)*/
+        size_t getWatchCount();
+
+        /*whether fd is watched right now*/
+        bool isWatched(int fd);
+};
+
+template<typename Codec>
+int Reactor::watchClient(BasicClient<Codec>& client,
+                            std::function<void(const std::string& id, std::string& message)> onPacket,
+                            std::function<void(int error)> onError){
+    int fd = client.getFd();
+    if(fd == -1){
+        return NOTOPENED;
+    }
+    //the id and message strings live in the handler, so a steady
+    // stream of packets keeps reusing them
+    return add(fd, READABLE, [this, &client, fd, onPacket, onError,
+                                id = std::string(), message = std::string()](uint32_t) mutable{
+        while(true){
+            int val = client.tryGetPacket(id, message);
+            if(val == 1){
+                onPacket(id, message);
+                //onPacket may have removed it (client might be gone
+                // then, so check before touching it), or closed it
+                if(!isWatched(fd) || client.getFd() != fd){
+                    return;
+                }
+                continue;
+            }
+            if(val == 0){
+                if(client.isDrained()){
+                    //wait for the next edge
+                    return;
+                }
+                continue;
+            }
+            remove(fd);
+            onError(val);
+            return;
+        }
+    });
+}
+
+}
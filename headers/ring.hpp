@@ -1,107 +1,542 @@
-#pragma once
-#include <vector>
-#include <string>
-
-namespace ringbuffer{
-    enum{
-        OUTOFBOUNDS                     = -10
-    };
-
-    /*Some error function to ensure something doesn't
-    go wrong*/
-    void bufferError(std::string msg);
-
-    /*
-    basic implementation of a circular buffer of characters
-        - behaves like a queue (FIFO)
-    a simple array of data with two indices that show the bounds of the loop
-        - start
-        - end
-    Note that start and end behave independently. That is, even if end loops
-    around and laps the start, it doesn't change the implementation of the
-    code. Start and end really are there for programmer's convenience,
-    push only looks at end and pop only looks at start
-    
-    THUS, MAKE SURE YOU USE DOUBLE THE AMOUNT OF A SINGLE MESSAGE
-        This is to account for the issue of lapping
-
-    lapping (end beats start) is problematic and can lead to many undesired consequences.
-    This can be avoided by setting a larger maxLength. For example, 
-    make the size of the buffer double that of a single message.
-
-
-    Ex: 
-    MSG: "This was a triumph"
-    Buffer:
-        T->h->i->s-> ->w->a->s-> ->a-> ->t->r->i->u->m->p->h->
-        ^                                                     ^ 
-       start                                                 end
-    */
-    class RingBufferS{
-        private:
-            std::vector<char> data; // the data of our ring buffer
-            size_t maxLength;   // the fixed length of data
-            size_t start, end;  // the two pointers of our ring
-            size_t currSize;
-
-        
-        public:
-            /* initializes internal data to be empty
-            */
-            RingBufferS();
-
-            /* initializes internal data to a set size
-                and must be > 0*/
-            RingBufferS(size_t maxLength);
-
-            /*Copy-and-swap Idiom
-                -> https://medium.com/@amalpp42/idioms-in-c-f6b1c19fa605
-            */
-            RingBufferS(const RingBufferS& other);
-            RingBufferS& operator=(RingBufferS other){
-                swap(*this, other);
-                return *this;
-            }
-            friend void swap(RingBufferS& first, RingBufferS& second){
-                using std::swap;
-                swap(first.data, second.data);
-                swap(first.maxLength, second.maxLength);
-                swap(first.start, second.start);
-                swap(first.end, second.end);
-            }
-
-
-            /*pushes characters toAdd to data
-            if what we add exceeds the size of the maxlength,
-                It wil RETURN an OUTOFBOUNDS error
-
-            Q: is there a way to check for valid toAdd?
-
-            if all is properly done, returns 1
-            */
-            int push(const std::string& toAdd, size_t size);
-
-            /*pops characters in our data to destination
-            if there are too little to pop but the request 
-                is too much:
-                - Then pop as much as possible and return 
-                    OUTOFBOUNDS error
-            if there is nothing else to pop and popAmount> 0
-                - then (actually this is defined above)
-
-            Q: is there a way to check for valid dest?
-
-            if all is properly done, returns 1
-            */
-            int pop(std::string& dest, size_t popAmount);
-
-            /*returns a string of the contents of whats currently in the buffer*/
-            std::string getContents();
-
-            /*returns whether or not the buffer is empty or not*/
-            bool isEmpty();
-
-            /*simple accessor to the size variable*/
-            size_t size();
-    };
+#pragma once
+#include <vector>
+#include <string>
+#include <span>
+#include <array>
+#include <atomic>
+#include <new>
+#include <algorithm>
+
+namespace ringbuffer{
+    enum{
+        OUTOFBOUNDS                     = -10
+    };
+
+    /*A view of bytes that live inside a ring buffer
+    Since the bytes may wrap around the end of the data, it is split
+    into up to two spans:
+        [0] - from the start up to the wrap point
+        [1] - the rest (starting back at index 0), empty if no wrap
+    */
+    using Regions = std::array<std::span<const char>, 2>;
+
+    /*Same as Regions but for free space that can be written into
+    (see prepare() and commit())*/
+    using WritableRegions = std::array<std::span<char>, 2>;
+
+    /*The kinds of byte rings a user (like socketstuffs::Client)
+    can pick from*/
+    enum RingType{
+        STANDARD,           // RingBufferS
+        MIRRORED,           // MirroredRingBuffer
+        SPSC                // SPSCRingBuffer
+    };
+
+    /*how far apart two variables have to be so that two cores
+    writing to them don't fight over the same cache line*/
+    const size_t CACHELINESIZE = 64;
+
+    /*Some error function to ensure something doesn't
+    go wrong*/
+    void bufferError(std::string msg);
+
+    /*whether the rings check their own invariants (and call 
+    bufferError() when one is broken)
+    release builds (-DNDEBUG) compile the checks out completely*/
+#ifdef NDEBUG
+    constexpr bool CHECKINVARIANTS = false;
+#else
+    constexpr bool CHECKINVARIANTS = true;
+#endif
+
+    /*The operations every ring buffer of characters has
+    so the user of a ring doesn't need to know which one it got
+    (the behavior of each function is documented in RingBufferS)
+    */
+    class ByteRing{
+        public:
+            virtual ~ByteRing(){}
+
+            virtual int push(std::span<const char> toAdd) = 0;
+            virtual int pop(std::string& dest, size_t popAmount) = 0;
+            virtual size_t pop_into(std::span<char> dest) = 0;
+            virtual Regions peek(size_t offset, size_t n) = 0;
+            virtual Regions readable_regions() = 0;
+            virtual int consume(size_t n) = 0;
+            virtual std::string getContents() = 0;
+            virtual bool isEmpty() = 0;
+            virtual size_t size() = 0;
+            virtual size_t capacity() = 0;
+            virtual int resize(size_t newLength) = 0;
+            virtual WritableRegions prepare(size_t n) = 0;
+            virtual int commit(size_t n) = 0;
+    };
+
+    /*
+    basic implementation of a circular buffer of characters
+        - behaves like a queue (FIFO)
+    a simple array of data with two indices that show the bounds of the loop
+        - start
+        - end
+    Note that start and end behave independently. That is, even if end loops
+    around and laps the start, it doesn't change the implementation of the
+    code. Start and end really are there for programmer's convenience,
+    push only looks at end and pop only looks at start
+    
+    THUS, MAKE SURE YOU USE DOUBLE THE AMOUNT OF A SINGLE MESSAGE
+        This is to account for the issue of lapping
+
+    lapping (end beats start) is problematic and can lead to many undesired consequences.
+    This can be avoided by setting a larger maxLength. For example, 
+    make the size of the buffer double that of a single message.
+
+
+    Ex: 
+    MSG: "This was a triumph"
+    Buffer:
+        T->h->i->s-> ->w->a->s-> ->a-> ->t->r->i->u->m->p->h->
+        ^                                                     ^ 
+       start                                                 end
+    */
+    class RingBufferS : public ByteRing{
+        private:
+            std::vector<char> data; // the data of our ring buffer
+            size_t maxLength;   // the fixed length of data
+            size_t start, end;  // the two pointers of our ring
+            size_t currSize;
+
+        
+        public:
+            /* initializes internal data to be empty
+            */
+            RingBufferS();
+
+            /* initializes internal data to a set size
+                and must be > 0*/
+            RingBufferS(size_t maxLength);
+
+            /*Copy-and-swap Idiom
+                -> https://medium.com/@amalpp42/idioms-in-c-f6b1c19fa605
+            */
+            RingBufferS(const RingBufferS& other);
+            RingBufferS& operator=(RingBufferS other){
+                swap(*this, other);
+                return *this;
+            }
+            friend void swap(RingBufferS& first, RingBufferS& second){
+                using std::swap;
+                swap(first.data, second.data);
+                swap(first.maxLength, second.maxLength);
+                swap(first.start, second.start);
+                swap(first.end, second.end);
+                swap(first.currSize, second.currSize);
+            }
+
+
+            /*pushes characters toAdd to data
+            if what we add exceeds the size of the maxlength,
+                It wil RETURN an OUTOFBOUNDS error
+
+            Q: is there a way to check for valid toAdd?
+
+            if all is properly done, returns 1
+            */
+            int push(const std::string& toAdd, size_t size);
+
+            /*pushes every character in toAdd to data
+            the copy is done in at most two memcpy calls
+                (the part before the wrap point and the part after)
+            if toAdd doesn't fit in the free space, nothing is pushed
+                and it will RETURN an OUTOFBOUNDS error
+
+            if all is properly done, returns 1
+            */
+            int push(std::span<const char> toAdd) override;
+
+            /*pops characters in our data to destination
+            if there are too little to pop but the request 
+                is too much:
+                - Then pop as much as possible and return 
+                    OUTOFBOUNDS error
+            if there is nothing else to pop and popAmount> 0
+                - then (actually this is defined above)
+
+            Q: is there a way to check for valid dest?
+
+            if all is properly done, returns 1
+            */
+            int pop(std::string& dest, size_t popAmount) override;
+
+            /*pops up to dest.size() characters into dest
+            the copy is done in at most two memcpy calls
+                (the part before the wrap point and the part after)
+
+            returns the amount of characters that were popped
+            (which is less than dest.size() if there wasn't enough
+            in the buffer)
+            */
+            size_t pop_into(std::span<char> dest) override;
+
+            /*returns a view of n characters starting offset characters
+            after start WITHOUT popping them (nothing is copied)
+            if there aren't offset + n characters in the buffer, 
+                both spans are empty
+
+            the view is only valid until the next push
+            */
+            Regions peek(size_t offset, size_t n) override;
+
+            /*returns a view of everything that is currently in the 
+            buffer (up to two spans) without popping anything
+
+            the view is only valid until the next push
+            */
+            Regions readable_regions() override;
+
+            /*drops n characters from the front of the buffer 
+            (usually after reading them through peek/readable_regions)
+            if there are less than n characters, it drops everything
+                and returns OUTOFBOUNDS error
+
+            if all is properly done, returns 1
+            */
+            int consume(size_t n) override;
+
+            /*returns a string of the contents of whats currently in the buffer*/
+            std::string getContents() override;
+
+            /*returns whether or not the buffer is empty or not*/
+            bool isEmpty() override;
+
+            /*simple accessor to the size variable*/
+            size_t size() override;
+
+            /*simple accessor to the maxLength variable*/
+            size_t capacity() override;
+
+            /*changes maxLength to newLength (must be > 0), keeping
+            everything that is in the buffer (it gets moved to the
+            front of the new data)
+            if newLength can't hold what is in the buffer,
+                nothing changes and it will RETURN an OUTOFBOUNDS error
+
+            if all is properly done, returns 1
+            */
+            int resize(size_t newLength) override;
+
+            /*returns the free space where the next (up to) n characters
+            would be pushed (up to two spans, like peek) so something
+            like recv()/readv() can write into the buffer directly
+            the spans are smaller than n if there isn't enough room
+
+            nothing is in the buffer until commit() is called
+            */
+            WritableRegions prepare(size_t n) override;
+
+            /*marks the first n characters of what prepare() gave as
+            pushed
+            if n is more than the free space, nothing changes 
+                and it will RETURN an OUTOFBOUNDS error
+
+            if all is properly done, returns 1
+            */
+            int commit(size_t n) override;
+    };
+
+    /*A ring buffer of characters where the same memory is mapped
+    twice, back to back:
+
+        |<-------- maxLength -------->|<-------- maxLength -------->|
+        [ page 0, page 1, ... page n  ][ page 0, page 1, ... page n  ]
+                     ^                               ^
+                   start                    start + currSize
+
+    writing past the end of the first mapping lands at the beginning
+    of the data through the second mapping, so whatever is readable
+    (or writable) is ALWAYS one contiguous piece of memory. peek() and
+    readable_regions() never split (the second span is always empty)
+    and push/pop are a single memcpy.
+
+    The memory comes from memfd_create(), so maxLength is rounded up to
+    a multiple of the page size (check capacity()).
+
+    Because of the mapping, this can't be copied (only moved)
+    */
+    class MirroredRingBuffer : public ByteRing{
+        private:
+            char* data;         // the first of the two mappings
+            size_t maxLength;   // the length of ONE mapping
+            size_t start;       // where the next pop starts
+            size_t currSize;
+
+            void unmap();
+
+        public:
+            /* initializes internal data to be empty
+            */
+            MirroredRingBuffer();
+
+            /* maps the memory for a ring of (at least) maxLength
+                and must be > 0
+                throws a runtime_error if the mapping fails*/
+            MirroredRingBuffer(size_t maxLength);
+
+            MirroredRingBuffer(const MirroredRingBuffer&) = delete;
+            MirroredRingBuffer& operator=(const MirroredRingBuffer&) = delete;
+            MirroredRingBuffer(MirroredRingBuffer&& other);
+            MirroredRingBuffer& operator=(MirroredRingBuffer&& other);
+
+            ~MirroredRingBuffer();
+
+            int push(const std::string& toAdd, size_t size);
+            int push(std::span<const char> toAdd) override;
+            int pop(std::string& dest, size_t popAmount) override;
+            size_t pop_into(std::span<char> dest) override;
+            Regions peek(size_t offset, size_t n) override;
+            Regions readable_regions() override;
+            int consume(size_t n) override;
+            std::string getContents() override;
+            bool isEmpty() override;
+            size_t size() override;
+
+            /*the actual amount of characters the ring can hold
+            (maxLength rounded up to the page size)*/
+            size_t capacity() override;
+
+            /*maps a new ring of (at least) newLength and moves the 
+            contents over (OUTOFBOUNDS if they don't fit)*/
+            int resize(size_t newLength) override;
+
+            /*the free space is always one piece here
+            (the second span is always empty)*/
+            WritableRegions prepare(size_t n) override;
+            int commit(size_t n) override;
+    };
+
+    /*A ring buffer of characters that is safe to use from exactly TWO
+    threads at once without locks:
+        - ONE producer thread that only calls push() (or prepare/commit)
+        - ONE consumer thread that calls everything else 
+            (pop, pop_into, peek, readable_regions, consume, getContents)
+    size() and isEmpty() can be called from either one
+
+    Instead of start/end that wrap, it keeps two counters that only 
+    ever go up:
+        head - how many characters were ever popped   (consumer writes)
+        tail - how many characters were ever pushed   (producer writes)
+    so currSize is just tail - head, and the index into data is the 
+    counter masked by (capacity - 1) (capacity is rounded up to a
+    power of two).
+
+    The producer publishes with a release store of tail after it wrote
+    the data, and the consumer reads tail with an acquire load before it 
+    reads the data (and the same the other way around for head). Each 
+    side keeps its own counter and a cached copy of the other side's
+    counter on its own cache line so they don't false-share.
+
+    A peek() view stays valid until the consumer consumes it (the 
+    producer never writes over what hasn't been consumed)
+    */
+    class SPSCRingBuffer : public ByteRing{
+        private:
+            //written by the consumer
+            alignas(CACHELINESIZE) std::atomic<size_t> head;
+            size_t cachedTail;              // last tail the consumer saw
+
+            //written by the producer
+            alignas(CACHELINESIZE) std::atomic<size_t> tail;
+            size_t cachedHead;              // last head the producer saw
+
+            //never written after construction
+            alignas(CACHELINESIZE) std::vector<char> data;
+            size_t mask;
+
+            /*how many characters the consumer can read right now*/
+            size_t readable();
+
+        public:
+            /* initializes internal data to be empty
+            */
+            SPSCRingBuffer();
+
+            /* initializes internal data to (at least) maxLength
+                and must be > 0*/
+            SPSCRingBuffer(size_t maxLength);
+
+            //the atomics can't be copied (and the threads using it
+            // wouldn't know about the copy anyways)
+            SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+            SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+            int push(const std::string& toAdd, size_t size);
+            int push(std::span<const char> toAdd) override;
+            int pop(std::string& dest, size_t popAmount) override;
+            size_t pop_into(std::span<char> dest) override;
+            Regions peek(size_t offset, size_t n) override;
+            Regions readable_regions() override;
+            int consume(size_t n) override;
+            std::string getContents() override;
+            bool isEmpty() override;
+            size_t size() override;
+
+            /*the actual amount of characters the ring can hold
+            (maxLength rounded up to a power of two)*/
+            size_t capacity() override;
+
+            /*makes the data (at least) newLength long and keeps the 
+            contents (OUTOFBOUNDS if they don't fit)
+            NOT thread-safe: only call it when no other thread is
+            using the ring*/
+            int resize(size_t newLength) override;
+
+            /*producer side like push(): commit() is what publishes 
+            the written characters to the consumer*/
+            WritableRegions prepare(size_t n) override;
+            int commit(size_t n) override;
+    };
+
+    /*A ring buffer whose size is fixed at compile time
+        - T is what it holds (char for byte streams, or something
+            like a frame descriptor or history event for queues)
+        - Capacity has to be a power of two
+
+    Like SPSCRingBuffer it keeps two counters that only go up (head
+    and tail) and masks them with (Capacity - 1) to get the index, so
+    there is no "if(end >= maxLength) end = 0" anywhere. The data
+    lives inline (std::array), so it doesn't allocate.
+
+    NOT thread-safe (use SPSCRingBuffer for that)
+    */
+    template<typename T, size_t Capacity>
+    class RingBuffer{
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                        "RingBuffer Capacity has to be a power of two");
+
+        private:
+            static constexpr size_t MASK = Capacity - 1;
+
+            std::array<T, Capacity> data;
+            size_t head = 0;            // how many were ever popped
+            size_t tail = 0;            // how many were ever pushed
+
+            inline void checkInvariants(const char* function){
+                if constexpr(CHECKINVARIANTS){
+                    if(tail - head > Capacity){
+                        bufferError(std::string("FATAL ERROR: the size is larger than the capacity\n"
+                                                "size: ") + std::to_string(tail - head) + 
+                                                " capacity: " + std::to_string(Capacity) + "\n"
+                                                "in " + function + " function in RingBuffer in ring.hpp");
+                    }
+                }
+            }
+
+        public:
+            /*pushes one value
+            returns OUTOFBOUNDS if it is full, otherwise 1*/
+            inline int push(const T& value){
+                if(tail - head == Capacity){
+                    return OUTOFBOUNDS;
+                }
+                data[tail & MASK] = value;
+                tail++;
+                checkInvariants("push()");
+                return 1;
+            }
+
+            /*pushes every value in values (all or nothing)
+            returns OUTOFBOUNDS if they don't all fit, otherwise 1*/
+            inline int push(std::span<const T> values){
+                if(values.size() > Capacity - (tail - head)){
+                    return OUTOFBOUNDS;
+                }
+                size_t index = tail & MASK;
+                size_t firstPart = std::min(values.size(), Capacity - index);
+                std::copy(values.begin(), values.begin() + firstPart, data.begin() + index);
+                std::copy(values.begin() + firstPart, values.end(), data.begin());
+                tail += values.size();
+                checkInvariants("push()");
+                return 1;
+            }
+
+            /*pops the oldest value into dest
+            returns OUTOFBOUNDS if it is empty, otherwise 1*/
+            inline int pop(T& dest){
+                if(tail == head){
+                    return OUTOFBOUNDS;
+                }
+                dest = std::move(data[head & MASK]);
+                head++;
+                return 1;
+            }
+
+            /*pops up to dest.size() values into dest
+            returns how many were popped*/
+            inline size_t pop_into(std::span<T> dest){
+                size_t limit = std::min(dest.size(), tail - head);
+                size_t index = head & MASK;
+                size_t firstPart = std::min(limit, Capacity - index);
+                std::move(data.begin() + index, data.begin() + index + firstPart, dest.begin());
+                std::move(data.begin(), data.begin() + (limit - firstPart), dest.begin() + firstPart);
+                head += limit;
+                return limit;
+            }
+
+            /*the oldest value (without popping it)
+            only call it when the buffer is not empty*/
+            inline T& front(){
+                if constexpr(CHECKINVARIANTS){
+                    if(tail == head){
+                        bufferError("FATAL ERROR: front() of an empty RingBuffer\n"
+                                    "in front() function in RingBuffer in ring.hpp");
+                    }
+                }
+                return data[head & MASK];
+            }
+
+            /*the value offset after the oldest one (without popping it)*/
+            inline T& at(size_t offset){
+                if constexpr(CHECKINVARIANTS){
+                    if(offset >= tail - head){
+                        bufferError("FATAL ERROR: at() is past the end of the RingBuffer\n"
+                                    "in at() function in RingBuffer in ring.hpp");
+                    }
+                }
+                return data[(head + offset) & MASK];
+            }
+
+            /*drops n values from the front
+            if there are less than n, drops everything and 
+                returns OUTOFBOUNDS, otherwise 1*/
+            inline int consume(size_t n){
+                if(n > tail - head){
+                    head = tail;
+                    return OUTOFBOUNDS;
+                }
+                head += n;
+                return 1;
+            }
+
+            /*returns a copy of the contents, oldest first*/
+            inline std::vector<T> getContents(){
+                checkInvariants("getContents()");
+                std::vector<T> ret;
+                ret.reserve(tail - head);
+                for(size_t i = head;i != tail;i++){
+                    ret.push_back(data[i & MASK]);
+                }
+                return ret;
+            }
+
+            inline bool isEmpty(){
+                return tail == head;
+            }
+
+            inline size_t size(){
+                return tail - head;
+            }
+
+            static constexpr size_t capacity(){
+                return Capacity;
+            }
+    };
 }
\ No newline at end of file
@@ -0,0 +1,307 @@
+#pragma once
+#include "socketLib.hpp"
+#include "reactor.hpp"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <optional>
+#include <functional>
+#include <cstdint>
+
+namespace socketstuffs{
+
+const size_t CLIENTSLABSIZE = 64;           // how many Clients one slab holds
+
+/*The live Clients of a server, looked up by their fd
+
+Slots are made in slabs of CLIENTSLABSIZE at a time and a closed
+one's slot goes on a free list for the next connection. The Client
+in it stays made too (only closeIt()-ed), and the next connection
+just connectIt()s it again, keeping its buffer (unless it grew), its
+pool and the buffers in it. So a storm of connects and disconnects
+doesn't make (or free) a Client each time, and a Client never moves
+once it's made (the Reactor handlers hold on to it)
+
+Looking one up is just an index, fds are small numbers and the
+kernel hands out the lowest free one
+*/
+template<typename Codec>
+class BasicClientTable{
+    private:
+        struct Slot{
+            std::optional<BasicClient<Codec>> client;
+            Slot* nextFree;
+            uint64_t serial;                // which connection the client is
+        };
+
+        ringbuffer::RingType ringType;      // what the Clients are made with
+        std::vector<std::unique_ptr<Slot[]>> slabs;
+        Slot* freeSlots;
+        std::vector<Slot*> byFd;            // nullptr where there's no client
+        size_t count;
+        uint64_t serials;                   // connections inserted so far
+
+        /*adds another slab and puts all of it on the free list*/
+        inline void grow(){
+            std::unique_ptr<Slot[]> slab = std::make_unique<Slot[]>(CLIENTSLABSIZE);
+            for(size_t i = 0;i<CLIENTSLABSIZE;i++){
+                slab[i].nextFree = i + 1 < CLIENTSLABSIZE ? &slab[i + 1] : freeSlots;
+            }
+            freeSlots = &slab[0];
+            slabs.push_back(std::move(slab));
+        }
+
+    public:
+        inline BasicClientTable(ringbuffer::RingType ringType = ringbuffer::STANDARD) :
+                                ringType(ringType), freeSlots(nullptr), count(0), serials(0){}
+
+        //Removed copy constructor because the Clients can't be copied
+        BasicClientTable(const BasicClientTable&) = delete;
+        BasicClientTable& operator=(const BasicClientTable&) = delete;
+
+        /*makes a Client for an accepted fd (Client::connectIt(int))
+        returns it, or nullptr if fd is -1 or already in the table*/
+        inline BasicClient<Codec>* insert(int fd){
+            if(fd < 0 || find(fd) != nullptr){
+                return nullptr;
+            }
+            if(freeSlots == nullptr){
+                grow();
+            }
+            Slot* slot = freeSlots;
+            freeSlots = slot->nextFree;
+            if(!slot->client){
+                slot->client.emplace(ringType);
+            }
+            else{
+                //the last connection's settings don't carry over
+                slot->client->setCompression(0);
+                slot->client->setIdleShrinkTime(std::chrono::milliseconds(IDLESHRINKTIMER));
+            }
+            slot->client->connectIt(fd);
+            slot->serial = ++serials;
+
+            if((size_t)fd >= byFd.size()){
+                byFd.resize(fd + 1, nullptr);
+            }
+            byFd[fd] = slot;
+            count++;
+            return &*slot->client;
+        }
+
+        /*the Client for fd, or nullptr*/
+        inline BasicClient<Codec>* find(int fd){
+            if(fd < 0 || (size_t)fd >= byFd.size() || byFd[fd] == nullptr){
+                return nullptr;
+            }
+            return &*byFd[fd]->client;
+        }
+
+        /*a number only fd's current connection has (the kernel hands
+        a closed fd out again, this tells the new connection on it
+        apart from the old one), or 0 if fd isn't in the table*/
+        inline uint64_t getSerial(int fd){
+            if(find(fd) == nullptr){
+                return 0;
+            }
+            return byFd[fd]->serial;
+        }
+
+        /*closes fd's Client and gives its slot back (the Client is
+        kept for the next insert())
+        returns 1, or UNKNOWNCLIENT if fd isn't in the table*/
+        inline int erase(int fd){
+            if(find(fd) == nullptr){
+                return UNKNOWNCLIENT;
+            }
+            Slot* slot = byFd[fd];
+            byFd[fd] = nullptr;
+            slot->client->closeIt();
+            slot->nextFree = freeSlots;
+            freeSlots = slot;
+            count--;
+            return 1;
+        }
+
+        /*calls f(fd, client) for every Client*/
+        template<typename Function>
+        inline void forEach(Function f){
+            for(size_t fd = 0;fd<byFd.size();fd++){
+                if(byFd[fd] != nullptr){
+                    f((int)fd, *byFd[fd]->client);
+                }
+            }
+        }
+
+        inline size_t size(){
+            return count;
+        }
+
+        /*how many slabs were made (each holds CLIENTSLABSIZE)*/
+        inline size_t getSlabCount(){
+            return slabs.size();
+        }
+};
+
+/*One listening port serving as many peers as connect to it, all
+on the thread running reactor
+
+openIt() opens the Socket and watches it, every connection is
+accepted (accept4(), non-blocking) into the client table and
+watched too, and every packet from any of them goes to onPacket
+with the Client it came from (to answer it, or keep it by its fd)
+
+When a peer hangs up (or its connection goes bad) it's taken out
+of the table and onClose gets its fd and the error (READCLOSE for
+a normal hang up)
+*/
+template<typename Codec>
+class BasicServer{
+    public:
+        using PacketHandler = std::function<void(BasicClient<Codec>& client,
+                                                    const std::string& id, std::string& message)>;
+        using CloseHandler = std::function<void(int fd, int error)>;
+
+    private:
+        Reactor& reactor;
+        Socket socket;
+        BasicClientTable<Codec> clients;
+        PacketHandler onPacket;
+        CloseHandler onClose;
+
+        uint64_t accepted;                  // connections accepted since openIt()
+        size_t peakClients;                 // the most that were connected at once
+
+        /*puts a just accepted fd in the table and watches it*/
+        inline void adopt(int fd){
+            BasicClient<Codec>* client = clients.insert(fd);
+            if(client == nullptr){
+                close(fd);
+                return;
+            }
+            accepted++;
+            if(clients.size() > peakClients){
+                peakClients = clients.size();
+            }
+            int val = reactor.watchClient(*client,
+                [this, client](const std::string& id, std::string& message){
+                    onPacket(*client, id, message);
+                },
+                [this, fd](int error){
+                    //the reactor already stopped watching it
+                    clients.erase(fd);
+                    if(onClose){
+                        onClose(fd, error);
+                    }
+                });
+            if(val != 1){
+                clients.erase(fd);
+            }
+        }
+
+    public:
+        inline BasicServer(Reactor& reactor, PacketHandler onPacket, CloseHandler onClose = nullptr,
+                            ringbuffer::RingType ringType = ringbuffer::STANDARD) :
+                            reactor(reactor), clients(ringType), onPacket(std::move(onPacket)),
+                            onClose(std::move(onClose)), accepted(0), peakClients(0){}
+
+        //Removed copy constructor because the Socket should not be copied
+        BasicServer(const BasicServer&) = delete;
+        BasicServer& operator=(const BasicServer&) = delete;
+
+        inline ~BasicServer(){
+            closeIt();
+        }
+
+        /*opens port (see Socket::openIt()) and starts accepting
+        reusePort -> other Servers can open the same port too (see
+                    ShardedServer)
+        returns 1, or whatever openIt() or Reactor::watchSocket() returned*/
+        inline int openIt(int port, int backlog = SOMAXCONN, bool reusePort = false){
+            int val = socket.openIt(port, backlog, reusePort);
+            if(val != 1){
+                return val;
+            }
+            val = reactor.watchSocket(socket, [this](int fd){
+                adopt(fd);
+            });
+            if(val != 1){
+                socket.closeIt();
+                return val;
+            }
+            accepted = 0;
+            peakClients = 0;
+            return 1;
+        }
+
+        /*closes every client and the socket (onClose isn't called)
+        returns 1*/
+        inline int closeIt(){
+            std::vector<int> fds;
+            clients.forEach([&](int fd, BasicClient<Codec>&){
+                fds.push_back(fd);
+            });
+            for(int fd : fds){
+                dropClient(fd);
+            }
+            if(socket.getSocketFD() != -1){
+                reactor.remove(socket.getSocketFD());
+            }
+            return socket.closeIt();
+        }
+
+        /*the Client on fd, or nullptr if there isn't one*/
+        inline BasicClient<Codec>* getClient(int fd){
+            return clients.find(fd);
+        }
+
+        /*hangs up on fd's client (onClose isn't called), safe from
+        inside onPacket
+        returns 1, or UNKNOWNCLIENT*/
+        inline int dropClient(int fd){
+            if(clients.find(fd) == nullptr){
+                return UNKNOWNCLIENT;
+            }
+            reactor.remove(fd);
+            return clients.erase(fd);
+        }
+
+        inline size_t getClientCount(){
+            return clients.size();
+        }
+
+        /*see ClientTable::getSerial()*/
+        inline uint64_t getClientSerial(int fd){
+            return clients.getSerial(fd);
+        }
+
+        /*the Reactor this Server runs on*/
+        inline Reactor& getReactor(){
+            return reactor;
+        }
+
+        inline uint64_t getAcceptCount(){
+            return accepted;
+        }
+
+        inline size_t getPeakClients(){
+            return peakClients;
+        }
+
+        inline size_t getSlabCount(){
+            return clients.getSlabCount();
+        }
+
+        inline int getPort(){
+            return socket.getPort();
+        }
+};
+
+/*the table of Clients (3 byte size) a Server keeps*/
+using ClientTable = BasicClientTable<framing::DefaultCodec>;
+
+/*the Server everything uses (Clients with the 3 byte size)*/
+using Server = BasicServer<framing::DefaultCodec>;
+
+}
@@ -0,0 +1,264 @@
+#pragma once
+#include "server.hpp"
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <future>
+#include <chrono>
+#include <cstdint>
+#include <pthread.h>    // For pthread_setaffinity_np
+#include <sched.h>      // For cpu_set_t and sched_getaffinity
+
+namespace socketstuffs{
+
+/*what one shard of a ShardedServer has done since openIt()*/
+struct ShardStats{
+    uint64_t accepted;                  // connections the kernel gave this shard
+    size_t clients;                     // connected right now
+    size_t peakClients;                 // the most that were connected at once
+    uint64_t packets;                   // packets handed to onPacket
+    int cpu;                            // the CPU it's pinned to (-1 if it isn't)
+};
+
+/*One port served by shardCount threads, each with its own Reactor,
+listening Socket and client table (a Server), so nothing is shared
+between them and more cores means more connections handled
+
+every shard opens the port with SO_REUSEPORT, and the kernel
+spreads the new connections across their Sockets (by a hash of
+the peer's address and port), so a connection is accepted and
+served by the same thread for all of its life
+
+onPacket and onClose run on the thread of whichever shard has the
+client, so they have to be fine with being called from shardCount
+threads at once (anything they share needs a lock or an atomic)
+
+start(true) pins shard i to the i-th CPU this process may run on
+(wrapping around if there are more shards than CPUs), so a shard
+keeps its caches and doesn't get moved around by the scheduler
+*/
+template<typename Codec>
+class BasicShardedServer{
+    public:
+        using PacketHandler = typename BasicServer<Codec>::PacketHandler;
+        using CloseHandler = typename BasicServer<Codec>::CloseHandler;
+
+    private:
+        struct Shard{
+            Reactor reactor;
+            BasicServer<Codec> server;
+            std::thread thread;
+            uint64_t packets;               // only touched on thread
+            int cpu;
+
+            inline Shard(PacketHandler& onPacket, CloseHandler& onClose, ringbuffer::RingType ringType) :
+                        server(reactor,
+                                [this, &onPacket](BasicClient<Codec>& client, const std::string& id,
+                                                    std::string& message){
+                                    packets++;
+                                    onPacket(client, id, message);
+                                },
+                                [&onClose](int fd, int error){
+                                    if(onClose){
+                                        onClose(fd, error);
+                                    }
+                                },
+                                ringType),
+                        packets(0), cpu(-1){}
+        };
+
+        PacketHandler onPacket;
+        CloseHandler onClose;
+        std::vector<std::unique_ptr<Shard>> shards;
+        bool running;
+
+        /*the CPUs this process is allowed on, in order*/
+        static inline std::vector<int> allowedCpus(){
+            std::vector<int> cpus;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if(sched_getaffinity(0, sizeof(set), &set) == 0){
+                for(int cpu = 0;cpu<CPU_SETSIZE;cpu++){
+                    if(CPU_ISSET(cpu, &set)){
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+            return cpus;
+        }
+
+        inline ShardStats readStats(Shard& shard){
+            return ShardStats{shard.server.getAcceptCount(), shard.server.getClientCount(),
+                                shard.server.getPeakClients(), shard.packets, shard.cpu};
+        }
+
+    public:
+        /*shardCount threads (at least 1), nothing is opened yet*/
+        inline BasicShardedServer(size_t shardCount, PacketHandler onPacket, CloseHandler onClose = nullptr,
+                                    ringbuffer::RingType ringType = ringbuffer::STANDARD) :
+                                    onPacket(std::move(onPacket)), onClose(std::move(onClose)), running(false){
+            if(shardCount == 0){
+                throw std::invalid_argument("FATAL ERROR: a ShardedServer needs at least one shard\n"
+                                            "in the constructor of ShardedServer in shardedServer.hpp");
+            }
+            for(size_t i = 0;i<shardCount;i++){
+                shards.push_back(std::make_unique<Shard>(this->onPacket, this->onClose, ringType));
+            }
+        }
+
+        //Removed copy constructor because the shards can't be copied
+        BasicShardedServer(const BasicShardedServer&) = delete;
+        BasicShardedServer& operator=(const BasicShardedServer&) = delete;
+
+        inline ~BasicShardedServer(){
+            closeIt();
+        }
+
+        /*opens port on every shard (SO_REUSEPORT), without starting
+        the threads yet
+        returns 1, or what the first Server::openIt() that failed
+            returned (the ones already open are closed again)*/
+        inline int openIt(int port, int backlog = SOMAXCONN){
+            for(size_t i = 0;i<shards.size();i++){
+                int val = shards[i]->server.openIt(port, backlog, true);
+                if(val != 1){
+                    for(size_t j = 0;j<i;j++){
+                        shards[j]->server.closeIt();
+                    }
+                    return val;
+                }
+                shards[i]->packets = 0;
+            }
+            return 1;
+        }
+
+        /*starts one thread per shard, each running its Reactor
+        pinToCpus -> pins every thread to its own CPU (see above)
+
+        returns 1 (also if it was already started)
+        returns BADAFFINITY if a thread could not be pinned (they
+            all run anyway)*/
+        inline int start(bool pinToCpus = false){
+            if(running){
+                return 1;
+            }
+            std::vector<int> cpus = pinToCpus ? allowedCpus() : std::vector<int>();
+            int ret = 1;
+            for(size_t i = 0;i<shards.size();i++){
+                Shard& shard = *shards[i];
+                shard.cpu = -1;
+                shard.thread = std::thread([&shard]{
+                    shard.reactor.run();
+                });
+                if(!pinToCpus){
+                    continue;
+                }
+                if(cpus.empty()){
+                    ret = BADAFFINITY;
+                    continue;
+                }
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpus[i % cpus.size()], &set);
+                if(pthread_setaffinity_np(shard.thread.native_handle(), sizeof(set), &set) != 0){
+                    ret = BADAFFINITY;
+                }
+                else{
+                    shard.cpu = cpus[i % cpus.size()];
+                }
+            }
+            running = true;
+            return ret;
+        }
+
+        /*stops and joins every shard's thread (the clients stay
+        connected, start() picks them up again)
+        returns 1*/
+        inline int stop(){
+            if(!running){
+                return 1;
+            }
+            for(std::unique_ptr<Shard>& shard : shards){
+                //fine even if the thread hasn't got into run() yet
+                shard->reactor.stop();
+            }
+            for(std::unique_ptr<Shard>& shard : shards){
+                shard->thread.join();
+            }
+            running = false;
+            return 1;
+        }
+
+        /*stops the threads and closes every shard (onClose isn't called)
+        returns 1*/
+        inline int closeIt(){
+            stop();
+            for(std::unique_ptr<Shard>& shard : shards){
+                shard->server.closeIt();
+            }
+            return 1;
+        }
+
+        /*fills stats with what shard has done, asking its thread for
+        them if it's running (so not from inside onPacket/onClose of
+        another shard while that one is stuck waiting on this)
+
+        returns 1
+        returns UNKNOWNSHARD if shard isn't less than getShardCount()
+        returns QUEUEFULL or POLLTIMEDOUT if the shard's thread
+            didn't get to it*/
+        inline int getStats(size_t shard, ShardStats& stats){
+            if(shard >= shards.size()){
+                return UNKNOWNSHARD;
+            }
+            Shard& s = *shards[shard];
+            if(!running || std::this_thread::get_id() == s.thread.get_id()){
+                stats = readStats(s);
+                return 1;
+            }
+            std::shared_ptr<std::promise<ShardStats>> answer = std::make_shared<std::promise<ShardStats>>();
+            std::future<ShardStats> result = answer->get_future();
+            if(s.reactor.post([this, &s, answer]{
+                answer->set_value(readStats(s));
+            }) != 1){
+                return QUEUEFULL;
+            }
+            if(result.wait_for(std::chrono::milliseconds(POLLTIMER)) != std::future_status::ready){
+                return POLLTIMEDOUT;
+            }
+            stats = result.get();
+            return 1;
+        }
+
+        /*getStats() of every shard added up (cpu is -1)
+        returns 1, or the first error getStats() returned*/
+        inline int getTotalStats(ShardStats& total){
+            total = ShardStats{0, 0, 0, 0, -1};
+            for(size_t i = 0;i<shards.size();i++){
+                ShardStats stats;
+                int val = getStats(i, stats);
+                if(val != 1){
+                    return val;
+                }
+                total.accepted += stats.accepted;
+                total.clients += stats.clients;
+                total.peakClients += stats.peakClients;
+                total.packets += stats.packets;
+            }
+            return 1;
+        }
+
+        inline size_t getShardCount(){
+            return shards.size();
+        }
+
+        inline int getPort(){
+            return shards[0]->server.getPort();
+        }
+};
+
+/*the ShardedServer everything uses (Clients with the 3 byte size)*/
+using ShardedServer = BasicShardedServer<framing::DefaultCodec>;
+
+}
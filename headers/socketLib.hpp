@@ -1,410 +1,954 @@
-#include "sharedstuff.hpp"
-#include "ring.hpp"
-#include "history.hpp"
-#include "fsa.hpp"
-#include <sys/socket.h> // For socket(), bind(), 
-                        //  listen(), accept(), and send()
-                        // and getaddrinfo()/addrinfo
-#include <sys/types.h>  // also for getaddrinfo()/addrinfo (not specified)
-#include <netdb.h>      // also for getaddrinfo()/addrinfo
-
-#include <netinet/in.h> // For sockaddr_in structure.
-#include <arpa/inet.h>  // For inet_ntoa() and htons() functions.
-#include <unistd.h>     // For close().
-#include <poll.h>       // For poll and POLLIN
-#include <fcntl.h>      // For fcntl, F_GETFL, F_SETFL, O_NONBLOCK
-
-#include <vector>
-#include <string>
-#include <cstring>
-#include <algorithm>
-#include <cerrno>
-#include <stdexcept>
-#include <utility>
-
-namespace socketstuffs{
-
-/*
-list of possible error codes and other constants
-*/
-enum ErrorCodes{
-    //error codes
-    INVALIDPORT =                   -10,
-    NOTOPENED =                     -11,
-    NONEMPTYVECTOR =                -12,
-    ALREADYOPEN =                   -13,
-    NORESPONSE =                    -14, 
-    POLLTIMEDOUT =                  -15,
-    UNKNOWNPOLLRESULT =             -16,
-    BADRECV =                       -17,
-    READCLOSE =                     -18,
-    MSGTOOBIG =                     -19,
-    IDTOOBIG =                      -20,
-    BADSEND =                       -21,
-    SENDCLOSE =                     -22,
-
-    SENDERROR =                     -23,
-    BADINPUTERROR =                 -24,
-    ALREADYBUSY =                   -25,
-
-    //constants
-    POLLTIMER =                   10000,
-    UNSCANNEDPORT =                 -1,
-    BADPORT =                       0,
-    GOODPORT =                      1,
-    LOWERLIMIT =                     1023,
-    NUMPORTS =                      65536
-};
-
-/* The states the connections are in
-*/
-const int INIT                          = 0;
-const int IDLE                          = 2;
-const int BUSY                          = 3;
-
-/*function that takes a return code from the possible 
-functions below
-returns a user-friendly message that explains what the
-error is*/
-std::string interpretError(int errCode);
-
-/*when given an empty vector
-it will fill that vector with  valid ports
-returns size of validPorts
-if vector is not empty, returns NONEMPTYVECTOR error*/
-int getValidScannedPorts(int startport, int endport, 
-                        std::vector<int>& validPorts, bool display=false);
-
-class Socket;
-/*A middle-level class (that's meant to be hidden)
-doing jobs like
- - holding data about file descriptor 
-    about the socket connection (the client)
- - low-level calls to send and recv and all the error handling
-    so that ONE SINGLE CLEAR packet is handled
-
-receives a message from the client, expected message packet is 1 Megabyte:
-    3 bytes                     - size of message
-    13 bytes                    - the username
-    1,048,560 (1Megabyte - 16)  - the remaining message
-    
-Note that the verification DOES NOT happen at this level.
-    That way we can do verification on a separate function for more
-    generality
-
-Client is not one we should generate on their own (I can't think of
-more ways to make it inaccessible to the public). The best practice would
-be the use of the Connection class, which will properly ensure Socket
-connection is made. At the same time, I do leave this open so that 
-it can be modified and improved.
-*/
-class Client{
-    private:
-        struct sockaddr_storage theiraddr;
-        struct pollfd clientfd[1];      // the file descriptor
-                                        // of this file contains
-                                        // the state of the 
-                                        // connection
-
-        ringbuffer::RingBufferS buffer;
-
-    public:
-        /* This constructor is just makes everything empty
-            and sets fd to be bad (-1)
-        */
-        Client();
-                                                            // the size in case
-        //Removed copy constructor because Client should not be copied
-        Client(const Client&) = delete;
-        Client& operator=(const Client&) = delete;
-                                                            // read too much in one read
-
-        /* The destructor disconnects the client if it is still 
-            connected
-        */
-        ~Client();
-
-        /* given a socket, it accesses its members (Client
-            is a friend class) to connect to an actual 
-            client that is trying to connect to the socket
-
-            also prepares buffer to a certain size as to get ready
-            for read
-
-            returns 1 on success
-
-            there will be a timer to connect so that 
-            we can occasionally get an error message 
-            if the wait is too long, 
-            as opposed to waiting infinitely, and then
-            figuring that after some waiting, something 
-            is wrong and then force quitting
-
-            A POLLTIMEDOUT will be returned when it times out
-
-            Things that can happen to get negative poll
-             - ?
-            so return UNKNOWNPOLLRESULT
-        */
-        int connectIt(Socket& s);
-
-        /*receives a message from the client, expected message packet is 1 Megabyte:
-            3 bytes                     - size of message
-            13 bytes                    - the username
-            1,048,560 (1Megabyte - 16)  - the remaining message
-        
-        getPacket has a poll() and is willing to wait
-        POLLTIMER seconds before returning a POLLTIMEDOUT
-
-        throws a runtime_exception error if fd is bad
-        */
-        int getPacket(std::string& id, std::string& message);
-
-        /*sends a message from the client, expected message packet is 1 Megabyte:
-            3 bytes                     - size of message
-            13 bytes                    - the username
-            1,048,560 (1Megabyte - 16)  - the remaining message
-
-        sendPacket has a poll(), and is willing to wait
-        POLLTIMER seconds before returning a POLLTIMEDOUT
-
-        throws a runtime_exception error if fd is bad
-        
-        if message is too big, returns MSGTOOBIG
-        */
-        int sendPacket(const std::string& id, 
-                        const std::string& message);
-
-        /*Closes the client socket
-        (Similar to the destructor)
-        */
-        int closeIt();
-
-};
-
-/* A class that acts as a container for variables related to 
-the socket created on the system. 
- - Assumes the ip address is self (127.0.0.1)
-
-these variables include:
-- addrinfo
-- sockaddr structs 
-- pollfd for polling
-
-it also separates the low level socket operations 
-such as "getaddrinfo" and "socket->bind->listen->accept"
-
-from calls
-such as "open socket" and "connect to client" */
-class Socket{
-    private:
-        struct addrinfo hints;              //helper for servinfo (when calling getaddrinfo)
-        struct addrinfo* servinfo;          //the result of calling getaddrinfo
-
-        struct pollfd socketfd[1];           //contains socketfd but also used for polling
-//deprecated
-        //struct pollfd clientfd[];           //contains fd for client socket but also for polling
-
-        int port;                           //port number this socket is connected to
-                                            //-1 if not connected
-
-/*>>>DEPRECATED<<<*/
-        /*implemented by Min: 
-            ->  https://github.com/MiniMinja/CircularBuffer
-        */
-        //RingBufferS localBuffer;            //This is the buffer that handles the queueing of 
-                                            //incoming messages (multiple message are contiguous
-                                            //and it's possible to have mixed messages from a 
-                                            //single packet)
-
-    public:
-        /*initializes a socket to all zeros, 
-            assuming that all setting happens at the open*/
-        Socket();
-        
-        //Removed copy constructor because Socket should not be copied
-        Socket(const Socket&) = delete;
-        Socket& operator=(const Socket&) = delete;
-
-        //specified functions
-        /*keeps a socket open in NONblocking mode for listening at port
-            and keeps track of that port in the member value
-            returns 1 if port open was sucessful
-            if port is not valid, return INVALIDPORT error
-            if openIt is called again without a close, 
-            return ALREADYOPEN error*/
-        int openIt(int port);
-        /*closes the opened socket
-            close should generally work 
-            even if the socket will never opened to begin with*/
-        int closeIt();
-        /*returns the port value this object is connected to
-            (note that the port value is -1 if it is not 
-            connected to anything) */
-        int getPort();
-        /*returns the socket file descriptor id
-            if the socket isn't connected, returns -1*/
-        int getSocketFD();
-
-        friend class Client;
-
-//>>>>>>>>>>>>>>>DEPRECATED<<<<<<<<<<<<<<<<<<<<<
-// The client functions are deprecated and will be moved to the client class
-        /*essentially calls accept on incoming connect requests
-        and then verifies with ping call 
-            if not trusted client, will return the NOTTRUSTWORTHY error
-            if something else bad happend, will return appropriate error code */
-        //int getTrustedClient();
-        /*sends the whole message to the client (hides the loop that keeps
-            calling send() to send the whole message)
-            if socket disconnected, will return appropriate error
-            if whole message not send because of other reasons, 
-                will return INCOMPLETESEND error
-            */
-        //int sendToClient(const std::string msg);
-        /*receives a message from the client, expected message packet is 1 Megabyte:
-            3 bytes                     - size of message
-            13 bytes                    - the username
-            1,048,560 (1Megabyte - 16)  - the remaining message
-            
-            If the promised message isn't received (< 16 bytes or < size of message)
-                this will wait upon this message for up to <sharedstuff:MAXWAITSECS>
-                in which once the time has run out, the whole message will be dropped
-            If we havent received the full message but socket disconnects
-                this will also drop everything in the buffer
-            */
-        //std::string readFromClient();
-        /* closes the client, but does not close the socket 
-            also returns some error code, though a close should
-            still happen despite some wierd shenanigans*/
-        //int closeClient();
-
-
-};
-
-/*This is the convenient interface that provides ways to send and receive 
-messages from services that connect to this server via the port 
-
-In the most biggest, general, and simplest terms:
-
-1. Creates a port available to connect and awaits a client to connect
-2. If a client is connected, it alternates between two states:
-    IDLE: essentially does nothing on its own (except maybe send PING to
-        verify the connection) and awaits for something to tell it to
-        send something over the network
-    BUSY: the job got told to send something over the network, so it 
-        hangs and keeps waiting until the client sends a response. Once
-        the response is received from the client, this goes back to the 
-        IDLE state
-
-This can be viewed like a fsa state:
-
-         (client connected)                                 
-OPEN ---------------------->IDLE---->---->-----+
-                             ^                 |
-                             |                 | (get a query)  
-           (got a response)  |                 |
-                             |                 |
-                           BUSY<----<----<-----+
-
-
-In reality, this is achieved by means of a (almost over-abstractified)
-semaphore. There isn't really a variable, but instead a function call
-will restart the function (thus restarting the while loop) 
-while any hanging states will return (or exit) the function
-(thus pause the while loop) 
-*/
-class Connection : public fsa::FSA{ // inheritence to enforce
-                                    // the idea of FSA (what is this
-                                    //at its core)
-private:
-    history::History record;
-
-    std::pair<std::string, std::string> msgQueue;
-
-    Socket s;
-    Client c;
-
-    std::string lastOutput;
-
-protected:
-    /*The implementation details of job are listed above
-    */
-    override void job();
-
-public:
-    Connection();
-
-    /* this simple connects to a socket
-    */
-    override void start();
-    /* The format of the input for Connection is 2 parts:
-        - ID
-        - MESSAGE
-    This gets added to the msgQueue pair which is the 
-    two data listed above
-
-    This input should block when it tries to input while the 
-    state is in BUSY mode (already processing) 
-    and return ALREADYBUSY
-
-    if the size of the vector is not 2, 
-        let the user know it's an invalid size
-    if the size of the id is greater than 13
-    if the size of the second argument is bigger than a Megabyte
-        and return BADINPUTERROR 
-    */
-    override void input(std::vector<std::string>& args);
-    /*This disconnects to a socket
-    */
-    override void exit();
-
-    /*This function does get the last output
-    but if no output was outputted last, it will
-    return ">@EMPTY@<"
-    */
-    std::string getLastOutput();
-
-    const std::list<std::string>& getRecord();
-};
-
-//These are the functions the Connection does
-//and these are pulled out to enforce SRP
-
-/*Tries to connect to a valid socket and client
-returns 1 on connect
-
-raises an error on unable to connect
-*/
-int connectClient(Socket& s, Client& c, history::History& record);
-
-
-/*sends query to this job. 
-
-Then it calls poll to see if a response is given
-
-returns 1 on successful send and response
-
-return SENDERROR when unable to send
-return -1 when the response is nothing
-*/
-int sendQuery(const std::string& id, 
-                const std::string& query,  
-                Client& c, 
-                history::History& record);
-
-/*Not sure if this function is needed
-but this sends "PING" and waits for "PONG"
-
-a difference response or a too long of a wait response
-leads to a disconnect
-
-returns 1 on successful send and response
-
-returns SENDERROR when unable to send
-returns -1 when the response is no PONG
-*/
-int verifyConnection(Client& c, history::History& record);
-
-}
-
+#pragma once
+#include "sharedstuff.hpp"
+#include "ring.hpp"
+#include "history.hpp"
+#include "fsa.hpp"
+#include "mpscQueue.hpp"
+#include "frameDecoder.hpp"
+#include "frameId.hpp"
+#include "bufferPool.hpp"
+#include "compression.hpp"
+#include "uring.hpp"
+#include <sys/socket.h> // For socket(), bind(), 
+                        //  listen(), accept(), and send()
+                        // and getaddrinfo()/addrinfo
+#include <sys/types.h>  // also for getaddrinfo()/addrinfo (not specified)
+#include <netdb.h>      // also for getaddrinfo()/addrinfo
+
+#include <netinet/in.h> // For sockaddr_in structure.
+#include <arpa/inet.h>  // For inet_ntoa() and htons() functions.
+#include <unistd.h>     // For close().
+#include <poll.h>       // For poll and POLLIN
+#include <fcntl.h>      // For fcntl, F_GETFL, F_SETFL, O_NONBLOCK
+#include <sys/uio.h>    // For readv, writev and iovec
+#include <sys/sendfile.h> // For sendfile
+#include <sys/stat.h>   // For fstat
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <utility>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <span>
+#include <functional>
+#include <string_view>
+
+namespace socketstuffs{
+
+/*
+list of possible error codes and other constants
+*/
+enum ErrorCodes{
+    //error codes
+    INVALIDPORT =                   -10,
+    NOTOPENED =                     -11,
+    NONEMPTYVECTOR =                -12,
+    ALREADYOPEN =                   -13,
+    NORESPONSE =                    -14, 
+    POLLTIMEDOUT =                  -15,
+    UNKNOWNPOLLRESULT =             -16,
+    BADRECV =                       -17,
+    READCLOSE =                     -18,
+    MSGTOOBIG =                     -19,
+    IDTOOBIG =                      -20,
+    BADSEND =                       -21,
+    SENDCLOSE =                     -22,
+
+    SENDERROR =                     -23,
+    BADINPUTERROR =                 -24,
+    ALREADYBUSY =                   -25,
+    BADRINGTYPE =                   -26,
+    QUEUEFULL =                     -27,
+    BADFILE =                       -28,
+    MIDSTREAM =                     -29,
+    BADCOMPRESSION =                -30,
+    BADEPOLL =                      -31,
+    NOTWATCHED =                    -32,
+    ALREADYWATCHED =                -33,
+    BADACCEPT =                     -34,
+    UNKNOWNCLIENT =                 -35,
+    NOURING =                       -36,
+    UNKNOWNSHARD =                  -37,
+    BADAFFINITY =                   -38,
+    UNKNOWNCOMMAND =                -39,
+    COMMANDFAILED =                 -40,
+
+    //constants
+    POLLTIMER =                   10000,
+    READERPOLLTIMER =               100,    // how often the reader thread
+                                            // checks if it should stop
+    INITIALBUFFERSIZE =             16 * 1024,  // what a Client's buffer starts at
+    MAXBUFFERSIZE =                 2 * 1024 * 1024,  // and the most it grows to
+    IDLESHRINKTIMER =               30000,  // default ms without a big packet
+                                            // before the buffer shrinks back
+    MSGQUEUESIZE =                  64,     // how many queries Connection
+                                            // can hold before it's full
+    MAXJOBBATCH =                   16,     // how many queries job() takes
+                                            // out of the queue at once
+    MAXSENDBATCH =                  64,     // how many packets sendPackets()
+                                            // hands to one sendmsg()
+    MAXREACTOREVENTS =              256,    // how many events one epoll_wait()
+                                            // of a Reactor takes
+    REACTORQUEUESIZE =              1024,   // how many post()-ed tasks a
+                                            // Reactor can hold
+    REPLYPOSTTIMER =                1000,   // ms a CommandDispatcher worker
+                                            // waits for room in a full Reactor
+    URINGBUFFERS =                  64,     // how many buffers useUring()
+                                            // gives the kernel to recv into
+    URINGBUFFERSIZE =               16 * 1024,  // and how big each one is
+    UNSCANNEDPORT =                 -1,
+    BADPORT =                       0,
+    GOODPORT =                      1,
+    LOWERLIMIT =                     1023,
+    NUMPORTS =                      65536
+};
+
+/* The states the connections are in
+*/
+const int INIT                          = 0;
+const int IDLE                          = 2;
+const int BUSY                          = 3;
+
+/*function that takes a return code from the possible 
+functions below
+returns a user-friendly message that explains what the
+error is*/
+std::string interpretError(int errCode);
+
+/*when given an empty vector
+it will fill that vector with  valid ports
+returns size of validPorts
+if vector is not empty, returns NONEMPTYVECTOR error*/
+int getValidScannedPorts(int startport, int endport, 
+                        std::vector<int>& validPorts, bool display=false);
+
+class Socket;
+
+/*One received packet: who it's from and what it says*/
+struct Frame{
+    framing::FrameId id;
+    std::string message;
+};
+
+/*Same as Frame, but the message is borrowed from a Client's pool
+(it goes back when the PooledFrame is destroyed)*/
+struct PooledFrame{
+    framing::FrameId id;
+    bufferpool::PooledBuffer message;
+};
+
+/*One packet for sendPackets()
+(only views, so the strings they point at have to
+outlive the sendPackets() call)*/
+struct OutFrame{
+    std::string_view id;
+    std::string_view message;
+};
+
+/*A middle-level class (that's meant to be hidden)
+doing jobs like
+ - holding data about file descriptor 
+    about the socket connection (the client)
+ - low-level calls to send and recv and all the error handling
+    so that ONE SINGLE CLEAR packet is handled
+
+receives a message from the client, expected message packet is 1 Megabyte:
+    3 bytes                     - size of message
+    13 bytes                    - the username
+    1,048,560 (1Megabyte - 16)  - the remaining message
+    
+Note that the verification DOES NOT happen at this level.
+    That way we can do verification on a separate function for more
+    generality
+
+Client is not one we should generate on their own (I can't think of
+more ways to make it inaccessible to the public). The best practice would
+be the use of the Connection class, which will properly ensure Socket
+connection is made. At the same time, I do leave this open so that 
+it can be modified and improved.
+
+Codec is the header layout (a framing::FrameCodec). The sizes above
+are the ones of framing::DefaultCodec, which is what Client is, and
+WideClient uses framing::WideCodec (4 byte size). Both sides of a 
+connection have to agree on it.
+*/
+template<typename Codec>
+class BasicClient{
+    static_assert(Codec::IDBYTES == framing::FrameId::SIZE, "a Client's ids are FrameIds");
+
+    private:
+        struct sockaddr_storage theiraddr;
+        struct pollfd clientfd[1];      // the file descriptor
+                                        // of this file contains
+                                        // the state of the 
+                                        // connection
+
+        ringbuffer::RingType ringType;                 // which ring connectIt() makes
+        std::unique_ptr<ringbuffer::ByteRing> buffer;
+
+        /*keeps calling recv() (after a poll()) and pushing into buffer
+            until buffer holds at least needed bytes
+
+            returns 1 once there is enough
+            returns POLLTIMEDOUT, BADRECV or READCLOSE like getPacket
+        */
+        int fillBuffer(size_t needed);
+
+        /*one recvmsg() straight into the free space of buffer 
+            (prepare()/commit(), no chunk in between)
+            flags go to recvmsg() (MSG_DONTWAIT for tryGetPacket())
+            returns what recvmsg() returned
+        */
+        ssize_t recvIntoBuffer(int flags = 0);
+
+        /*takes one packet out of buffer if ALL of it is there
+            (doesn't recv anything)
+
+            returns 1 with id and message filled in
+            returns 0 if the packet isn't complete yet, and sets needed
+                to how many bytes buffer has to hold for it
+            returns MSGTOOBIG if the size in the header is too big
+                (and sets recvBroken)
+        */
+        template<typename Message>
+        int parsePacket(framing::FrameId& id, Message& message, size_t& needed);
+
+        /*pops the messageSize bytes of a message (the header is already
+            gone) into a string (appended) or a buffer from pool
+            compressed -> the flag was set in the header, so the bytes
+                            are inflated on the way out
+
+            returns 1, or BADCOMPRESSION if they don't inflate
+        */
+        int popMessage(std::string& message, size_t messageSize, bool compressed);
+        int popMessage(bufferpool::PooledBuffer& message, size_t messageSize, bool compressed);
+
+        /*buffer->pop() of a message parsePacket() already made sure 
+            is all there (throws if it somehow isn't)*/
+        void popRaw(std::string& message, size_t messageSize);
+
+        /*what getPacket() / getPackets() do, for either kind of message*/
+        template<typename Message>
+        int receivePacket(framing::FrameId& id, Message& message);
+        template<typename FrameType>
+        int receivePackets(std::vector<FrameType>& out, size_t max);
+
+        bufferpool::BufferPool pool;        // where the pooled messages come from
+
+        /*copies the header at the front of buffer out, without 
+            popping anything (buffer has to hold at least 
+            Codec::HEADERSIZE bytes)
+        */
+        void peekHeader(typename Codec::Header& header);
+
+        bool streaming;                     // getPacketStream() is partway
+                                            // through a message
+        framing::FrameId streamId;          // the id of that message
+        size_t streamRemaining;             // and how much of it is left
+
+        framing::BasicFrameDecoder<Codec> decoder;  // how far tryGetPacket() got
+        bool drained;                       // tryGetPacket()'s last recv() said EAGAIN
+        bool recvBroken;                    // a header had a size too big, so nothing
+                                            // after it lines up with a packet anymore
+
+        /*what connectIt() does once it has an fd: makes the buffer
+            (for ringType) and forgets any half received packet*/
+        void prepareConnection();
+
+        size_t compressThreshold;           // messages at least this big get compressed
+                                            // by sendPacket() (0 -> never)
+        int compressLevel;                  // zlib's level for them
+        std::string sendScratch;            // compressed bytes on their way out
+        std::string recvScratch;            // and on their way in (two of them, so
+                                            // sending and receiving can be on
+                                            // different threads; kept so they
+                                            // stop allocating)
+        compression::Inflater inflater;     // for compressed getPacketStream() messages
+        bool streamCompressed;              // the streamed message is compressed
+        int streamError;                    // what went wrong inflating it (1 if nothing)
+
+        /*the buffer starts at INITIALBUFFERSIZE and only grows 
+            (doubling, up to MAXBUFFERSIZE) when a packet needs it, 
+            so idle clients don't each hold 2MB
+        */
+        std::chrono::milliseconds idleShrinkTime;
+        std::chrono::steady_clock::time_point lastBigPacket;   // last time the buffer 
+                                                            // needed to be big
+
+        /*makes sure buffer can hold at least needed bytes, doubling 
+            its capacity until it does
+            returns 1, or MSGTOOBIG if needed is more than MAXBUFFERSIZE
+        */
+        int growBuffer(size_t needed);
+
+        uint64_t sendCalls;                 // poll()/sendmsg() calls made sending
+
+        /*keeps calling sendmsg() until every byte in parts has gone out,
+            only poll()-ing when the socket can't take any more right now
+            (parts gets changed to skip over what went out)
+
+            more -> MSG_MORE, there is more coming right after this, so
+                    the kernel can hold the tail back to fill a segment
+
+            returns 1 once everything is sent
+            returns POLLTIMEDOUT, BADSEND or SENDCLOSE like sendPacket
+        */
+        int sendParts(struct iovec* parts, int partCount, bool more);
+
+        std::thread reader;                 // runs readerLoop() after startReader()
+        std::atomic<bool> readerRunning;
+        std::atomic<int> readerStatus;      // 1 while the reader is fine, 
+                                            // otherwise the error it stopped on
+        std::mutex readerLock;              // only for waiting on readerWake
+        std::condition_variable readerWake; // the reader pushed something (or
+                                            // stopped), or the consumer wants more
+
+        /*wakes whichever side is waiting on readerWake*/
+        void wakeReaderWaiters();
+
+        /*what the reader thread does: poll(), recv() and push into 
+            buffer (the producer side of the SPSCRingBuffer) until 
+            stopReader() is called or the connection goes bad
+        */
+        void readerLoop();
+
+        /*what fillBuffer() does instead of recv() when the reader 
+            thread is running: sleeps on readerWake (up to POLLTIMER)
+            until the reader pushed at least needed bytes
+
+            returns 1 once there is enough
+            returns POLLTIMEDOUT or whatever error the reader hit
+        */
+        int waitForBuffer(size_t needed);
+
+        uring::Transport transport;         // open after useUring(), then every
+                                            // recv()/sendmsg() goes through it
+
+    public:
+        /* This constructor is just makes everything empty
+            and sets fd to be bad (-1)
+        */
+        BasicClient();
+
+        /* Same as above, but picks which kind of ring buffer
+            holds the received bytes (made in connectIt()):
+            - ringbuffer::STANDARD  -> RingBufferS
+            - ringbuffer::MIRRORED  -> MirroredRingBuffer, so a 
+                                        buffered packet is always
+                                        one contiguous piece
+        */
+        BasicClient(ringbuffer::RingType ringType);
+                                                            // the size in case
+        //Removed copy constructor because Client should not be copied
+        BasicClient(const BasicClient&) = delete;
+        BasicClient& operator=(const BasicClient&) = delete;
+                                                            // read too much in one read
+
+        /* The destructor disconnects the client if it is still 
+            connected
+        */
+        ~BasicClient();
+
+        /* given a socket, it accesses its members (Client
+            is a friend class) to connect to an actual 
+            client that is trying to connect to the socket
+
+            also prepares buffer to a certain size as to get ready
+            for read
+
+            returns 1 on success
+
+            there will be a timer to connect so that 
+            we can occasionally get an error message 
+            if the wait is too long, 
+            as opposed to waiting infinitely, and then
+            figuring that after some waiting, something 
+            is wrong and then force quitting
+
+            A POLLTIMEDOUT will be returned when it times out
+
+            Things that can happen to get negative poll
+             - ?
+            so return UNKNOWNPOLLRESULT
+        */
+        int connectIt(Socket& s);
+
+        /*same as above, but for an fd that was already accept()-ed 
+        somewhere else (like Reactor::watchSocket()), the Client 
+        takes it over and closes it in closeIt()
+
+        returns 1 on success
+        returns NOTOPENED if fd is -1
+        */
+        int connectIt(int fd);
+
+        /*receives a message from the client, expected message packet is 1 Megabyte:
+            3 bytes                     - size of message
+            13 bytes                    - the username
+            1,048,560 (1Megabyte - 16)  - the remaining message
+        
+        getPacket has a poll() and is willing to wait
+        POLLTIMER seconds before returning a POLLTIMEDOUT
+        (the bytes received so far stay in the buffer, so calling
+        getPacket again picks up where it left off)
+
+        the header is read in place from the buffer and the message
+        is copied out of the buffer once
+
+        if the size in the header is bigger than a packet can hold,
+            returns MSGTOOBIG. There's no telling where the next packet
+            starts after that, so from then on every getPacket flavour
+            returns BADRECV (until connectIt() again)
+
+        throws a runtime_exception error if fd is bad
+        */
+        int getPacket(std::string& id, std::string& message);
+
+        /*same as above, but the id comes back as a FrameId 
+        (straight out of the header, no string made for it)*/
+        int getPacket(framing::FrameId& id, std::string& message);
+
+        /*same as above, but message is replaced with a buffer from
+        this Client's pool (see getPool()), which goes back to the pool
+        when the handle is destroyed, so a steady stream of packets
+        keeps reusing the same few buffers instead of allocating*/
+        int getPacket(framing::FrameId& id, bufferpool::PooledBuffer& message);
+
+        /*receives as many packets as are available, up to max, 
+            and appends them to out
+
+        if the buffer doesn't hold a complete packet yet, it waits 
+        like getPacket (one readv() takes in everything that's 
+        there), then takes out every packet that is complete without
+        any more poll() or recv() calls
+
+        returns how many packets were added to out
+        returns the same errors as getPacket if nothing was received
+        (an error after some packets were received is returned on 
+        the next call, a MSGTOOBIG comes back as BADRECV then)
+
+        except BADCOMPRESSION: the packet that didn't inflate is 
+        already gone, so it's returned right away, even if packets
+        were added to out before it (they stay there, so compare
+        out.size() to what it was before the call to count them)
+
+        throws a runtime_exception error if fd is bad
+        */
+        int getPackets(std::vector<Frame>& out, size_t max);
+
+        /*same as above, with the messages in buffers from the pool*/
+        int getPackets(std::vector<PooledFrame>& out, size_t max);
+
+        /*the pool the PooledBuffer overloads take their buffers from
+        (getReused()/getAllocated() tell how well it's doing)*/
+        bufferpool::BufferPool& getPool();
+
+        /*receives a packet like getPacket, but instead of collecting 
+        the message into a string, hands every piece of it to onChunk
+        as soon as it is received (in order, the spans are only good
+        during the call), so a big message can be hashed, forwarded
+        or written out without ever holding all of it
+
+        id is filled in before the message starts
+
+        if it returns an error partway through the message (like a 
+        POLLTIMEDOUT), calling it again carries on with the same 
+        message, and until it finishes getPacket and getPackets 
+        return MIDSTREAM
+
+        if onChunk throws, the exception comes out of here and the
+        chunk it was handed counts as delivered: calling again carries
+        on right after it (a compressed message is skipped to its end
+        then, and that call returns BADCOMPRESSION)
+
+        returns 1 once the whole message went through onChunk
+        returns the same errors as getPacket
+
+        throws a runtime_exception error if fd is bad
+        */
+        int getPacketStream(std::string& id, 
+                            const std::function<void(std::span<const char>)>& onChunk);
+
+        /*receives a packet like getPacket, but NEVER waits: 
+        decodes whatever is buffered, does at most one recv() 
+        (MSG_DONTWAIT) and returns
+
+        the decoder remembers how far into the packet it got 
+        (AWAITSIZE, AWAITID or AWAITBODY), so nothing is lost and 
+        the next call picks up from there. Call it whenever 
+        poll()/epoll() says getFd() is readable, so one thread can
+        look after a lot of clients
+
+        returns 1 with id and message filled in
+        returns 0 if the packet isn't all here yet (need more)
+        returns MSGTOOBIG, BADRECV or READCLOSE like getPacket
+        (after a MSGTOOBIG every call returns BADRECV, and until a 
+        started packet is finished, getPacket, getPackets and 
+        getPacketStream return MIDSTREAM)
+
+        throws a runtime_exception error if fd is bad
+        */
+        int tryGetPacket(std::string& id, std::string& message);
+
+        /*whether the last tryGetPacket() that returned 0 did so
+        because the socket had nothing left (recv() said EAGAIN)
+        rather than because it stopped after its one recv()
+
+        with edge-triggered epoll (Reactor) there is no second event
+        for bytes that are already waiting, so keep calling 
+        tryGetPacket() until this is true*/
+        bool isDrained();
+
+        /*the socket's file descriptor (-1 if not connected), to hand
+        to poll()/epoll() when driving tryGetPacket()*/
+        int getFd();
+
+        /*sends a message from the client, expected message packet is 1 Megabyte:
+            3 bytes                     - size of message
+            13 bytes                    - the username
+            1,048,560 (1Megabyte - 16)  - the remaining message
+
+        sendPacket has a poll(), and is willing to wait
+        POLLTIMER seconds before returning a POLLTIMEDOUT
+
+        the header and the message go out together with writev(),
+        so message is never copied into a packet first (a partial 
+        write picks up where it left off)
+
+        throws a runtime_exception error if fd is bad
+        
+        if message is too big, returns MSGTOOBIG
+        */
+        int sendPacket(const std::string& id, 
+                        const std::string& message);
+
+        /*same as above, but the id is already a FrameId, so the header
+        is the size plus one copy of its padded bytes*/
+        int sendPacket(const framing::FrameId& id, 
+                        const std::string& message);
+
+        /*sends a lot of packets at once (same format as sendPacket)
+
+        the headers are built on the stack and up to MAXSENDBATCH
+        packets at a time go to a single sendmsg(), with MSG_MORE
+        on everything but the last batch, so a fan out of many small
+        packets becomes a few full segments instead of one syscall
+        (and maybe one segment) per packet
+
+        every frame is checked before anything is sent, so a bad one
+        returns MSGTOOBIG or IDTOOBIG without sending any of them
+
+        returns 1 on success
+        returns POLLTIMEDOUT, BADSEND or SENDCLOSE like sendPacket
+
+        throws a runtime_exception error if fd is bad
+        */
+        int sendPackets(std::span<const OutFrame> frames);
+
+        /*sends a packet whose message is length bytes of fileFd
+        starting at offset (same format as sendPacket)
+
+        the header goes out first (with MSG_MORE) and then the body
+        goes straight from the file to the socket with sendfile(),
+        so it never gets read into a string
+
+        fileFd's own offset is left alone
+
+        if length is too big, returns MSGTOOBIG
+        if fileFd can't be used or doesn't hold offset + length bytes,
+            returns BADFILE before anything is sent
+        returns POLLTIMEDOUT, BADSEND or SENDCLOSE like sendPacket
+
+        throws a runtime_exception error if fd is bad
+        */
+        int sendFilePacket(const std::string& id, int fileFd,
+                            off_t offset, size_t length);
+
+        /*how many poll()/sendmsg() calls sending has made so far
+        (to see what batching saves)*/
+        uint64_t getSendCalls();
+
+        /*turns on compression for sendPacket(): a message of at least
+        threshold bytes is run through zlib at level (Z_BEST_SPEED = 1
+        up to Z_BEST_COMPRESSION = 9) and, if that made it smaller, is
+        sent with the compressed flag (the top bit of the size bytes)
+        set, otherwise it goes out as is
+
+        the peer has to know about the flag, so it's off (threshold 0)
+        until this is called. sendPackets() and sendFilePacket() always
+        send raw
+
+        receiving doesn't need this, every getPacket flavour inflates 
+        a flagged message on its own (returns BADCOMPRESSION if it
+        doesn't inflate to what it says)
+        */
+        void setCompression(size_t threshold, int level = Z_BEST_SPEED);
+
+        /*Starts a thread that does all the recv() calls for this 
+        client and pushes into the buffer, so getPacket() on the
+        calling thread only drains complete packets from it (no locks,
+        the buffer is the single-producer/single-consumer ring; a side
+        that has to wait for the other sleeps on a condition variable
+        instead of spinning)
+
+        the Client has to be made with ringbuffer::SPSC and be connected
+            otherwise returns BADRINGTYPE or NOTOPENED
+
+        calling it again while the reader runs does nothing (one that
+        stopped on its own, after READCLOSE or BADRECV, is joined and
+        a new one is started)
+
+        returns 1 on success
+        */
+        int startReader();
+
+        /*Stops and joins the reader thread (if there is one)
+        returns 1
+        */
+        int stopReader();
+
+        /*Moves this connection onto io_uring: from now on the kernel
+        keeps receiving into bufferCount (a power of two) buffers of
+        bufferSize bytes on its own (one multishot recv), and sends go
+        through the same ring, so getPacket() doesn't poll() anymore
+        and takes bytes out of memory the kernel already filled
+
+        for the busiest connections, where poll() + recv() and send()
+        per packet is most of the cost. Everything else (getPacket,
+        sendPacket, tryGetPacket, ...) works the same
+
+        don't use it together with a Reactor (readiness of the fd says
+        nothing once the kernel takes the bytes straight off it) or
+        the reader thread
+
+        returns 1 on success
+        returns NOTOPENED if not connected
+        returns BADRINGTYPE if the reader thread is running
+        returns NOURING if io_uring isn't there (kernel too old, or
+            built without it), the Client keeps using poll()
+        */
+        int useUring(unsigned bufferCount = URINGBUFFERS, size_t bufferSize = URINGBUFFERSIZE);
+
+        /*if useUring() is on for this connection*/
+        bool usingUring();
+
+        /*If the buffer grew past INITIALBUFFERSIZE, but no packet 
+        has needed that room for the idle shrink time (and what is 
+        buffered still fits), shrinks it back to INITIALBUFFERSIZE
+
+        getPacket() calls this on its own, but something that 
+        manages a lot of clients can call it on quiet ones too
+
+        returns 1 if it shrank, 0 if it didn't need to
+        */
+        int shrinkIfIdle();
+
+        /*sets how long the buffer has to go without a big packet
+        before shrinkIfIdle() shrinks it (default IDLESHRINKTIMER ms)*/
+        void setIdleShrinkTime(std::chrono::milliseconds idleTime);
+
+        /*how many bytes of memory the receive buffer takes right now
+        (what this connection adds to the process RSS)
+        0 when not connected*/
+        size_t getBufferMemory();
+
+        /*Closes the client socket
+        (Similar to the destructor)
+        */
+        int closeIt();
+
+};
+
+/*the Client everything uses (3 byte size + 13 byte id)*/
+using Client = BasicClient<framing::DefaultCodec>;
+
+/*a Client with a 4 byte size, for messages up to 2 Megabytes*/
+using WideClient = BasicClient<framing::WideCodec>;
+
+/* A class that acts as a container for variables related to 
+the socket created on the system. 
+ - Assumes the ip address is self (127.0.0.1)
+
+these variables include:
+- addrinfo
+- sockaddr structs 
+- pollfd for polling
+
+it also separates the low level socket operations 
+such as "getaddrinfo" and "socket->bind->listen->accept"
+
+from calls
+such as "open socket" and "connect to client" */
+class Socket{
+    private:
+        struct addrinfo hints;              //helper for servinfo (when calling getaddrinfo)
+        struct addrinfo* servinfo;          //the result of calling getaddrinfo
+
+        struct pollfd socketfd[1];           //contains socketfd but also used for polling
+//deprecated
+        //struct pollfd clientfd[];           //contains fd for client socket but also for polling
+
+        int port;                           //port number this socket is connected to
+                                            //-1 if not connected
+
+/*>>>DEPRECATED<<<*/
+        /*implemented by Min: 
+            ->  https://github.com/MiniMinja/CircularBuffer
+        */
+        //RingBufferS localBuffer;            //This is the buffer that handles the queueing of 
+                                            //incoming messages (multiple message are contiguous
+                                            //and it's possible to have mixed messages from a 
+                                            //single packet)
+
+    public:
+        /*initializes a socket to all zeros, 
+            assuming that all setting happens at the open*/
+        Socket();
+        
+        //Removed copy constructor because Socket should not be copied
+        Socket(const Socket&) = delete;
+        Socket& operator=(const Socket&) = delete;
+
+        //specified functions
+        /*keeps a socket open in NONblocking mode for listening at port
+            and keeps track of that port in the member value
+            returns 1 if port open was sucessful
+            if port is not valid, return INVALIDPORT error
+            if openIt is called again without a close, 
+            return ALREADYOPEN error*/
+        int openIt(int port);
+        /*same as above, but backlog is how many connections can wait
+            to be accepted before new ones get dropped (openIt(port)
+            uses SOMAXCONN, the kernel caps it at that anyway)*/
+        int openIt(int port, int backlog);
+        /*same as above, reusePort -> SO_REUSEPORT, so more Sockets
+            (each opened with reusePort) can listen on the same port
+            and the kernel spreads new connections across them*/
+        int openIt(int port, int backlog, bool reusePort);
+        /*closes the opened socket
+            close should generally work 
+            even if the socket will never opened to begin with*/
+        int closeIt();
+        /*returns the port value this object is connected to
+            (note that the port value is -1 if it is not 
+            connected to anything) */
+        int getPort();
+        /*returns the socket file descriptor id
+            if the socket isn't connected, returns -1*/
+        int getSocketFD();
+        /*accepts ONE waiting connection with accept4(), already
+            non-blocking and close-on-exec, without waiting for it
+            (call it until it returns 0 to take every waiting one)
+            returns 1 with clientFd set
+            returns 0 if nobody is waiting
+            returns NOTOPENED if the socket isn't open
+            returns BADACCEPT if accept4() fails (like out of fds)*/
+        int acceptIt(int& clientFd);
+
+        template<typename Codec>
+        friend class BasicClient;
+
+//>>>>>>>>>>>>>>>DEPRECATED<<<<<<<<<<<<<<<<<<<<<
+// The client functions are deprecated and will be moved to the client class
+        /*essentially calls accept on incoming connect requests
+        and then verifies with ping call 
+            if not trusted client, will return the NOTTRUSTWORTHY error
+            if something else bad happend, will return appropriate error code */
+        //int getTrustedClient();
+        /*sends the whole message to the client (hides the loop that keeps
+            calling send() to send the whole message)
+            if socket disconnected, will return appropriate error
+            if whole message not send because of other reasons, 
+                will return INCOMPLETESEND error
+            */
+        //int sendToClient(const std::string msg);
+        /*receives a message from the client, expected message packet is 1 Megabyte:
+            3 bytes                     - size of message
+            13 bytes                    - the username
+            1,048,560 (1Megabyte - 16)  - the remaining message
+            
+            If the promised message isn't received (< 16 bytes or < size of message)
+                this will wait upon this message for up to <sharedstuff:MAXWAITSECS>
+                in which once the time has run out, the whole message will be dropped
+            If we havent received the full message but socket disconnects
+                this will also drop everything in the buffer
+            */
+        //std::string readFromClient();
+        /* closes the client, but does not close the socket 
+            also returns some error code, though a close should
+            still happen despite some wierd shenanigans*/
+        //int closeClient();
+
+
+};
+
+/*This is the convenient interface that provides ways to send and receive 
+messages from services that connect to this server via the port 
+
+In the most biggest, general, and simplest terms:
+
+1. Creates a port available to connect and awaits a client to connect
+2. If a client is connected, it alternates between two states:
+    IDLE: essentially does nothing on its own (except maybe send PING to
+        verify the connection) and awaits for something to tell it to
+        send something over the network
+    BUSY: the job got told to send something over the network, so it 
+        hangs and keeps waiting until the client sends a response. Once
+        the response is received from the client, this goes back to the 
+        IDLE state
+
+The queries come from input(), which any number of threads can call
+at the same time. They only go into a lock-free queue (msgQueue), and 
+job() takes them out in batches of up to MAXJOBBATCH, so callers don't
+have to wait for the previous query to be answered. Every response is
+kept (with the query's id) until getOutputs() picks it up.
+
+This can be viewed like a fsa state:
+
+         (client connected)                                 
+OPEN ---------------------->IDLE---->---->-----+
+                             ^                 |
+                             |                 | (get a query)  
+           (got a response)  |                 |
+                             |                 |
+                           BUSY<----<----<-----+
+
+
+In reality, this is achieved by means of a (almost over-abstractified)
+semaphore. There isn't really a variable, but instead a function call
+will restart the function (thus restarting the while loop) 
+while any hanging states will return (or exit) the function
+(thus pause the while loop) 
+*/
+class Connection : public fsa::FSA{ // inheritence to enforce
+                                    // the idea of FSA (what is this
+                                    //at its core)
+private:
+    history::History record;
+
+    ringbuffer::MPSCQueue<std::pair<framing::FrameId, std::string>> msgQueue;
+    std::vector<std::pair<framing::FrameId, std::string>> batch;    // what job() is working on
+    std::string response;               // what sendQuery() fills in for job()
+
+    Socket s;
+    Client c;
+
+    std::string lastOutput;
+    std::vector<Frame> outputs;         // every response since getOutputs()
+    std::mutex outputLock;              // for both, job() may be on another thread
+
+protected:
+    /*The implementation details of job are listed above
+    */
+    void job() override;
+
+public:
+    Connection();
+
+    /* this simple connects to a socket
+    */
+    void start() override;
+    /* The format of the input for Connection is 2 parts:
+        - ID
+        - MESSAGE
+    This gets added to the msgQueue as a pair which is the 
+    two data listed above (safe to call from many threads at once)
+
+    This input does NOT block: if the queue is full it 
+    returns QUEUEFULL (use enqueue() to wait instead)
+
+    if the size of the vector is not 2, 
+        let the user know it's an invalid size
+    if the size of the id is greater than 13
+    if the size of the second argument is bigger than a Megabyte
+        and return BADINPUTERROR 
+    */
+    int input(std::vector<std::string>& args) override;
+
+    /* Same checks as input(), but takes the ID and MESSAGE directly
+    and lets the caller pick what happens when the queue is full:
+        - wait = false -> return QUEUEFULL right away
+        - wait = true  -> block until job() makes room
+    
+    returns 1 once the query is queued
+    */
+    int enqueue(const std::string& id, const std::string& message, bool wait);
+
+    /*how many queries are waiting for job() right now*/
+    size_t getQueueDepth();
+    /*This disconnects to a socket
+    */
+    void exit() override;
+
+    /*This function does get the last output
+    but if no output was outputted last, it will
+    return ">@EMPTY@<"
+
+    (one job() can answer up to MAXJOBBATCH queries, this is only
+    the last of them, use getOutputs() to get every one)
+    */
+    std::string getLastOutput();
+
+    /*moves every response job() got since the last call into out
+    (appended, oldest first), each with the id of the query it
+    answers. Queries that got no response aren't in it
+
+    they're kept until this is called, so call it now and then
+    returns how many were added*/
+    size_t getOutputs(std::vector<Frame>& out);
+
+    /*a copy of what the Connection wrote down (safe while input()
+    is being called from other threads)*/
+    std::list<std::string> getRecord();
+};
+
+//These are the functions the Connection does
+//and these are pulled out to enforce SRP
+
+/*Tries to connect to a valid socket and client
+returns 1 on connect
+
+raises an error on unable to connect
+*/
+int connectClient(Socket& s, Client& c, history::History& record);
+
+
+/*sends query to this job. 
+
+Then it calls poll to see if a response is given
+and puts the response's message into response
+
+returns 1 on successful send and response
+
+return SENDERROR when unable to send
+return -1 when the response is nothing
+*/
+int sendQuery(const framing::FrameId& id, 
+                const std::string& query,  
+                Client& c, 
+                history::History& record,
+                std::string& response);
+
+/*Not sure if this function is needed
+but this sends "PING" and waits for "PONG"
+
+a difference response or a too long of a wait response
+leads to a disconnect
+
+returns 1 on successful send and response
+
+returns SENDERROR when unable to send
+returns -1 when the response is no PONG
+*/
+int verifyConnection(Client& c, history::History& record);
+
+}
+
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace tasks{
+
+/*what every Task's promise has, whatever it gives back*/
+struct PromiseBase{
+    std::coroutine_handle<> continuation;   // whoever co_awaits it
+    std::exception_ptr error;
+    bool detached = false;                  // spawn()-ed, nobody waits for it
+
+    /*at the end, goes straight on to whoever co_awaited the task
+    (no trip back through the caller's stack), or frees a spawn()-ed
+    one since nothing else holds it*/
+    struct FinalAwaiter{
+        inline bool await_ready() noexcept{
+            return false;
+        }
+
+        template<typename Promise>
+        inline std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept{
+            PromiseBase& promise = self.promise();
+            if(promise.detached){
+                if(promise.error){
+                    //nobody is there to catch it
+                    std::terminate();
+                }
+                self.destroy();
+                return std::noop_coroutine();
+            }
+            if(promise.continuation){
+                return promise.continuation;
+            }
+            return std::noop_coroutine();
+        }
+
+        inline void await_resume() noexcept{}
+    };
+
+    inline std::suspend_always initial_suspend() noexcept{
+        return {};
+    }
+
+    inline FinalAwaiter final_suspend() noexcept{
+        return {};
+    }
+
+    inline void unhandled_exception() noexcept{
+        error = std::current_exception();
+    }
+};
+
+/*keeps what a Task<T> co_return-ed until it's picked up*/
+template<typename T>
+struct Promise : PromiseBase{
+    std::optional<T> value;
+
+    template<typename U>
+    inline void return_value(U&& result){
+        value.emplace(std::forward<U>(result));
+    }
+
+    inline T take(){
+        if(error){
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template<>
+struct Promise<void> : PromiseBase{
+    inline void return_void() noexcept{}
+
+    inline void take(){
+        if(error){
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+template<typename T>
+class Task;
+
+/*starts task and lets it run on its own (it frees itself when it's
+done), for the top of a conversation that nobody co_awaits
+
+if it throws, std::terminate() is called*/
+inline void spawn(Task<void> task);
+
+/*A coroutine that gives back a T (or nothing) to whoever co_awaits it
+
+it's lazy: nothing runs until it's co_await-ed (or spawn()-ed), and
+then it runs on the thread that resumed it, up to its first
+suspension. When it finishes, the one that co_awaited it carries on
+right away. An exception it throws comes out of the co_await
+
+only one owner (move-only), and a Task that's destroyed before it
+finished destroys the coroutine with it
+*/
+template<typename T = void>
+class Task{
+    public:
+        struct promise_type : Promise<T>{
+            inline Task get_return_object() noexcept{
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        inline explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle(handle){}
+
+        friend void spawn(Task<void> task);
+
+    public:
+        inline Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)){}
+
+        inline Task& operator=(Task&& other) noexcept{
+            if(this != &other){
+                if(handle){
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        //Removed copy constructor because only one can own the coroutine
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        inline ~Task(){
+            if(handle){
+                handle.destroy();
+            }
+        }
+
+        /*whether it ran to the end*/
+        inline bool isDone(){
+            return handle && handle.done();
+        }
+
+        /*starts it (or carries on with its result if it's already done)*/
+        inline auto operator co_await() noexcept{
+            struct Awaiter{
+                std::coroutine_handle<promise_type> handle;
+
+                inline bool await_ready() noexcept{
+                    return handle.done();
+                }
+
+                inline std::coroutine_handle<> await_suspend(std::coroutine_handle<> waiting) noexcept{
+                    handle.promise().continuation = waiting;
+                    return handle;
+                }
+
+                inline T await_resume(){
+                    return handle.promise().take();
+                }
+            };
+            return Awaiter{handle};
+        }
+};
+
+inline void spawn(Task<void> task){
+    std::coroutine_handle<Task<void>::promise_type> handle = std::exchange(task.handle, nullptr);
+    if(!handle){
+        return;
+    }
+    handle.promise().detached = true;
+    handle.resume();
+}
+
+}
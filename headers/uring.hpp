@@ -0,0 +1,530 @@
+#pragma once
+
+//only built in when the kernel headers know about multishot recv
+// (Linux 6.0), otherwise Transport is a stub whose open() says so
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#endif
+
+#include <sys/types.h>
+#include <sys/socket.h>     // For msghdr
+#include <sys/mman.h>       // For mmap (the rings are shared with the kernel)
+#include <sys/syscall.h>    // For the io_uring syscalls
+#include <unistd.h>
+
+#include <atomic>
+#include <deque>
+#include <span>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+namespace uring{
+    enum{
+        NOTSUPPORTED                    = -10,
+        SETUPFAILED                     = -11
+    };
+
+#if defined(IORING_RECV_MULTISHOT)
+    constexpr bool SUPPORTED = true;
+
+    /*One socket's io_uring: a multishot recv that keeps filling
+    buffers the kernel was given up front (a provided buffer ring),
+    and sendmsg() calls that go through the same ring
+
+    While it's open nothing is poll()-ed: received bytes show up as
+    completions in memory shared with the kernel, so taking them out
+    is usually no syscall at all, and a send is one io_uring_enter()
+    that also picks up whatever was received meanwhile
+
+    Talks to the kernel straight through the syscalls (io_uring_setup,
+    io_uring_enter, io_uring_register), it doesn't need liburing
+
+    only one thread may use it at a time
+    */
+    class Transport{
+    private:
+        static constexpr uint64_t RECVTAG = 1;
+        static constexpr uint64_t SENDTAG = 2;
+        static constexpr uint64_t CANCELTAG = 3;
+        static constexpr uint16_t BUFFERGROUP = 0;
+        static constexpr unsigned ENTRIES = 16;
+
+        int ringFd;
+        int socketFd;
+
+        //the submission and completion rings (one mmap)
+        void* rings;
+        size_t ringsSize;
+        unsigned* sqHead;
+        unsigned* sqTail;
+        unsigned sqMask;
+        unsigned sqEntries;
+        struct io_uring_sqe* sqes;
+        size_t sqesSize;
+        unsigned* cqHead;
+        unsigned* cqTail;
+        unsigned cqMask;
+        struct io_uring_cqe* cqes;
+        unsigned localTail;                 // sqes handed out so far
+
+        //the provided buffers the multishot recv fills
+        //(the ring is kept as plain io_uring_bufs, in C++ the flexible
+        // array of io_uring_buf_ring doesn't start at offset 0)
+        struct io_uring_buf* bufRing;
+        size_t bufRingSize;
+        char* bufMemory;
+        size_t bufMemorySize;
+        unsigned bufCount;
+        size_t bufSize;
+        uint16_t bufTail;
+
+        //buffers that were filled but not copied out (all the way) yet
+        struct Pending{
+            uint16_t bid;
+            size_t offset;
+            size_t length;
+        };
+        std::deque<Pending> pending;
+        bool armed;                         // the multishot recv is still going
+        bool eof;
+        int error;                          // errno of a failed recv (0 if none)
+
+        bool sendDone;
+        int sendResult;
+
+        uint64_t enterCalls;
+
+        /*the next free sqe (zeroed), or nullptr if they're all waiting
+        to be submitted*/
+        inline struct io_uring_sqe* getSqe(){
+            unsigned head = std::atomic_ref<unsigned>(*sqHead).load(std::memory_order_acquire);
+            if(localTail - head >= sqEntries){
+                return nullptr;
+            }
+            struct io_uring_sqe* sqe = &sqes[localTail & sqMask];
+            std::memset(sqe, 0, sizeof(*sqe));
+            localTail++;
+            return sqe;
+        }
+
+        /*like getSqe(), but submits what's waiting first if it has to*/
+        inline struct io_uring_sqe* nextSqe(){
+            struct io_uring_sqe* sqe = getSqe();
+            if(sqe == nullptr){
+                enter(0, 0);
+                sqe = getSqe();
+            }
+            return sqe;
+        }
+
+        /*hands every new sqe to the kernel and (if waitFor > 0) waits
+        up to timeoutMs (-1 forever) for that many completions
+
+        getEvents -> go into the kernel even with nothing to submit or
+                    wait for, the recv's completions are only posted
+                    once this thread makes a syscall
+
+        returns what io_uring_enter() returned (-errno on failure)*/
+        inline int enter(unsigned waitFor, int timeoutMs, bool getEvents = false){
+            std::atomic_ref<unsigned>(*sqTail).store(localTail, std::memory_order_release);
+            unsigned toSubmit = localTail - std::atomic_ref<unsigned>(*sqHead).load(std::memory_order_acquire);
+            if(toSubmit == 0 && waitFor == 0 && !getEvents){
+                return 0;
+            }
+
+            unsigned flags = 0;
+            struct __kernel_timespec timeout = {};
+            struct io_uring_getevents_arg arg = {};
+            void* argPointer = nullptr;
+            size_t argSize = 0;
+            if(getEvents){
+                flags |= IORING_ENTER_GETEVENTS;
+            }
+            if(waitFor > 0){
+                flags |= IORING_ENTER_GETEVENTS;
+                if(timeoutMs >= 0){
+                    timeout.tv_sec = timeoutMs / 1000;
+                    timeout.tv_nsec = (long long)(timeoutMs % 1000) * 1000000;
+                    arg.ts = (uint64_t)(uintptr_t)&timeout;
+                    flags |= IORING_ENTER_EXT_ARG;
+                    argPointer = &arg;
+                    argSize = sizeof(arg);
+                }
+            }
+            int val = (int)syscall(__NR_io_uring_enter, ringFd, toSubmit, waitFor, flags, argPointer, argSize);
+            enterCalls++;
+            return val < 0 ? -errno : val;
+        }
+
+        /*takes every completion there is (no syscall)*/
+        inline void reap(){
+            unsigned head = *cqHead;
+            unsigned tail = std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire);
+            while(head != tail){
+                struct io_uring_cqe* cqe = &cqes[head & cqMask];
+                if(cqe->user_data == RECVTAG){
+                    if(cqe->res > 0 && (cqe->flags & IORING_CQE_F_BUFFER)){
+                        pending.push_back(Pending{(uint16_t)(cqe->flags >> IORING_CQE_BUFFER_SHIFT),
+                                                    0, (size_t)cqe->res});
+                    }
+                    else if(cqe->res == 0){
+                        eof = true;
+                    }
+                    else if(cqe->res < 0 && cqe->res != -ENOBUFS && cqe->res != -ECANCELED){
+                        //ENOBUFS -> every buffer is waiting to be copied out,
+                        // it's armed again once some are given back
+                        error = -cqe->res;
+                    }
+                    if(!(cqe->flags & IORING_CQE_F_MORE)){
+                        armed = false;
+                    }
+                }
+                else if(cqe->user_data == SENDTAG){
+                    sendDone = true;
+                    sendResult = cqe->res;
+                }
+                head++;
+            }
+            std::atomic_ref<unsigned>(*cqHead).store(head, std::memory_order_release);
+        }
+
+        /*gives buffer bid back to the kernel (publish() makes it see them)*/
+        inline void recycle(uint16_t bid){
+            struct io_uring_buf* buf = &bufRing[bufTail & (bufCount - 1)];
+            buf->addr = (uint64_t)(uintptr_t)(bufMemory + (size_t)bid * bufSize);
+            buf->len = (uint32_t)bufSize;
+            buf->bid = bid;
+            bufTail++;
+        }
+
+        inline void publish(){
+            //the tail sits where the first entry's resv is
+            std::atomic_ref<uint16_t>(bufRing[0].resv).store(bufTail, std::memory_order_release);
+        }
+
+        /*starts (or restarts) the multishot recv*/
+        inline void arm(){
+            struct io_uring_sqe* sqe = nextSqe();
+            sqe->opcode = IORING_OP_RECV;
+            sqe->fd = socketFd;
+            sqe->ioprio = IORING_RECV_MULTISHOT;
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = BUFFERGROUP;
+            sqe->user_data = RECVTAG;
+            armed = true;
+        }
+
+        /*copies as much of pending as fits into pieces, giving back
+        every buffer that's used up*/
+        inline size_t copyPending(std::span<const std::span<char>> pieces){
+            size_t copied = 0;
+            for(const std::span<char>& piece : pieces){
+                size_t used = 0;
+                while(used < piece.size() && !pending.empty()){
+                    Pending& front = pending.front();
+                    size_t amount = std::min(piece.size() - used, front.length - front.offset);
+                    std::memcpy(piece.data() + used, bufMemory + (size_t)front.bid * bufSize + front.offset, amount);
+                    used += amount;
+                    front.offset += amount;
+                    if(front.offset == front.length){
+                        recycle(front.bid);
+                        pending.pop_front();
+                    }
+                }
+                copied += used;
+            }
+            publish();
+            return copied;
+        }
+
+        /*how many ms are left until deadline (-1 if there's no deadline)*/
+        static inline int remainingMs(int timeoutMs, std::chrono::steady_clock::time_point deadline){
+            if(timeoutMs < 0){
+                return -1;
+            }
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            return std::max(0, (int)left.count());
+        }
+
+    public:
+        inline Transport() : ringFd(-1), socketFd(-1), rings(MAP_FAILED), sqes((struct io_uring_sqe*)MAP_FAILED),
+                            localTail(0), bufRing((struct io_uring_buf*)MAP_FAILED), bufMemory((char*)MAP_FAILED),
+                            bufTail(0), armed(false), eof(false), error(0), sendDone(false), sendResult(0),
+                            enterCalls(0){}
+
+        Transport(const Transport&) = delete;
+        Transport& operator=(const Transport&) = delete;
+
+        inline ~Transport(){
+            closeIt();
+        }
+
+        /*sets up the ring for socket fd, with bufferCount (a power of
+        two, at most 32768) buffers of bufferSize bytes for the recv
+
+        returns 1 on success
+        returns SETUPFAILED if the kernel can't do it (too old, or
+            io_uring is turned off)*/
+        inline int open(int fd, unsigned bufferCount, size_t bufferSize){
+            closeIt();
+            if(fd < 0 || bufferCount == 0 || bufferCount > 32768
+                    || (bufferCount & (bufferCount - 1)) != 0 || bufferSize == 0){
+                return SETUPFAILED;
+            }
+
+            struct io_uring_params params = {};
+            ringFd = (int)syscall(__NR_io_uring_setup, ENTRIES, &params);
+            if(ringFd < 0){
+                ringFd = -1;
+                return SETUPFAILED;
+            }
+            //the timeouts need EXT_ARG, and the rings are mapped in one go
+            if(!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_SINGLE_MMAP)){
+                closeIt();
+                return SETUPFAILED;
+            }
+            socketFd = fd;
+
+            size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+            ringsSize = std::max(sqSize, cqSize);
+            rings = mmap(nullptr, ringsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            ringFd, IORING_OFF_SQ_RING);
+            sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+            sqes = (struct io_uring_sqe*)mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                                MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+            if(rings == MAP_FAILED || sqes == MAP_FAILED){
+                closeIt();
+                return SETUPFAILED;
+            }
+            char* base = (char*)rings;
+            sqHead = (unsigned*)(base + params.sq_off.head);
+            sqTail = (unsigned*)(base + params.sq_off.tail);
+            sqMask = *(unsigned*)(base + params.sq_off.ring_mask);
+            sqEntries = params.sq_entries;
+            cqHead = (unsigned*)(base + params.cq_off.head);
+            cqTail = (unsigned*)(base + params.cq_off.tail);
+            cqMask = *(unsigned*)(base + params.cq_off.ring_mask);
+            cqes = (struct io_uring_cqe*)(base + params.cq_off.cqes);
+            //sqe i always sits in slot i, so the array never changes
+            unsigned* sqArray = (unsigned*)(base + params.sq_off.array);
+            for(unsigned i = 0;i<sqEntries;i++){
+                sqArray[i] = i;
+            }
+            localTail = *sqTail;
+
+            bufCount = bufferCount;
+            bufSize = bufferSize;
+            bufRingSize = bufCount * sizeof(struct io_uring_buf);
+            bufRing = (struct io_uring_buf*)mmap(nullptr, bufRingSize, PROT_READ | PROT_WRITE,
+                                                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            bufMemorySize = bufCount * bufSize;
+            bufMemory = (char*)mmap(nullptr, bufMemorySize, PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(bufRing == MAP_FAILED || bufMemory == MAP_FAILED){
+                closeIt();
+                return SETUPFAILED;
+            }
+            struct io_uring_buf_reg reg = {};
+            reg.ring_addr = (uint64_t)(uintptr_t)bufRing;
+            reg.ring_entries = bufCount;
+            reg.bgid = BUFFERGROUP;
+            if(syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0){
+                closeIt();
+                return SETUPFAILED;
+            }
+            bufTail = 0;
+            for(unsigned i = 0;i<bufCount;i++){
+                recycle((uint16_t)i);
+            }
+            publish();
+
+            pending.clear();
+            eof = false;
+            error = 0;
+            arm();
+            if(enter(0, 0) < 0){
+                closeIt();
+                return SETUPFAILED;
+            }
+            return 1;
+        }
+
+        /*cancels the recv and tears the ring down (the socket is left alone)*/
+        inline void closeIt(){
+            if(ringFd != -1 && rings != MAP_FAILED && sqes != MAP_FAILED){
+                //the kernel may still be writing into the buffers, so
+                // wait (a little) for the recv to finish before freeing them
+                if(armed){
+                    struct io_uring_sqe* sqe = nextSqe();
+                    if(sqe != nullptr){
+                        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                        sqe->addr = RECVTAG;
+                        sqe->user_data = CANCELTAG;
+                    }
+                    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+                    while(armed && remainingMs(100, deadline) > 0){
+                        enter(1, remainingMs(100, deadline));
+                        reap();
+                    }
+                }
+            }
+            if(ringFd != -1){
+                close(ringFd);
+                ringFd = -1;
+            }
+            if(rings != MAP_FAILED){
+                munmap(rings, ringsSize);
+                rings = MAP_FAILED;
+            }
+            if(sqes != MAP_FAILED){
+                munmap(sqes, sqesSize);
+                sqes = (struct io_uring_sqe*)MAP_FAILED;
+            }
+            if(bufRing != MAP_FAILED){
+                munmap(bufRing, bufRingSize);
+                bufRing = (struct io_uring_buf*)MAP_FAILED;
+            }
+            if(bufMemory != MAP_FAILED){
+                munmap(bufMemory, bufMemorySize);
+                bufMemory = (char*)MAP_FAILED;
+            }
+            socketFd = -1;
+            armed = false;
+            pending.clear();
+        }
+
+        inline bool isOpen(){
+            return ringFd != -1;
+        }
+
+        /*copies received bytes into pieces (in order), waiting up to
+        timeoutMs (0 -> not at all, -1 -> forever) if there aren't any
+
+        returns how many bytes were copied
+        returns 0 if the other side closed
+        returns -1 with errno set on failure (EAGAIN if timeoutMs is 0
+            and nothing is there, ETIME if timeoutMs ran out)*/
+        inline ssize_t recv(std::span<const std::span<char>> pieces, int timeoutMs){
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeoutMs, 0));
+            while(true){
+                reap();
+                if(!pending.empty()){
+                    return (ssize_t)copyPending(pieces);
+                }
+                if(error != 0){
+                    errno = error;
+                    return -1;
+                }
+                if(eof){
+                    return 0;
+                }
+                if(!armed){
+                    arm();
+                }
+                if(timeoutMs == 0){
+                    enter(0, 0, true);
+                    reap();
+                    if(pending.empty() && !eof && error == 0){
+                        errno = EAGAIN;
+                        return -1;
+                    }
+                    continue;
+                }
+                int left = remainingMs(timeoutMs, deadline);
+                if(left == 0){
+                    errno = ETIME;
+                    return -1;
+                }
+                int val = enter(1, left);
+                if(val < 0 && val != -ETIME && val != -EINTR && val != -EBUSY){
+                    errno = -val;
+                    return -1;
+                }
+            }
+        }
+
+        /*one sendmsg() of msg through the ring (flags like MSG_MORE),
+        waits up to timeoutMs for it (-1 forever)
+
+        returns how many bytes went out (it can be less than all)
+        returns -1 with errno set on failure (ETIME if it ran out of time)*/
+        inline ssize_t send(struct msghdr* msg, int flags, int timeoutMs){
+            struct io_uring_sqe* sqe = nextSqe();
+            if(sqe == nullptr){
+                errno = EBUSY;
+                return -1;
+            }
+            sqe->opcode = IORING_OP_SENDMSG;
+            sqe->fd = socketFd;
+            sqe->addr = (uint64_t)(uintptr_t)msg;
+            sqe->len = 1;
+            sqe->msg_flags = (uint32_t)flags;
+            sqe->user_data = SENDTAG;
+            sendDone = false;
+
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeoutMs, 0));
+            bool cancelled = false;
+            while(!sendDone){
+                int left = cancelled ? -1 : remainingMs(timeoutMs, deadline);
+                if(left == 0){
+                    //msg has to stay good until the kernel lets go of
+                    // it, so cancel and still wait for the completion
+                    struct io_uring_sqe* cancel = nextSqe();
+                    if(cancel != nullptr){
+                        cancel->opcode = IORING_OP_ASYNC_CANCEL;
+                        cancel->addr = SENDTAG;
+                        cancel->user_data = CANCELTAG;
+                    }
+                    cancelled = true;
+                    left = -1;
+                }
+                enter(1, left);
+                reap();
+            }
+            if(sendResult < 0){
+                errno = sendResult == -ECANCELED ? ETIME : -sendResult;
+                return -1;
+            }
+            return sendResult;
+        }
+
+        /*how many io_uring_enter() calls were made (the syscalls this costs)*/
+        inline uint64_t getEnterCalls(){
+            return enterCalls;
+        }
+    };
+
+#else
+    constexpr bool SUPPORTED = false;
+
+    /*the kernel headers here don't have multishot recv, so there's
+    no io_uring backend (open() always returns NOTSUPPORTED)*/
+    class Transport{
+    public:
+        inline int open(int, unsigned, size_t){
+            return NOTSUPPORTED;
+        }
+        inline void closeIt(){}
+        inline bool isOpen(){
+            return false;
+        }
+        inline ssize_t recv(std::span<const std::span<char>>, int){
+            errno = ENOSYS;
+            return -1;
+        }
+        inline ssize_t send(struct msghdr*, int, int){
+            errno = ENOSYS;
+            return -1;
+        }
+        inline uint64_t getEnterCalls(){
+            return 0;
+        }
+    };
+#endif
+}
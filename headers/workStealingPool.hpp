@@ -0,0 +1,213 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+
+namespace executor{
+
+/*A pool of threads for work that shouldn't run on an I/O thread
+(like a slow command handler)
+
+Every worker has its own deque of tasks:
+    - a task submit()-ed from a worker goes on that worker's deque,
+        and the worker takes its own tasks from the back (the newest,
+        still warm in its cache)
+    - a task submit()-ed from anywhere else goes on the deques in
+        turn
+    - a worker with nothing left steals from the front (the oldest)
+        of another worker's deque, starting at a random one, so a
+        worker stuck on one slow task doesn't hold up the ones
+        queued behind it
+
+each deque has its own lock, which only the owner and a thief
+ever fight over. Workers with nothing to do (or steal) sleep until
+something is submitted
+
+a task must not throw (nothing would catch it)
+*/
+class WorkStealingPool{
+private:
+    struct Worker{
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+        std::thread thread;
+        std::minstd_rand random;            // picks who to steal from
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> queued;             // tasks sitting in the deques
+    std::atomic<size_t> nextWorker;         // where the next outside submit() goes
+    std::atomic<uint64_t> executed;
+    std::atomic<uint64_t> steals;
+
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::atomic<size_t> sleepers;
+    std::atomic<bool> stopping;
+
+    //which worker (of which pool) the calling thread is
+    static inline thread_local WorkStealingPool* currentPool = nullptr;
+    static inline thread_local size_t currentIndex = 0;
+
+    /*the newest task of worker index's own deque*/
+    inline bool popLocal(size_t index, std::function<void()>& task){
+        Worker& worker = *workers[index];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        if(worker.tasks.empty()){
+            return false;
+        }
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+        return true;
+    }
+
+    /*the oldest task of any other worker's deque, trying every one
+    of them once (from a random one on)*/
+    inline bool steal(size_t index, std::function<void()>& task){
+        size_t count = workers.size();
+        size_t start = workers[index]->random() % count;
+        for(size_t i = 0;i<count;i++){
+            size_t victim = (start + i) % count;
+            if(victim == index){
+                continue;
+            }
+            Worker& worker = *workers[victim];
+            std::lock_guard<std::mutex> guard(worker.lock);
+            if(!worker.tasks.empty()){
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+                steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline void workerLoop(size_t index){
+        currentPool = this;
+        currentIndex = index;
+        std::function<void()> task;
+        while(true){
+            if(popLocal(index, task) || steal(index, task)){
+                queued.fetch_sub(1);
+                task();
+                task = nullptr;
+                executed.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(sleepLock);
+            //sleepers goes up before queued is looked at, and submit()
+            // does it the other way around, so one of them always
+            // sees the other (no task is left with everyone asleep)
+            sleepers.fetch_add(1);
+            wake.wait(guard, [this]{
+                return queued.load() > 0 || stopping.load();
+            });
+            sleepers.fetch_sub(1);
+            if(stopping.load() && queued.load() == 0){
+                return;
+            }
+        }
+    }
+
+public:
+    /*starts threadCount workers (std::thread::hardware_concurrency()
+    if 0)*/
+    inline WorkStealingPool(size_t threadCount = 0) : queued(0), nextWorker(0), executed(0), steals(0),
+                                                    sleepers(0), stopping(false){
+        if(threadCount == 0){
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for(size_t i = 0;i<threadCount;i++){
+            workers.push_back(std::make_unique<Worker>());
+            workers[i]->random.seed(i + 1);
+        }
+        for(size_t i = 0;i<threadCount;i++){
+            workers[i]->thread = std::thread(&WorkStealingPool::workerLoop, this, i);
+        }
+    }
+
+    //Removed copy constructor because the threads can't be copied
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    inline ~WorkStealingPool(){
+        stop();
+    }
+
+    /*queues task to run on one of the workers
+    returns false (and drops it) if the pool was stopped (one that
+    races with stop() from another thread may be dropped either way)
+
+    a task can still submit() more while the pool is stopping, stop()
+    waits for those too*/
+    inline bool submit(std::function<void()> task){
+        if(stopping.load() && currentPool != this){
+            return false;
+        }
+        size_t index = currentPool == this ? currentIndex
+                        : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+        {
+            Worker& worker = *workers[index];
+            std::lock_guard<std::mutex> guard(worker.lock);
+            worker.tasks.push_back(std::move(task));
+        }
+        queued.fetch_add(1);
+        if(sleepers.load() > 0){
+            //taking the lock makes sure a worker that's about to wait
+            // is waiting by the time it's told
+            { std::lock_guard<std::mutex> guard(sleepLock); }
+            wake.notify_one();
+        }
+        return true;
+    }
+
+    /*runs every task still queued, then joins the workers (submit()
+    doesn't take anything new from the moment this is called)
+    calling it again does nothing*/
+    inline void stop(){
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            if(stopping.exchange(true)){
+                return;
+            }
+        }
+        wake.notify_all();
+        for(std::unique_ptr<Worker>& worker : workers){
+            if(worker->thread.joinable()){
+                worker->thread.join();
+            }
+        }
+    }
+
+    inline size_t getThreadCount(){
+        return workers.size();
+    }
+
+    /*how many tasks ran so far*/
+    inline uint64_t getExecuted(){
+        return executed.load(std::memory_order_relaxed);
+    }
+
+    /*how many of them were stolen from another worker's deque*/
+    inline uint64_t getSteals(){
+        return steals.load(std::memory_order_relaxed);
+    }
+
+    /*how many are waiting to run*/
+    inline size_t getQueued(){
+        return queued.load();
+    }
+};
+
+}
@@ -1,5 +1,5 @@
-#include <iostream>
-
-int main(){
-
+#include <iostream>
+
+int main(){
+
 }
\ No newline at end of file
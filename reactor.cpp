@@ -0,0 +1,199 @@
+#include "reactor.hpp"
+
+socketstuffs::Reactor::Reactor() : dispatching(false), watchCount(0), events(MAXREACTOREVENTS),
+                                    stopping(false), posted(REACTORQUEUESIZE){
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if(epollFd == -1){
+        throw std::runtime_error(std::string("FATAL ERROR: epoll_create1() failed\n") +
+                                    std::strerror(errno) + "\n"
+                                    "Reactor could not be created");
+    }
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(wakeFd == -1){
+        close(epollFd);
+        throw std::runtime_error(std::string("FATAL ERROR: eventfd() failed\n") +
+                                    std::strerror(errno) + "\n"
+                                    "Reactor could not be created");
+    }
+    //the eventfd is the only one without a Watch (data.ptr is null)
+    struct epoll_event wake = {};
+    wake.events = EPOLLIN | EPOLLET;
+    wake.data.ptr = nullptr;
+    if(epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wake) == -1){
+        close(wakeFd);
+        close(epollFd);
+        throw std::runtime_error("FATAL ERROR: the eventfd could not be added to epoll\n"
+                                    "Reactor could not be created");
+    }
+}
+
+socketstuffs::Reactor::~Reactor(){
+    close(wakeFd);
+    close(epollFd);
+}
+
+int socketstuffs::Reactor::add(int fd, uint32_t interest, Handler handler){
+    if(fd < 0){
+        return BADEPOLL;
+    }
+    if((size_t)fd < watches.size() && watches[fd]){
+        return ALREADYWATCHED;
+    }
+    std::unique_ptr<Watch> watch = std::make_unique<Watch>(Watch{fd, true, std::move(handler)});
+
+    struct epoll_event event = {};
+    event.events = (interest & (READABLE | WRITABLE)) | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = watch.get();
+    if(epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1){
+        return BADEPOLL;
+    }
+    if((size_t)fd >= watches.size()){
+        watches.resize(fd + 1);
+    }
+    watches[fd] = std::move(watch);
+    watchCount++;
+    return 1;
+}
+
+int socketstuffs::Reactor::modify(int fd, uint32_t interest){
+    if(fd < 0 || (size_t)fd >= watches.size() || !watches[fd]){
+        return NOTWATCHED;
+    }
+    struct epoll_event event = {};
+    event.events = (interest & (READABLE | WRITABLE)) | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = watches[fd].get();
+    if(epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) == -1){
+        return BADEPOLL;
+    }
+    return 1;
+}
+
+int socketstuffs::Reactor::remove(int fd){
+    if(fd < 0 || (size_t)fd >= watches.size() || !watches[fd]){
+        return NOTWATCHED;
+    }
+    //if the fd was already closed, epoll dropped it on its own
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    watches[fd]->active = false;
+    if(dispatching){
+        retired.push_back(std::move(watches[fd]));
+    }
+    else{
+        watches[fd].reset();
+    }
+    watchCount--;
+    return 1;
+}
+
+int socketstuffs::Reactor::watchSocket(Socket& s, AcceptHandler onAccept){
+    int listenFd = s.getSocketFD();
+    if(listenFd == -1){
+        return NOTOPENED;
+    }
+    return add(listenFd, READABLE, [&s, onAccept](uint32_t){
+        //edge-triggered, so take every connection that's waiting
+        // (on BADACCEPT, like out of fds, the next connection
+        // that comes in tries again)
+        int clientFd;
+        while(s.acceptIt(clientFd) == 1){
+            onAccept(clientFd);
+        }
+    });
+}
+
+int socketstuffs::Reactor::runPosted(){
+    uint64_t count;
+    //only there to wake epoll_wait() up, the count doesn't matter
+    while(read(wakeFd, &count, sizeof(count)) > 0){
+    }
+
+    //only what's there now, a task that posts another one
+    // doesn't keep this going forever
+    int ran = 0;
+    size_t waiting = posted.size();
+    std::function<void()> task;
+    while((size_t)ran < waiting && posted.tryPop(task)){
+        task();
+        ran++;
+    }
+    return ran;
+}
+
+int socketstuffs::Reactor::runOnce(int timeoutMs){
+    int ready = epoll_wait(epollFd, events.data(), events.size(), timeoutMs);
+    if(ready == -1){
+        if(errno == EINTR){
+            return 0;
+        }
+        return BADEPOLL;
+    }
+
+    dispatching = true;
+    int ran = 0;
+    bool woken = false;
+    for(int i = 0;i<ready;i++){
+        Watch* watch = (Watch*)events[i].data.ptr;
+        if(watch == nullptr){
+            woken = true;
+            continue;
+        }
+        //remove()-ed by an earlier handler in this same batch
+        if(!watch->active){
+            continue;
+        }
+        uint32_t happened = events[i].events;
+        if(happened & (EPOLLHUP | EPOLLERR)){
+            //a handler waiting to read or write has to hear about these
+            happened |= READABLE;
+        }
+        watch->handler(happened);
+        ran++;
+    }
+    //posted tasks run even without the wakeup, the eventfd edge
+    // may have come with an earlier epoll_wait()
+    if(woken || posted.size() > 0){
+        ran += runPosted();
+    }
+    dispatching = false;
+    retired.clear();
+    return ran;
+}
+
+int socketstuffs::Reactor::run(){
+    //a stop() from before it got here counts too, it isn't undone
+    while(!stopping.load()){
+        int val = runOnce(-1);
+        if(val < 0){
+            return val;
+        }
+    }
+    //that stop() is used up, the next run() goes until another one
+    stopping.store(false);
+    return 1;
+}
+
+void socketstuffs::Reactor::stop(){
+    stopping.store(true);
+    uint64_t one = 1;
+    //a full eventfd counter still wakes it up, so this can't fail in a way that matters
+    ssize_t val = write(wakeFd, &one, sizeof(one));
+    (void)val;
+}
+
+int socketstuffs::Reactor::post(std::function<void()> task){
+    if(!posted.tryPush(std::move(task))){
+        return QUEUEFULL;
+    }
+    uint64_t one = 1;
+    ssize_t val = write(wakeFd, &one, sizeof(one));
+    (void)val;
+    return 1;
+}
+
+size_t socketstuffs::Reactor::getWatchCount(){
+    return watchCount;
+}
+
+bool socketstuffs::Reactor::isWatched(int fd){
+    return fd >= 0 && (size_t)fd < watches.size() && watches[fd] != nullptr;
+}
@@ -1,144 +1,717 @@
-#include "ring.hpp"
-
-#include <stdexcept>
-#include <iostream>
-
-void ringbuffer::bufferError(std::string msg){
-    std::cout << msg << std::endl;
-    throw std::runtime_error("Quit by error");
-}
-
-ringbuffer::RingBufferS::RingBufferS(){
-    this->maxLength = 0;
-    start = end = -1;
-    currSize = 0;
-}
-
-ringbuffer::RingBufferS::RingBufferS(size_t maxLength){
-    if(maxLength == 0){
-        throw std::invalid_argument("FATAL ERROR: the max length cannot be 0.\n"
-                                    "RingBuffer could not be created");
-    }
-    this->maxLength = maxLength;
-    start = end = 0;
-    data.resize(maxLength, '\0');
-    currSize = 0;
-}
-
-ringbuffer::RingBufferS::RingBufferS(const RingBufferS& other){
-    this->data = std::vector<char>(other.data);
-    this->maxLength = other.maxLength;
-    this->start = other.start;
-    this->end = other.end;
-}
-
-int ringbuffer::RingBufferS::push(const std::string& toAdd, size_t size){
-    if(size > maxLength - currSize){ //a fancier version to account for 
-                                    // overflow error as well
-        return ringbuffer::OUTOFBOUNDS;
-    }
-    //some defensive programming
-    if(end >= maxLength){
-        ringbuffer::bufferError("FATAL ERROR: end variable is out of bounds\n"
-                                "in push() function in RingBufferS in ring.hpp");
-    }
-    for(size_t i = 0;i<size;i++){
-        data[end] = toAdd[i];
-        end++;
-        
-        //loop end if so it goes around
-        if(end >= maxLength){
-            end = 0;
-        }
-    }
-    currSize += size;
-    return 1;
-}
-
-int ringbuffer::RingBufferS::pop(std::string& dest, size_t popAmount){
-    //some defensive programming
-    if(maxLength == 0){
-        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
-                                "in pop() function in RingBufferS in ring.hpp");
-    }
-    if(start >= maxLength){
-        ringbuffer::bufferError("FATAL ERROR: start variable is out of bounds\n"
-                                "in pop() function in RingBufferS in ring.hpp");
-    }
-    //a written out min() function
-    size_t limit = popAmount;
-    bool limitSet = false;
-    if(limit > currSize){
-        limit = currSize;
-        limitSet = true;
-    }
-    for(size_t i = 0;i<limit;i++){
-        dest += data[start];
-        start++;
-
-        //loop the start so it goes around
-        if(start >= maxLength){
-            start = 0;
-        }
-    }
-    if(limitSet){
-        currSize = 0;
-        return OUTOFBOUNDS;
-    }
-    currSize -= popAmount;
-    return 1;
-}
-
-std::string ringbuffer::RingBufferS::getContents(){
-    //some defensive programming
-    if(maxLength == 0){
-        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
-                                "in getContents() function in RingBufferS in ring.hpp");
-    }
-    if(start >= maxLength){
-        ringbuffer::bufferError("FATAL ERROR: start variable is out of bounds\n"
-                                "start: " + std::to_string(start) + " maxLength: " + std::to_string(maxLength) + "\n"
-                                "in getContents() function in RingBufferS in ring.hpp");
-    }
-    if(end >= maxLength){
-        ringbuffer::bufferError("FATAL ERROR: end variable is out of bounds\n"
-                                "end: " + std::to_string(end) + " maxLength: " + std::to_string(maxLength) + "\n"
-                                "in getContents() function in RingBufferS in ring.hpp");
-    }
-    if(currSize > maxLength){
-        ringbuffer::bufferError("FATAL ERROR: currSize variable is larger than maxLength\n"
-                                "currSize: " + std::to_string(currSize) + " maxLength: " + std::to_string(maxLength) + "\n"
-                                "in getContents() function in RingBufferS in ring.hpp");
-    }
-    size_t wrappedIndex = start;
-    if(currSize > maxLength - start){
-        wrappedIndex = currSize - (maxLength - start);
-    }
-    else{
-        wrappedIndex += currSize;
-    }
-    if(wrappedIndex != end){
-        ringbuffer::bufferError("FATAL ERROR: end variable does not match the index calculated to be the actual end\n"
-                                "end: " + std::to_string(end) + " wrappedIndex: " + std::to_string(wrappedIndex) + "\n"
-                                "in getContents() function in RingBufferS in ring.hpp");
-    }
-
-    size_t accessIndex = start;
-    std::string ret = "";
-    for(size_t i = 0;i<currSize;i++){
-        ret += data[accessIndex];
-        accessIndex++;
-        if(accessIndex >= maxLength){
-            accessIndex = 0;
-        }
-    }
-    return ret;
-}
-
-bool ringbuffer::RingBufferS::isEmpty(){
-    return currSize == 0;
-}
-
-size_t ringbuffer::RingBufferS::size(){
-    return currSize;
+#include "ring.hpp"
+
+#include <stdexcept>
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <bit>
+
+#include <sys/mman.h>   // For memfd_create, mmap, munmap
+#include <unistd.h>     // For ftruncate, close, sysconf
+
+void ringbuffer::bufferError(std::string msg){
+    std::cout << msg << std::endl;
+    throw std::runtime_error("Quit by error");
+}
+
+ringbuffer::RingBufferS::RingBufferS(){
+    this->maxLength = 0;
+    start = end = -1;
+    currSize = 0;
+}
+
+ringbuffer::RingBufferS::RingBufferS(size_t maxLength){
+    if(maxLength == 0){
+        throw std::invalid_argument("FATAL ERROR: the max length cannot be 0.\n"
+                                    "RingBuffer could not be created");
+    }
+    this->maxLength = maxLength;
+    start = end = 0;
+    data.resize(maxLength, '\0');
+    currSize = 0;
+}
+
+ringbuffer::RingBufferS::RingBufferS(const RingBufferS& other){
+    this->data = std::vector<char>(other.data);
+    this->maxLength = other.maxLength;
+    this->start = other.start;
+    this->end = other.end;
+    this->currSize = other.currSize;
+}
+
+int ringbuffer::RingBufferS::push(const std::string& toAdd, size_t size){
+    return push(std::span<const char>(toAdd.data(), size));
+}
+
+int ringbuffer::RingBufferS::push(std::span<const char> toAdd){
+    size_t size = toAdd.size();
+    if(size > maxLength - currSize){ //a fancier version to account for 
+                                    // overflow error as well
+        return ringbuffer::OUTOFBOUNDS;
+    }
+    //some defensive programming
+    if(end >= maxLength){
+        ringbuffer::bufferError("FATAL ERROR: end variable is out of bounds\n"
+                                "in push() function in RingBufferS in ring.hpp");
+    }
+    if(size == 0){
+        return 1;
+    }
+    //first segment is from end up to the wrap point,
+    // the second segment (if any) starts back at 0
+    size_t firstPart = std::min(size, maxLength - end);
+    std::memcpy(data.data() + end, toAdd.data(), firstPart);
+    std::memcpy(data.data(), toAdd.data() + firstPart, size - firstPart);
+
+    end += size;
+    //loop end if so it goes around
+    if(end >= maxLength){
+        end -= maxLength;
+    }
+    currSize += size;
+    return 1;
+}
+
+int ringbuffer::RingBufferS::pop(std::string& dest, size_t popAmount){
+    //some defensive programming
+    if(maxLength == 0){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in pop() function in RingBufferS in ring.hpp");
+    }
+    if(start >= maxLength){
+        ringbuffer::bufferError("FATAL ERROR: start variable is out of bounds\n"
+                                "in pop() function in RingBufferS in ring.hpp");
+    }
+    //a written out min() function
+    size_t limit = popAmount;
+    bool limitSet = false;
+    if(limit > currSize){
+        limit = currSize;
+        limitSet = true;
+    }
+    //grow dest once and copy straight into the new tail
+    size_t oldSize = dest.size();
+    dest.resize(oldSize + limit);
+    pop_into(std::span<char>(dest.data() + oldSize, limit));
+
+    if(limitSet){
+        return OUTOFBOUNDS;
+    }
+    return 1;
+}
+
+size_t ringbuffer::RingBufferS::pop_into(std::span<char> dest){
+    //some defensive programming
+    if(maxLength == 0){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in pop_into() function in RingBufferS in ring.hpp");
+    }
+    if(start >= maxLength){
+        ringbuffer::bufferError("FATAL ERROR: start variable is out of bounds\n"
+                                "in pop_into() function in RingBufferS in ring.hpp");
+    }
+    size_t limit = std::min(dest.size(), currSize);
+    if(limit == 0){
+        return 0;
+    }
+    size_t firstPart = std::min(limit, maxLength - start);
+    std::memcpy(dest.data(), data.data() + start, firstPart);
+    std::memcpy(dest.data() + firstPart, data.data(), limit - firstPart);
+
+    start += limit;
+    //loop the start so it goes around
+    if(start >= maxLength){
+        start -= maxLength;
+    }
+    currSize -= limit;
+    return limit;
+}
+
+ringbuffer::Regions ringbuffer::RingBufferS::peek(size_t offset, size_t n){
+    if(n == 0 || offset > currSize || n > currSize - offset){
+        return Regions();
+    }
+    //where the view starts, looped around if needed
+    size_t index = start + offset;
+    if(index >= maxLength){
+        index -= maxLength;
+    }
+    size_t firstPart = std::min(n, maxLength - index);
+    return Regions{std::span<const char>(data.data() + index, firstPart),
+                    std::span<const char>(data.data(), n - firstPart)};
+}
+
+ringbuffer::Regions ringbuffer::RingBufferS::readable_regions(){
+    return peek(0, currSize);
+}
+
+int ringbuffer::RingBufferS::consume(size_t n){
+    //some defensive programming
+    if(maxLength == 0){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in consume() function in RingBufferS in ring.hpp");
+    }
+    bool limitSet = false;
+    if(n > currSize){
+        n = currSize;
+        limitSet = true;
+    }
+    start += n;
+    if(start >= maxLength){
+        start -= maxLength;
+    }
+    currSize -= n;
+
+    if(limitSet){
+        return OUTOFBOUNDS;
+    }
+    return 1;
+}
+
+ringbuffer::WritableRegions ringbuffer::RingBufferS::prepare(size_t n){
+    size_t room = std::min(n, maxLength - currSize);
+    if(room == 0){
+        return WritableRegions();
+    }
+    //some defensive programming
+    if(end >= maxLength){
+        ringbuffer::bufferError("FATAL ERROR: end variable is out of bounds\n"
+                                "in prepare() function in RingBufferS in ring.hpp");
+    }
+    size_t firstPart = std::min(room, maxLength - end);
+    return WritableRegions{std::span<char>(data.data() + end, firstPart),
+                            std::span<char>(data.data(), room - firstPart)};
+}
+
+int ringbuffer::RingBufferS::commit(size_t n){
+    if(n > maxLength - currSize){
+        return ringbuffer::OUTOFBOUNDS;
+    }
+    end += n;
+    if(end >= maxLength){
+        end -= maxLength;
+    }
+    currSize += n;
+    return 1;
+}
+
+std::string ringbuffer::RingBufferS::getContents(){
+    //some defensive programming
+    if(maxLength == 0){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in getContents() function in RingBufferS in ring.hpp");
+    }
+    //the invariants of the ring (only checked in debug builds)
+    if constexpr(CHECKINVARIANTS){
+        if(start >= maxLength){
+            ringbuffer::bufferError("FATAL ERROR: start variable is out of bounds\n"
+                                    "start: " + std::to_string(start) + " maxLength: " + std::to_string(maxLength) + "\n"
+                                    "in getContents() function in RingBufferS in ring.hpp");
+        }
+        if(end >= maxLength){
+            ringbuffer::bufferError("FATAL ERROR: end variable is out of bounds\n"
+                                    "end: " + std::to_string(end) + " maxLength: " + std::to_string(maxLength) + "\n"
+                                    "in getContents() function in RingBufferS in ring.hpp");
+        }
+        if(currSize > maxLength){
+            ringbuffer::bufferError("FATAL ERROR: currSize variable is larger than maxLength\n"
+                                    "currSize: " + std::to_string(currSize) + " maxLength: " + std::to_string(maxLength) + "\n"
+                                    "in getContents() function in RingBufferS in ring.hpp");
+        }
+        size_t wrappedIndex = start;
+        if(currSize >= maxLength - start){
+            wrappedIndex = currSize - (maxLength - start);
+        }
+        else{
+            wrappedIndex += currSize;
+        }
+        if(wrappedIndex != end){
+            ringbuffer::bufferError("FATAL ERROR: end variable does not match the index calculated to be the actual end\n"
+                                    "end: " + std::to_string(end) + " wrappedIndex: " + std::to_string(wrappedIndex) + "\n"
+                                    "in getContents() function in RingBufferS in ring.hpp");
+        }
+    }
+
+    size_t firstPart = std::min(currSize, maxLength - start);
+    std::string ret;
+    ret.reserve(currSize);
+    ret.append(data.data() + start, firstPart);
+    ret.append(data.data(), currSize - firstPart);
+    return ret;
+}
+
+bool ringbuffer::RingBufferS::isEmpty(){
+    return currSize == 0;
+}
+
+size_t ringbuffer::RingBufferS::size(){
+    return currSize;
+}
+
+size_t ringbuffer::RingBufferS::capacity(){
+    return maxLength;
+}
+
+int ringbuffer::RingBufferS::resize(size_t newLength){
+    if(newLength == 0){
+        throw std::invalid_argument("FATAL ERROR: the max length cannot be 0.\n"
+                                    "in resize() function in RingBufferS in ring.hpp");
+    }
+    if(newLength < currSize){
+        return OUTOFBOUNDS;
+    }
+    std::vector<char> newData(newLength, '\0');
+    size_t copied = 0;
+    for(const std::span<const char>& region : readable_regions()){
+        if(!region.empty()){
+            std::memcpy(newData.data() + copied, region.data(), region.size());
+            copied += region.size();
+        }
+    }
+    data.swap(newData);
+    maxLength = newLength;
+    start = 0;
+    end = currSize;
+    if(end >= maxLength){
+        end = 0;
+    }
+    return 1;
+}
+
+/* MirroredRingBuffer stuff */
+ringbuffer::MirroredRingBuffer::MirroredRingBuffer(){
+    data = nullptr;
+    maxLength = 0;
+    start = 0;
+    currSize = 0;
+}
+
+ringbuffer::MirroredRingBuffer::MirroredRingBuffer(size_t maxLength){
+    if(maxLength == 0){
+        throw std::invalid_argument("FATAL ERROR: the max length cannot be 0.\n"
+                                    "MirroredRingBuffer could not be created");
+    }
+    //both mappings have to line up on pages
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    maxLength = (maxLength + pageSize - 1) / pageSize * pageSize;
+
+    int fd = memfd_create("MirroredRingBuffer", MFD_CLOEXEC);
+    if(fd == -1){
+        throw std::runtime_error(std::string("FATAL ERROR: memfd_create() failed: ") + std::strerror(errno) + "\n"
+                                    "MirroredRingBuffer could not be created");
+    }
+    if(ftruncate(fd, maxLength) == -1){
+        close(fd);
+        throw std::runtime_error(std::string("FATAL ERROR: ftruncate() failed: ") + std::strerror(errno) + "\n"
+                                    "MirroredRingBuffer could not be created");
+    }
+
+    //reserve room for both mappings first so nothing else
+    // can take the second half while we map the first
+    void* reserved = mmap(nullptr, maxLength * 2, PROT_NONE, 
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(reserved == MAP_FAILED){
+        close(fd);
+        throw std::runtime_error(std::string("FATAL ERROR: mmap() failed: ") + std::strerror(errno) + "\n"
+                                    "MirroredRingBuffer could not be created");
+    }
+    char* base = (char*)reserved;
+    void* first = mmap(base, maxLength, PROT_READ | PROT_WRITE, 
+                        MAP_SHARED | MAP_FIXED, fd, 0);
+    void* second = mmap(base + maxLength, maxLength, PROT_READ | PROT_WRITE, 
+                        MAP_SHARED | MAP_FIXED, fd, 0);
+    //the mappings keep the memory alive, we don't need the fd anymore
+    close(fd);
+    if(first == MAP_FAILED || second == MAP_FAILED){
+        munmap(base, maxLength * 2);
+        throw std::runtime_error(std::string("FATAL ERROR: mmap() of the mirror failed: ") + std::strerror(errno) + "\n"
+                                    "MirroredRingBuffer could not be created");
+    }
+
+    this->data = base;
+    this->maxLength = maxLength;
+    start = 0;
+    currSize = 0;
+}
+
+ringbuffer::MirroredRingBuffer::MirroredRingBuffer(MirroredRingBuffer&& other){
+    data = std::exchange(other.data, nullptr);
+    maxLength = std::exchange(other.maxLength, 0);
+    start = std::exchange(other.start, 0);
+    currSize = std::exchange(other.currSize, 0);
+}
+
+ringbuffer::MirroredRingBuffer& ringbuffer::MirroredRingBuffer::operator=(MirroredRingBuffer&& other){
+    if(this != &other){
+        unmap();
+        data = std::exchange(other.data, nullptr);
+        maxLength = std::exchange(other.maxLength, 0);
+        start = std::exchange(other.start, 0);
+        currSize = std::exchange(other.currSize, 0);
+    }
+    return *this;
+}
+
+ringbuffer::MirroredRingBuffer::~MirroredRingBuffer(){
+    unmap();
+}
+
+void ringbuffer::MirroredRingBuffer::unmap(){
+    if(data != nullptr){
+        munmap(data, maxLength * 2);
+        data = nullptr;
+    }
+}
+
+int ringbuffer::MirroredRingBuffer::push(const std::string& toAdd, size_t size){
+    return push(std::span<const char>(toAdd.data(), size));
+}
+
+int ringbuffer::MirroredRingBuffer::push(std::span<const char> toAdd){
+    if(toAdd.size() > maxLength - currSize){
+        return ringbuffer::OUTOFBOUNDS;
+    }
+    if(toAdd.empty()){
+        return 1;
+    }
+    //thanks to the mirror, start + currSize is never more than
+    // a full lap away, so this is always one piece
+    std::memcpy(data + start + currSize, toAdd.data(), toAdd.size());
+    currSize += toAdd.size();
+    return 1;
+}
+
+int ringbuffer::MirroredRingBuffer::pop(std::string& dest, size_t popAmount){
+    if(data == nullptr){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in pop() function in MirroredRingBuffer in ring.hpp");
+    }
+    size_t limit = std::min(popAmount, currSize);
+    dest.append(data + start, limit);
+    consume(limit);
+
+    if(limit < popAmount){
+        return OUTOFBOUNDS;
+    }
+    return 1;
+}
+
+size_t ringbuffer::MirroredRingBuffer::pop_into(std::span<char> dest){
+    if(data == nullptr){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in pop_into() function in MirroredRingBuffer in ring.hpp");
+    }
+    size_t limit = std::min(dest.size(), currSize);
+    if(limit == 0){
+        return 0;
+    }
+    std::memcpy(dest.data(), data + start, limit);
+    consume(limit);
+    return limit;
+}
+
+ringbuffer::Regions ringbuffer::MirroredRingBuffer::peek(size_t offset, size_t n){
+    if(n == 0 || offset > currSize || n > currSize - offset){
+        return Regions();
+    }
+    return Regions{std::span<const char>(data + start + offset, n),
+                    std::span<const char>()};
+}
+
+ringbuffer::Regions ringbuffer::MirroredRingBuffer::readable_regions(){
+    return peek(0, currSize);
+}
+
+int ringbuffer::MirroredRingBuffer::consume(size_t n){
+    bool limitSet = false;
+    if(n > currSize){
+        n = currSize;
+        limitSet = true;
+    }
+    start += n;
+    if(start >= maxLength){
+        start -= maxLength;
+    }
+    currSize -= n;
+
+    if(limitSet){
+        return OUTOFBOUNDS;
+    }
+    return 1;
+}
+
+ringbuffer::WritableRegions ringbuffer::MirroredRingBuffer::prepare(size_t n){
+    size_t room = std::min(n, maxLength - currSize);
+    if(room == 0){
+        return WritableRegions();
+    }
+    return WritableRegions{std::span<char>(data + start + currSize, room),
+                            std::span<char>()};
+}
+
+int ringbuffer::MirroredRingBuffer::commit(size_t n){
+    if(n > maxLength - currSize){
+        return ringbuffer::OUTOFBOUNDS;
+    }
+    currSize += n;
+    return 1;
+}
+
+std::string ringbuffer::MirroredRingBuffer::getContents(){
+    if(data == nullptr){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in getContents() function in MirroredRingBuffer in ring.hpp");
+    }
+    if(start >= maxLength || currSize > maxLength){
+        ringbuffer::bufferError("FATAL ERROR: start or currSize is out of bounds\n"
+                                "start: " + std::to_string(start) + " currSize: " + std::to_string(currSize) + 
+                                " maxLength: " + std::to_string(maxLength) + "\n"
+                                "in getContents() function in MirroredRingBuffer in ring.hpp");
+    }
+    return std::string(data + start, currSize);
+}
+
+bool ringbuffer::MirroredRingBuffer::isEmpty(){
+    return currSize == 0;
+}
+
+size_t ringbuffer::MirroredRingBuffer::size(){
+    return currSize;
+}
+
+size_t ringbuffer::MirroredRingBuffer::capacity(){
+    return maxLength;
+}
+
+int ringbuffer::MirroredRingBuffer::resize(size_t newLength){
+    if(newLength < currSize){
+        return OUTOFBOUNDS;
+    }
+    MirroredRingBuffer other(newLength);
+    if(currSize > 0){
+        other.push(std::span<const char>(data + start, currSize));
+    }
+    *this = std::move(other);
+    return 1;
+}
+
+/* SPSCRingBuffer stuff */
+ringbuffer::SPSCRingBuffer::SPSCRingBuffer(){
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+    cachedHead = cachedTail = 0;
+    mask = 0;
+}
+
+ringbuffer::SPSCRingBuffer::SPSCRingBuffer(size_t maxLength){
+    if(maxLength == 0){
+        throw std::invalid_argument("FATAL ERROR: the max length cannot be 0.\n"
+                                    "SPSCRingBuffer could not be created");
+    }
+    size_t capacity = std::bit_ceil(maxLength);
+    data.resize(capacity, '\0');
+    mask = capacity - 1;
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+    cachedHead = cachedTail = 0;
+}
+
+int ringbuffer::SPSCRingBuffer::push(const std::string& toAdd, size_t size){
+    return push(std::span<const char>(toAdd.data(), size));
+}
+
+int ringbuffer::SPSCRingBuffer::push(std::span<const char> toAdd){
+    //producer side: our own tail can be read relaxed
+    size_t currTail = tail.load(std::memory_order_relaxed);
+    size_t size = toAdd.size();
+    if(size > data.size() - (currTail - cachedHead)){
+        //only go look at the real head when the cached one says it's full
+        cachedHead = head.load(std::memory_order_acquire);
+        if(size > data.size() - (currTail - cachedHead)){
+            return ringbuffer::OUTOFBOUNDS;
+        }
+    }
+    if(size == 0){
+        return 1;
+    }
+    size_t index = currTail & mask;
+    size_t firstPart = std::min(size, data.size() - index);
+    std::memcpy(data.data() + index, toAdd.data(), firstPart);
+    std::memcpy(data.data(), toAdd.data() + firstPart, size - firstPart);
+
+    //publish the data to the consumer
+    tail.store(currTail + size, std::memory_order_release);
+    return 1;
+}
+
+size_t ringbuffer::SPSCRingBuffer::readable(){
+    size_t currHead = head.load(std::memory_order_relaxed);
+    size_t ret = cachedTail - currHead;
+    if(ret == 0){
+        cachedTail = tail.load(std::memory_order_acquire);
+        ret = cachedTail - currHead;
+    }
+    return ret;
+}
+
+int ringbuffer::SPSCRingBuffer::pop(std::string& dest, size_t popAmount){
+    if(data.empty()){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in pop() function in SPSCRingBuffer in ring.hpp");
+    }
+    //get the freshest tail since we want as much as possible
+    cachedTail = tail.load(std::memory_order_acquire);
+    size_t limit = std::min(popAmount, readable());
+    size_t oldSize = dest.size();
+    dest.resize(oldSize + limit);
+    pop_into(std::span<char>(dest.data() + oldSize, limit));
+
+    if(limit < popAmount){
+        return OUTOFBOUNDS;
+    }
+    return 1;
+}
+
+size_t ringbuffer::SPSCRingBuffer::pop_into(std::span<char> dest){
+    if(data.empty()){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in pop_into() function in SPSCRingBuffer in ring.hpp");
+    }
+    if(dest.size() > cachedTail - head.load(std::memory_order_relaxed)){
+        cachedTail = tail.load(std::memory_order_acquire);
+    }
+    size_t currHead = head.load(std::memory_order_relaxed);
+    size_t limit = std::min(dest.size(), cachedTail - currHead);
+    if(limit == 0){
+        return 0;
+    }
+    size_t index = currHead & mask;
+    size_t firstPart = std::min(limit, data.size() - index);
+    std::memcpy(dest.data(), data.data() + index, firstPart);
+    std::memcpy(dest.data() + firstPart, data.data(), limit - firstPart);
+
+    //hand the space back to the producer
+    head.store(currHead + limit, std::memory_order_release);
+    return limit;
+}
+
+ringbuffer::Regions ringbuffer::SPSCRingBuffer::peek(size_t offset, size_t n){
+    size_t currHead = head.load(std::memory_order_relaxed);
+    if(offset + n > cachedTail - currHead){
+        cachedTail = tail.load(std::memory_order_acquire);
+    }
+    size_t currSize = cachedTail - currHead;
+    if(n == 0 || offset > currSize || n > currSize - offset){
+        return Regions();
+    }
+    size_t index = (currHead + offset) & mask;
+    size_t firstPart = std::min(n, data.size() - index);
+    return Regions{std::span<const char>(data.data() + index, firstPart),
+                    std::span<const char>(data.data(), n - firstPart)};
+}
+
+ringbuffer::Regions ringbuffer::SPSCRingBuffer::readable_regions(){
+    cachedTail = tail.load(std::memory_order_acquire);
+    return peek(0, cachedTail - head.load(std::memory_order_relaxed));
+}
+
+int ringbuffer::SPSCRingBuffer::consume(size_t n){
+    size_t currHead = head.load(std::memory_order_relaxed);
+    bool limitSet = false;
+    if(n > cachedTail - currHead){
+        cachedTail = tail.load(std::memory_order_acquire);
+        if(n > cachedTail - currHead){
+            n = cachedTail - currHead;
+            limitSet = true;
+        }
+    }
+    head.store(currHead + n, std::memory_order_release);
+
+    if(limitSet){
+        return OUTOFBOUNDS;
+    }
+    return 1;
+}
+
+ringbuffer::WritableRegions ringbuffer::SPSCRingBuffer::prepare(size_t n){
+    size_t currTail = tail.load(std::memory_order_relaxed);
+    if(n > data.size() - (currTail - cachedHead)){
+        cachedHead = head.load(std::memory_order_acquire);
+    }
+    size_t room = std::min(n, data.size() - (currTail - cachedHead));
+    if(room == 0){
+        return WritableRegions();
+    }
+    size_t index = currTail & mask;
+    size_t firstPart = std::min(room, data.size() - index);
+    return WritableRegions{std::span<char>(data.data() + index, firstPart),
+                            std::span<char>(data.data(), room - firstPart)};
+}
+
+int ringbuffer::SPSCRingBuffer::commit(size_t n){
+    size_t currTail = tail.load(std::memory_order_relaxed);
+    if(n > data.size() - (currTail - cachedHead)){
+        cachedHead = head.load(std::memory_order_acquire);
+        if(n > data.size() - (currTail - cachedHead)){
+            return ringbuffer::OUTOFBOUNDS;
+        }
+    }
+    //publish what was written to the consumer
+    tail.store(currTail + n, std::memory_order_release);
+    return 1;
+}
+
+std::string ringbuffer::SPSCRingBuffer::getContents(){
+    if(data.empty()){
+        ringbuffer::bufferError("FATAL ERROR: you're using an NULL ring buffer (a ring buffer of size 0)\n"
+                                "in getContents() function in SPSCRingBuffer in ring.hpp");
+    }
+    Regions regions = readable_regions();
+    std::string ret;
+    ret.reserve(regions[0].size() + regions[1].size());
+    ret.append(regions[0].data(), regions[0].size());
+    ret.append(regions[1].data(), regions[1].size());
+    return ret;
+}
+
+bool ringbuffer::SPSCRingBuffer::isEmpty(){
+    return size() == 0;
+}
+
+size_t ringbuffer::SPSCRingBuffer::size(){
+    //load head first so tail can only be newer (never smaller than head)
+    size_t currHead = head.load(std::memory_order_acquire);
+    return tail.load(std::memory_order_acquire) - currHead;
+}
+
+size_t ringbuffer::SPSCRingBuffer::capacity(){
+    return data.size();
+}
+
+int ringbuffer::SPSCRingBuffer::resize(size_t newLength){
+    if(newLength == 0){
+        throw std::invalid_argument("FATAL ERROR: the max length cannot be 0.\n"
+                                    "in resize() function in SPSCRingBuffer in ring.hpp");
+    }
+    size_t count = size();
+    size_t newCapacity = std::bit_ceil(newLength);
+    if(newCapacity < count){
+        return OUTOFBOUNDS;
+    }
+    std::vector<char> newData(newCapacity, '\0');
+    size_t copied = 0;
+    for(const std::span<const char>& region : readable_regions()){
+        if(!region.empty()){
+            std::memcpy(newData.data() + copied, region.data(), region.size());
+            copied += region.size();
+        }
+    }
+    data.swap(newData);
+    mask = newCapacity - 1;
+    head.store(0, std::memory_order_relaxed);
+    tail.store(count, std::memory_order_relaxed);
+    cachedHead = 0;
+    cachedTail = count;
+    return 1;
 }
\ No newline at end of file
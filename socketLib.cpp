@@ -1,792 +1,1626 @@
-#include "socketLib.hpp"
-
-#include <iostream>
-#include <bitset>
-
-using enum socketstuffs::ErrorCodes;
-
-std::string socketstuffs::interpretError(int errCode){
-    //only implemented up to what's implemented
-    if(errCode >= 0){
-        return std::string("This isn't an error (errCode > 0)");
-    }
-    std::string ret;
-    switch(errCode){
-        case INVALIDPORT:
-            ret = "Error: Bad port number\n\t- Call to openIt() in socketLib.hpp";
-            break;
-        case NOTOPENED:
-            ret = "Error: Socket wasn't even opened\n\t- Call to closeIt() in socketLib.hpp";
-            break;
-        case NONEMPTYVECTOR:
-            ret = "Error: this function only takes an empty vector as argument\n\t- Call to getValidScannedPorts() in socketLib.hpp";
-            break;
-        case ALREADYOPEN:
-            ret = "Error: Tried to call open without closing. Close opened socket first\n\t- Call to openIt() in socketLib.hpp";
-            break;
-        default: 
-            ret = "Undefined error or not yet implemented yet: " + std::to_string(errCode);
-    }
-    return ret;
-}
-
-int socketstuffs::getValidScannedPorts(int portstart, int portend, std::vector<int>& validPorts, bool display){
-    if(validPorts.size() != 0){
-        return NONEMPTYVECTOR;
-    }
-    // look at page 23 of book
-    struct addrinfo h;
-    struct addrinfo* si;
-    memset(&h, 0, sizeof(h));
-    h.ai_family = AF_INET;
-    h.ai_socktype = SOCK_STREAM;
-    h.ai_flags = AI_PASSIVE;
-
-    for(int i = portstart; i <= portend; i++){
-        if(display) std::cout << "Scanning Port " << i << ": ";
-
-        if(i < LOWERLIMIT) {
-            if(display) std::cout << "Port below "<< LOWERLIMIT << "! Ports are (" << LOWERLIMIT << "-" << NUMPORTS<< ")" << std::endl;;
-            continue;
-        }
-        if(i > NUMPORTS) {
-            if(display) std::cout << "Port number out of range! Ports are (" << LOWERLIMIT << "-" << NUMPORTS<< ")" << std::endl;;
-            continue;
-        }
-
-        int status = getaddrinfo(NULL, std::to_string(i).c_str(), &h, &si);
-        if(status != 0){
-            std::cout << "Tried to call getaddrinfo()\n"
-                    << "\t at function call getValidScannedPorts() in socketLib.cpp\n"
-                    << "\tVal is " << status << "\n"
-                    // << "\tPort is " << i
-                    << std::endl;
-            continue;
-        }
-
-        //look at page 25 of book
-        int sockfd = socket(si->ai_family, 
-                            si->ai_socktype, 
-                            si->ai_protocol
-                           );
-        if(sockfd == -1){
-            //not sure how to error check this
-            // we should print out just in case
-            std::cout << "Tried creating a socket\n"
-                    << "\t at function call getValidScannedPorts() in socketLib.cpp\n"
-                    << "\tVal is " << sockfd << "\n"
-                    //<< "\tPort is " << i
-                    << std::endl;
-            continue;
-        }
-
-        int res = bind(sockfd, si->ai_addr, si->ai_addrlen);
-        if(res == -1){
-            std::cout << "Tried calling bind()\n"
-                    << "\t at function call getValidScannedPorts() in socketLib.cpp\n"
-                    << "\tVal is " << sockfd << "\n"
-                    << "\tSkipping port " << i
-                    << std::endl;
-            continue;
-        }
-
-        if(display) std::cout << "VALID PORT" << std::endl;
-        validPorts.push_back(i);
-        close(sockfd);
-    }
-    return validPorts.size();
-}
-
-/*
-For references of "book" this is going to refer to
-    "Beej's Guide to Network Programming" 
-        by Brian "Beej Jogensen" Hall
-*/
-
-socketstuffs::Socket::Socket(){
-    std::memset(&hints, 0, sizeof(hints));
-    servinfo = 0;
-    std::memset(socketfd, 0, sizeof(socketfd[0]));
-    port = -1;
-
-}
-
-int socketstuffs::Socket::openIt(int port){
-    if(this->port != -1){
-        return ALREADYOPEN;
-    }
-    int status;
-    //copy from "Beej's Guide to Network Programming" by
-    //      Brian "Beej Jorgensen" Hall, pg 22, Chapter 5
-    hints.ai_family = AF_INET;
-    hints.ai_socktype = SOCK_STREAM;
-    hints.ai_flags = AI_PASSIVE;
-
-    if((status = getaddrinfo( NULL, std::to_string(port).c_str(), 
-                                &hints, &servinfo)
-        ) != 0){
-            std::cout << "error in socket::checkports.cpp\n" 
-                        << "\t>> in open()"
-                        << "\t>> call to getaddrinfo()\n" 
-                        << "\t>> port = " << port << "\n"
-                        << gai_strerror(status) << std::endl;
-        return INVALIDPORT;
-    }
-
-    int sockfd = socket(servinfo->ai_family, servinfo->ai_socktype, servinfo->ai_protocol);
-    if(sockfd == -1){
-        std::cout << "error in socket::checkports.cpp\n" 
-                    << "\t>> in openIt()"
-                    << "\t>> call to socket()\n" 
-                    << "\t>> port = " << port << "\n"
-                    << std::strerror(errno) << std::endl;
-        return INVALIDPORT;
-    }
-    //set it to nonblocking
-    fcntl(sockfd, F_SETFL, O_NONBLOCK);
-
-    int res = bind(sockfd, servinfo->ai_addr, servinfo->ai_addrlen);
-    if(res == -1){
-        std::cout << "error in socket::checkports.cpp\n" 
-                    << "\t>> in openIt()"
-                    << "\t>> call to bind()\n" 
-                    << "\t>> port = " << port << "\n"
-                    << std::strerror(errno) << std::endl;
-        return INVALIDPORT;
-    }
-
-    res = listen(sockfd, 5); // I want to set this to 1 but I don't
-                             // know if that will be an issue
-    if(res == -1){
-        std::cout << "error in socket::checkports.cpp\n" 
-                    << "\t>> in openIt()"
-                    << "\t>> call to listen()\n" 
-                    << "\t>> port = " << port << "\n"
-                    << std::strerror(errno) << std::endl;
-        close(sockfd);
-        return INVALIDPORT;
-    }
-
-    // page 46 of book
-    socketfd[0].fd = sockfd;
-    socketfd[0].events = POLLIN;
-
-    this->port = port;
-    return 1;
-}
-
-int socketstuffs::Socket::closeIt(){
-    // Some defensive programming
-    // 1) if port is not connected, socketfd should not be a socket 
-    //      in the first place, so we don't call close
-    //      and there's no need to reset port at that point
-    // 2) memset should be fine even if hints is empty
-    // 3) servinfo might be null
-    // 4) reset an array of struct (with only 1 element)
-    if(port != -1){
-        close(socketfd[0].fd);
-        port = -1;
-    }
-
-    std::memset(&hints, 0, sizeof(hints));
-    if(servinfo != NULL){
-        //std::cout << ">>>>its this" << std::endl;
-        freeaddrinfo(servinfo);
-        servinfo = NULL;
-        //std::cout << ">>>>or is it?" << std::endl;
-    }
-    std::memset(socketfd, 0, sizeof(socketfd[0]));  //this is find, so long as it's trivial
-
-    return 1;
-}
-
-int socketstuffs::Socket::getPort(){
-    return port;
-}
-
-int socketstuffs::Socket::getSocketFD(){
-    if(port == -1){
-        return -1;
-    }
-    return socketfd[0].fd;
-}
-
-/* Client stuff */
-socketstuffs::Client::Client(){
-    clientfd[0].fd = -1;
-}
-
-socketstuffs::Client::~Client(){
-    if(clientfd[0].fd != -1){
-        close(clientfd[0].fd);
-        clientfd[0].fd = -1;
-    }
-}
-
-int socketstuffs::Client::connectIt(Socket& s){
-    std::cout << "socket port is " << s.socketfd[0].fd << std::endl;
-    int val = poll(s.socketfd, 1, POLLTIMER);
-    if(val == 0){
-        return POLLTIMEDOUT;
-    }
-    else if(val < 0){
-        // Not sure what happens when poll comes out negative
-        // from the documentation
-    }
-    else{
-        if(s.socketfd[0].revents & POLLIN){
-            socklen_t add_size = sizeof(theiraddr);
-            clientfd[0].fd = accept(s.socketfd[0].fd,
-                                        (struct sockaddr*)&theiraddr,
-                                        &add_size);
-            clientfd[0].events = POLLIN | POLLOUT;
-            buffer = ringbuffer::RingBufferS(sharedstuff::Megabyte * 2);
-            return 1;
-        }
-    }
-    return UNKNOWNPOLLRESULT;
-}
-
-int socketstuffs::Client::getPacket(std::string& id, std::string& message){
-    if(clientfd[0].fd == -1){
-        throw std::runtime_error("ERROR: client fd is bad (client is not connected)\n"
-                                 "in getPacket() in Client in socketLib.hpp");
-    }
-
-    const int chunkSize = 100;
-    char chunk[chunkSize];
-    std::memset(chunk, '\0', chunkSize);
-
-    uint32_t messageSize = sharedstuff::INVALIDMSGCOUNT;
-    while(buffer.size() < sharedstuff::MSGSIZEBYTECOUNT){
-        //grab a couple bytes until we can recognize the size of the message
-        int val = poll(clientfd, 1, POLLTIMER);
-        if(val == 0){
-            return POLLTIMEDOUT;
-        }
-        else if(val < 0){
-            // Not sure what happens when poll comes out negative
-            // from the documentation
-            throw std::runtime_error(std::string("Oh lord please help me\n") + 
-                                     "error value: " + std::strerror(errno) + "\n" + 
-                                     "in reading the message size bytes\n" + 
-                                     "when polling\n" + 
-                                     "int getPacket() of socketLib.hpp");
-        }
-        else{
-            if(clientfd[0].revents & POLLIN){
-                ssize_t bytesRead = recv(clientfd[0].fd, chunk, chunkSize, 0); 
-                if(bytesRead < 0){
-                    //socket gives error
-                    return BADRECV;
-                }
-                else if(bytesRead == 0){
-                    //socket disconnected
-                    return READCLOSE;
-                }
-                std::string toAdd(chunk, bytesRead);
-                buffer.push(toAdd, toAdd.size());
-
-                continue;
-            }
-            else{
-                break;
-            }
-            /*
-            std::cout << "What did we get? " << std::endl;
-            std::cout << clientfd[0].revents << std::endl;
-            std::cout << "as bits: " << std::bitset<8>(clientfd[0].revents) << std::endl;
-            std::cout << (clientfd[0].revents & POLLIN) << std::endl;
-            std::cout << (clientfd[0].revents & POLLOUT) << std::endl;
-            std::cout << "In buffer:";
-            for(size_t i = 0;i<chunkSize;i++){
-                std::cout << std::hex << chunk[i] << " ";
-            }
-            std::cout << std::endl;
-            */
-        }
-
-        //return UNKNOWNPOLLRESULT;
-    }
-
-    /*
-    std::cout << "chunk: ";
-    for(size_t i = 0;i<chunkSize;i++){
-        if(i > 0) std::cout << ", ";
-        std::cout << std::hex << (int)chunk[i];
-    }
-    std::cout << std::endl;
-    */
-        
-    /*>>The message size part of the message<<*/
-    //I don't like the memory usage of this... a whole string object?
-    std::string msgSizeStr;
-    int val = buffer.pop(msgSizeStr, sharedstuff::MSGSIZEBYTECOUNT);
-    if(val != 1){       // some defensive programming
-        //This shouldnt be possible because we just made this
-        // check in the if statement above
-        // something else is touching this so 
-        //throw a runtime_error
-        throw std::runtime_error(std::string("FATAL ERROR: This shouldn't have happened\n") + 
-                                    "in after we check if buffer holds the right amount of bytes\n" +
-                                    "for finding the message size\n" +
-                                    "in getPacket() of Client class in socketLib.hpp");
-    }
-    /*
-    std::cout << "msgSizeStr: ";
-    for(size_t i = 0;i<msgSizeStr.size();i++){
-        if(i > 0) std::cout << ", ";
-        std::cout << std::hex << (int)msgSizeStr[i];
-    }
-    std::cout << std::endl;
-    */
-
-    /*>>The ID part of the message*/
-    while(buffer.size() < sharedstuff::IDSIZEBYTECOUNT){
-        //grab a couple bytes until we can recognize the size of the message
-        int val = poll(clientfd, 1, POLLTIMER);
-        if(val == 0){
-            return POLLTIMEDOUT;
-        }
-        else if(val < 0){
-            // Not sure what happens when poll comes out negative
-            // from the documentation
-            throw std::runtime_error(std::string("Oh lord please help me\n") +
-                                     "error value: " + std::strerror(errno) + "\n" +
-                                     "in reading the message size bytes\n" +
-                                     "when polling\n" +
-                                     "int getPacket() of socketLib.hpp");
-        }
-        else{
-            if(clientfd[0].revents & POLLIN){
-                ssize_t bytesRead = recv(clientfd[0].fd, chunk, chunkSize, 0); 
-                if(bytesRead < 0){
-                    //socket gives error
-                    return BADRECV;
-                }
-                else if(bytesRead == 0){
-                    //socket disconnected
-                    return READCLOSE;
-                }
-                std::string toAdd(chunk, bytesRead);
-                buffer.push(toAdd, toAdd.size());
-
-                continue;
-            }
-            else{
-                break;
-            }
-        }
-
-        //return UNKNOWNPOLLRESULT;
-    }
-        
-    /*>>The message size part of the message<<*/
-    val = buffer.pop(id, sharedstuff::IDSIZEBYTECOUNT);
-    if(val != 1){       // some defensive programming
-        //This shouldnt be possible because we just made this
-        // check in the if statement above
-        // something else is touching this so 
-        //throw a runtime_error
-        throw std::runtime_error(std::string("FATAL ERROR: This shouldn't have happened\n") + 
-                                    "in after we check if buffer holds the right amount of bytes\n" +
-                                    "for finding the message id\n" +
-                                    "in getPacket() of Client class in socketLib.hpp");
-    }
-    size_t nonspaceIndex = 0; // go to zero if we have an empty id
-    for(size_t i = id.size() - 1;i > 0;i--){
-        if(id[i] != ' '){
-            nonspaceIndex = i;
-            break;
-        } 
-    }
-    id.erase(nonspaceIndex+1);
-
-    /*>>The message part of the message*/
-    messageSize = sharedstuff::strToUint(msgSizeStr);
-    //std::cout << "message size is " << messageSize << std::endl;
-    while(buffer.size() < messageSize){
-        //grab the remaining message floating in the internet
-        int val = poll(clientfd, 1, POLLTIMER);
-        if(val == 0){
-            return POLLTIMEDOUT;
-        }
-        else if(val < 0){
-            // Not sure what happens when poll comes out negative
-            // from the documentation
-            throw std::runtime_error(std::string("Oh lord please help me\n") +
-                                     "error value: " + std::strerror(errno) + "\n"
-                                     "in reading the message size bytes\n" +
-                                     "when polling\n" +
-                                     "int getPacket() of socketLib.hpp");
-        }
-        else{
-            if(clientfd[0].revents & POLLIN){
-                ssize_t bytesRead = recv(clientfd[0].fd, chunk, chunkSize, 0); 
-                if(bytesRead < 0){
-                    //socket gives error
-                    return BADRECV;
-                }
-                else if(bytesRead == 0){
-                    //socket disconnected
-                    return READCLOSE;
-                }
-                std::string toAdd(chunk, bytesRead);
-                buffer.push(toAdd, toAdd.size());
-
-                continue;
-            }
-            else{
-                break;
-            }
-        }
-
-        //return UNKNOWNPOLLRESULT;
-
-    }
-    val = buffer.pop(message, messageSize);
-    if(val != 1){
-        //This shouldnt be possible because we just made this
-        // check in the if statement above
-        // something else is touching this so 
-        //throw a runtime_error
-        throw std::runtime_error("FATAL ERROR: This shouldn't have happened\n"
-                                    "in after we check if buffer holds the right amount of bytes\n"
-                                    "for grabbing the whole message\n"
-                                    "in getPacket() of Client class in socketLib.hpp");
-    }
-    //std::cout << "Got: " << message << std::endl;
-    //std::cout << "From: " << id << std::endl;
-    return 1;
-}
-
-int socketstuffs::Client::sendPacket(const std::string& id, const std::string& message){
-    if(clientfd[0].fd == -1){
-        throw std::runtime_error("ERROR: client fd is bad (client is not connected)\n"
-                                 "in sendPacket() in Client in socketLib.hpp");
-    }
-
-    if(message.size() > sharedstuff::Megabyte - sharedstuff::HEADERSIZE){
-        return MSGTOOBIG;
-    }
-
-    std::string idPadded = id;
-    if(id.size() > sharedstuff::IDSIZEBYTECOUNT){
-        return IDTOOBIG;
-    }
-    else if(id.size() < sharedstuff::IDSIZEBYTECOUNT){
-        idPadded.append((size_t)sharedstuff::IDSIZEBYTECOUNT - id.size(), ' ');
-    }
-
-    uint32_t messageSize = message.size();
-    std::string msgSizeHeader = sharedstuff::uintToStr(messageSize);
-    std::string packetStr = msgSizeHeader + idPadded + message;
-
-    /*
-    std::cout << "Parts:" << std::endl;
-    std::cout << "Message Header: " << msgSizeHeader << std::endl;
-    std::cout << "idPadded: " << idPadded << std::endl; 
-    std::cout << "message: " << message << std::endl;
-    */
-
-    const char* packet = packetStr.c_str();
-    size_t packetSize = packetStr.size();
-    /*
-    std::cout << "Sending>>";
-    for(size_t i = 0;i<packetSize;i++){
-        std::cout << std::hex << (int)packet[i] << " ";
-    }
-    std::cout << std::endl;
-    */
-    uint32_t totalBytes = 0;
-
-    while(totalBytes < packetSize){
-        int val = poll(clientfd, 1, POLLTIMER);
-        if(val == 0){
-            return POLLTIMEDOUT;
-        }
-        else if(val < 0){
-            // Not sure what happens when poll comes out negative
-            // from the documentation
-            throw std::runtime_error(std::string("Oh lord please help me\n") + 
-                                     "error value: " + std::strerror(errno) + "\n"
-                                     "in sending the packet\n"
-                                     "when polling\n"
-                                     "int sendPacket() of socketLib.hpp");
-        }
-        else{
-            if(clientfd[0].revents & POLLOUT){
-                ssize_t bytesSent = send(clientfd[0].fd, packet + totalBytes, packetSize - totalBytes, 0);
-                if(bytesSent == 0){
-                    return SENDCLOSE;
-                }
-                else if(bytesSent == -1){
-                    return BADSEND;
-                }
-
-                totalBytes += bytesSent;
-
-                continue;
-            }
-        }
-    }
-
-    return 1;
-}
-
-int socketstuffs::Client::closeIt(){
-
-    if(clientfd[0].fd != -1){
-        close(clientfd[0].fd);
-        clientfd[0].fd = -1;
-    }
-
-    return 1;
-}
-
-/* Connection stuff */
-int socketstuffs::connectClient(Socket& s, Client& c, history::History& record){
-    std::vector<int> validPorts;
-    int res;
-    res = getValidScannedPorts(9000, 9100, validPorts);
-    if(res == socketstuffs::NONEMPTYVECTOR) { // defensive programming
-        throw std::logic_error(std::string("Please don't do this to me\n") + 
-                            "in getting validScannedPorts()\n" +
-                            "in the state INIT in job() in socketLib.cpp");
-    }
-    int index = 0;
-    record.addMessage(std::string("Attempting to open a socket at port ") + std::to_string(validPorts[index]));
-    res = s.openIt(validPorts[index]);
-    while(res != 1){
-        record.addMessage(">>Failed at this port:");
-        if(res == socketstuffs::INVALIDPORT){ // defensive programming
-            record.addMessage("\t- This port was invalid");
-        }
-        else if(res == socketstuffs::ALREADYOPEN){
-            record.addMessage("\t- This port is already used");
-        }
-        index++;
-        res = s.openIt(validPorts[index]);
-    }
-    if(res != 1){
-        throw std::runtime_error(std::string("Failed to open a socket in the port range (9000-9100)"));
-    }
-    record.addMessage("Attempting to connect to a client");
-    res = c.connectIt(s);
-    if(res == socketstuffs::UNKNOWNPOLLRESULT){
-        record.addMessage("Failed to connect to a client");
-        record.addMessage("The errno message is:");
-        record.addMessage(std:string("\t") + std::strerror(errno));
-        throw std::runtime_error(std::string("Oh I'm a gummy bear\n") + 
-                                "When I wanted to connect to client\n" + 
-                                "in the state OPEN in job in socketLib.cpp");
-    }
-    record.addMessage(">>>>Client connected successfully");
-    return 1;
-}
-
-int socketstuffs::sendQuery(const std::string& id, 
-                            const std::string& query, 
-                            const Client& c, 
-                            history::History& record){
-    //first we send
-    record.addMessage(std::string("Trying to send message: ") + query + "\n" + 
-                    "\t> From " + id + "\n");
-    int res = c.sendPacket(id, query);
-    if(res == socketstuffs::MSGTOOBIG){
-        /*
-        throw std::runtime_error(std::string("You gave a message that's too big\n")+
-                                "when trying to send a query\n" + 
-                                "in sendQuery() function of socketLib.cpp");
-        */
-        //Not sure if crashing on bad message is a good idea
-        //The input is wrong, so we should be continuing 
-        record.addMessage(std::string("SEND ERROR: Message to big! Query size is ") + std::to_string(query) + "\n" + 
-                        "In sendQuery() function in socketLib.cpp");
-        return socketstuffs::SENDERROR;
-    }
-    else if(res == socketstuffs::POLLTIMEDOUT){
-        /*
-        //not sure why this happens
-        //awaiting until someone encounters this
-        throw std::runtime_error(std::string("Somehow got that the socket poll() lagged out\n")+
-                                "while sending a message over the internet\n" + 
-                                "in sendQuery() function of socketLib.cpp");
-        */    
-        record.addMessage(std::string("SEND ERROR: Poll timed out in sending\n") + 
-                        "In sendQuery() function in socketLib.cpp");
-        return socketstuffs::SENDERROR;
-    }
-    record.addMessage(std::string(">>>>Message sent successfully\n"));
-
-    //now we wait
-    record.addMessage(std::string("Awaiting a response from the client\n") + 
-                    "I'm willing to wait " + std::to_string(socketstuffs::POLLTIMER/1000) + " secs\n");
-    std::string response, responseID;
-    res = c.getPacket(responseID, response);
-    if(res == socketstuffs::POLLTIMEDOUT){
-        /*
-        //not sure why this happens
-        //awaiting until someone encounters this
-        throw std::runtime_error(std::string("got poll lag again\n"
-                                            "while trying to get a message over the internet\n"
-                                            "in sendQuery() function of socketLib.cpp"))
-        */
-        //I'm not sure if crashing on an empty poll is a good idea
-        // we should instead return a different value
-        record.addMessage(std::string(">>>>Got a bad poll response"));
-        return -1;
-    }
-    record.addMessage(std::string(">>>>Response received successfully: ") + response);
-
-    lastOutput = response;
-    return 1;
-}
-
-int socketstuffs::verifyConnection(Client& c, history::History& record){
-    //first we send
-    record.addMessage(std::string("Trying to send message: ") + "PING\n" + 
-                    "\t> From SYS \n");
-    int res = c.sendPacket("SYS", "PING");
-    if(res == socketstuffs::MSGTOOBIG){
-        /*
-        throw std::runtime_error(std::string("You're telling me PING is too big?\n")+
-                                "when trying to send a query\n" + 
-                                "in verifyConnection() function of socketLib.cpp");
-        */
-        //Not sure if crashing on bad message is a good idea
-        record.addMessage(std::string("SEND ERROR: Message to big! Query size is ") + std::to_string(query) + "\n" + 
-                        "In verifyConnection() function in socketLib.cpp");
-        return socketstuffs::SENDERROR;
-    }
-    else if(res == socketstuffs::POLLTIMEDOUT){
-        /* 
-        //not sure why this happens
-        //awaiting until someone encounters this
-        throw std::runtime_error(std::string("Somehow got that the socket poll() lagged out\n")+
-                                "while sending \"PING\" over the internet\n" + 
-                                "in verifyConnection() function of socketLib.cpp");
-        */
-        //Don't want to crash on a bad poll but the user should know
-        // the connection may be buggin out
-        record.addMessage(std::string("SEND ERROR: Poll timed out in sending\n") + 
-                        "In verifyConnection() function in socketLib.cpp");
-        return socketstuffs::SENDERROR;
-    }
-    record.addMessage(std::string("Sent PING successfully\n"));
-
-    //now we wait
-    record.addMessage(std::string("Awaiting a response from the client\n") + 
-                    "I'm willing to wait " + socketstuffs::POLLTIMER + " secs\n");
-    std::string response, responseID;
-    res = getPacket(responseID, response);
-    if(res == socketstuffs::POLLTIMEDOUT){
-        /*
-        //not sure why this happens
-        //awaiting until someone encounters this
-        throw std::runtime_error(std::string("got poll lag again\n"
-                                            "while trying to get a message over the internet\n"
-                                            "in sendQuery() function of socketLib.cpp"))
-        */
-        //Don't want to crash on a bad poll but the user should know
-        // the connection may be buggin out
-        record.addMessage(std::string(">>>>Got a bad poll response"));
-        return -1;
-    }
-    if(response != "PONG"){
-        record.addMessage(std::string("You did not get PONG!. Instead, I got: \n") + 
-                                    "\t>> " + response);
-        return -1;
-    }
-    
-    return 1;
-}
-
-socketstuffs::Connection::Connection(){
-    state = socketstuffs::INIT;
-    lastOutput = "";
-}
-
-socketstuffs::Connection::start(){
-    connectClient(s, c, record);
-}
-
-socketstuffs::Connection::input(std::vector<std::string>& args){
-    if(args.size() != 2){
-        /*
-        //Since it is the USER's fault, instead of a crash
-        //we need to DISPLAY to the user that the input was bad
-        throw invalid_argument(std::string("invalid argument size. number of arguments must be 2.\n") + 
-                                "Got a vector of size: " + std::to_string(args.size()) + "\n" + 
-                                "for input() function in socketLib.hpp");
-        */
-        record.addMessage(std::string("Invalid argument size. Number of arguments must be 2.\n") + 
-                        + "Got a vector f size: " + std::to_string(args.size()) + "\n" + 
-                        + "for input() function in socketLib.hpp");
-        return socketstuffs::BADINPUTERROR;
-    }
-    if(args[0].size() > 13){
-        record.addMessage(std::string("The first argument (ID) is longer than 13 characters\n") + 
-                            "> it is " + std::to_string(args[0].size()) + " characters long\n" +
-                            "in input() function in socketLib.hpp");
-        return socketstuffs::BADINPUTERROR;
-    }
-    if(args[1].size() > sharedstuff::Megabyte) {
-        record.addMessage(std::string("The message part of the argument exceeds the maximum message length (") + sharedstuff::Megabyte + ")\n" + 
-                                    "the message size is " + args[1].size() + "\n" + 
-                                    "in input function in socketLib.hpp");
-        return socketstuffs::BADINPUTERROR;
-    }
-    if(args[1].size() == 0){
-        record.addMessage(std::string("Don't send an empty body\n") +
-                            "in input function in socketLib.hpp");
-        return socketstuffs::BADINPUTERROR;
-    }
-    if(state == socketstuffs::BUSY){
-        record.addMessage(std::string("The connection is already busy. Wait until it is finished\n") + 
-                            "in input function in socketLib.hpp");
-        return socketstuffs::ALREADYBUSY;
-    }
-
-    record.addMessage(std::string("Got message! From: ") + args[0] + "\n" +
-                        ">>" + args[1]);
-    msgQueue = std::make_pair(args[0], args[1]);
-    state = socketstuffs::BUSY;
-}
-
-socketstuffs::Connection::exit(){
-    c.closeIt();
-    s.closeIt();
-}
-
-void socketstuffs::Connection::job() {
-    if(state == socketstuffs::IDLE){
-        //I think it mostly does nothing here
-        //This part is mostly just doing idle things until we get an input
-        // maybe we try verifyConnection() in order to not let it die?
-    }
-    else if(state == socketstuffs::BUSY){
-        int res = sendQuery(msgQueue.first, msgQueue.second, this, record);
-        if(res == -1){
-            record.addMessage(std::string("Didn't get a response from sendQuery\n") +
-                                "in job() in socketLib.hpp");
-        }
-        else if(res == socketstuffs::SENDERROR){
-            record.addMessaeg(std::string("Wasn't able to send in sendQuery\n") +
-                                "in job() in socketLib.cpp");
-        }
-        state = socketstuffs::IDLE;
-    }
-}
-
-std::string socketstuffs::Connection::getLastOutput(){
-    if(lastOutput == ""){
-        return ">@EMPTY@<";
-    }
-
-    return lastOutput;
-}
-
-const std::list<std::string>& socketstuffs::Connection::getRecord(){
-    return record.getMessage();
-}
\ No newline at end of file
+#include "socketLib.hpp"
+
+#include <iostream>
+#include <bitset>
+#include <chrono>
+#include <vector>
+
+using enum socketstuffs::ErrorCodes;
+
+std::string socketstuffs::interpretError(int errCode){
+    //only implemented up to what's implemented
+    if(errCode >= 0){
+        return std::string("This isn't an error (errCode > 0)");
+    }
+    std::string ret;
+    switch(errCode){
+        case INVALIDPORT:
+            ret = "Error: Bad port number\n\t- Call to openIt() in socketLib.hpp";
+            break;
+        case NOTOPENED:
+            ret = "Error: Socket wasn't even opened\n\t- Call to closeIt() in socketLib.hpp";
+            break;
+        case NONEMPTYVECTOR:
+            ret = "Error: this function only takes an empty vector as argument\n\t- Call to getValidScannedPorts() in socketLib.hpp";
+            break;
+        case ALREADYOPEN:
+            ret = "Error: Tried to call open without closing. Close opened socket first\n\t- Call to openIt() in socketLib.hpp";
+            break;
+        case MIDSTREAM:
+            ret = "Error: A packet is only partly received by getPacketStream() or tryGetPacket(). Finish it with the same one first\n\t- Call to getPacket(), getPackets(), getPacketStream() or tryGetPacket() in socketLib.hpp";
+            break;
+        case BADFILE:
+            ret = "Error: The file can't be read or is shorter than offset + length\n\t- Call to sendFilePacket() in socketLib.hpp";
+            break;
+        case BADCOMPRESSION:
+            ret = "Error: A compressed message didn't inflate to the size it says (or is bigger than a packet)\n\t- Call to getPacket(), getPackets(), getPacketStream() or tryGetPacket() in socketLib.hpp";
+            break;
+        case BADEPOLL:
+            ret = "Error: epoll_ctl() refused the fd (bad fd, or out of memory)\n\t- Call to add(), modify() or watchSocket() of Reactor in reactor.hpp";
+            break;
+        case NOTWATCHED:
+            ret = "Error: The fd isn't watched by this Reactor\n\t- Call to modify() or remove() of Reactor in reactor.hpp";
+            break;
+        case ALREADYWATCHED:
+            ret = "Error: The fd is already watched by this Reactor. Use modify() to change what it waits for\n\t- Call to add() of Reactor in reactor.hpp";
+            break;
+        case BADACCEPT:
+            ret = "Error: accept4() failed (probably out of file descriptors)\n\t- Call to acceptIt() of Socket in socketLib.hpp";
+            break;
+        case UNKNOWNCLIENT:
+            ret = "Error: There's no client with that fd\n\t- Call to erase() of ClientTable or dropClient() of Server in server.hpp";
+            break;
+        case NOURING:
+            ret = "Error: io_uring isn't available (kernel too old, turned off, or built without it). The Client keeps using poll()\n\t- Call to useUring() in socketLib.hpp";
+            break;
+        case UNKNOWNSHARD:
+            ret = "Error: There's no shard with that number\n\t- Call to getStats() of ShardedServer in shardedServer.hpp";
+            break;
+        case UNKNOWNCOMMAND:
+            ret = "Error: No command with that name was added to the dispatcher\n\t- Call to dispatch() of CommandDispatcher in commandDispatcher.hpp";
+            break;
+        case COMMANDFAILED:
+            ret = "Error: The command threw while it ran\n\t- Call to executeCommand() of a command run by CommandDispatcher in commandDispatcher.hpp";
+            break;
+        case BADAFFINITY:
+            ret = "Error: A shard's thread could not be pinned to its CPU (it still runs, just unpinned)\n\t- Call to start() of ShardedServer in shardedServer.hpp";
+            break;
+        case QUEUEFULL:
+            ret = "Error: The query queue is full. Wait for job() or enqueue with wait = true\n\t- Call to input() or enqueue() in socketLib.hpp";
+            break;
+        case BADRINGTYPE:
+            ret = "Error: The reader thread needs a Client made with ringbuffer::SPSC\n\t- Call to startReader() in socketLib.hpp";
+            break;
+        default: 
+            ret = "Undefined error or not yet implemented yet: " + std::to_string(errCode);
+    }
+    return ret;
+}
+
+int socketstuffs::getValidScannedPorts(int portstart, int portend, std::vector<int>& validPorts, bool display){
+    if(validPorts.size() != 0){
+        return NONEMPTYVECTOR;
+    }
+    // look at page 23 of book
+    struct addrinfo h;
+    struct addrinfo* si;
+    memset(&h, 0, sizeof(h));
+    h.ai_family = AF_INET;
+    h.ai_socktype = SOCK_STREAM;
+    h.ai_flags = AI_PASSIVE;
+
+    for(int i = portstart; i <= portend; i++){
+        if(display) std::cout << "Scanning Port " << i << ": ";
+
+        if(i < LOWERLIMIT) {
+            if(display) std::cout << "Port below "<< LOWERLIMIT << "! Ports are (" << LOWERLIMIT << "-" << NUMPORTS<< ")" << std::endl;;
+            continue;
+        }
+        if(i > NUMPORTS) {
+            if(display) std::cout << "Port number out of range! Ports are (" << LOWERLIMIT << "-" << NUMPORTS<< ")" << std::endl;;
+            continue;
+        }
+
+        int status = getaddrinfo(NULL, std::to_string(i).c_str(), &h, &si);
+        if(status != 0){
+            std::cout << "Tried to call getaddrinfo()\n"
+                    << "\t at function call getValidScannedPorts() in socketLib.cpp\n"
+                    << "\tVal is " << status << "\n"
+                    // << "\tPort is " << i
+                    << std::endl;
+            continue;
+        }
+
+        //look at page 25 of book
+        int sockfd = socket(si->ai_family, 
+                            si->ai_socktype, 
+                            si->ai_protocol
+                           );
+        if(sockfd == -1){
+            //not sure how to error check this
+            // we should print out just in case
+            std::cout << "Tried creating a socket\n"
+                    << "\t at function call getValidScannedPorts() in socketLib.cpp\n"
+                    << "\tVal is " << sockfd << "\n"
+                    //<< "\tPort is " << i
+                    << std::endl;
+            continue;
+        }
+
+        int res = bind(sockfd, si->ai_addr, si->ai_addrlen);
+        if(res == -1){
+            std::cout << "Tried calling bind()\n"
+                    << "\t at function call getValidScannedPorts() in socketLib.cpp\n"
+                    << "\tVal is " << sockfd << "\n"
+                    << "\tSkipping port " << i
+                    << std::endl;
+            continue;
+        }
+
+        if(display) std::cout << "VALID PORT" << std::endl;
+        validPorts.push_back(i);
+        close(sockfd);
+    }
+    return validPorts.size();
+}
+
+/*
+For references of "book" this is going to refer to
+    "Beej's Guide to Network Programming" 
+        by Brian "Beej Jogensen" Hall
+*/
+
+socketstuffs::Socket::Socket(){
+    std::memset(&hints, 0, sizeof(hints));
+    servinfo = 0;
+    std::memset(socketfd, 0, sizeof(socketfd[0]));
+    port = -1;
+
+}
+
+int socketstuffs::Socket::openIt(int port){
+    return openIt(port, SOMAXCONN);
+}
+
+int socketstuffs::Socket::openIt(int port, int backlog){
+    return openIt(port, backlog, false);
+}
+
+int socketstuffs::Socket::openIt(int port, int backlog, bool reusePort){
+    if(this->port != -1){
+        return ALREADYOPEN;
+    }
+    int status;
+    //copy from "Beej's Guide to Network Programming" by
+    //      Brian "Beej Jorgensen" Hall, pg 22, Chapter 5
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+
+    if((status = getaddrinfo( NULL, std::to_string(port).c_str(), 
+                                &hints, &servinfo)
+        ) != 0){
+            std::cout << "error in socket::checkports.cpp\n" 
+                        << "\t>> in open()"
+                        << "\t>> call to getaddrinfo()\n" 
+                        << "\t>> port = " << port << "\n"
+                        << gai_strerror(status) << std::endl;
+        return INVALIDPORT;
+    }
+
+    int sockfd = socket(servinfo->ai_family, servinfo->ai_socktype, servinfo->ai_protocol);
+    if(sockfd == -1){
+        std::cout << "error in socket::checkports.cpp\n" 
+                    << "\t>> in openIt()"
+                    << "\t>> call to socket()\n" 
+                    << "\t>> port = " << port << "\n"
+                    << std::strerror(errno) << std::endl;
+        return INVALIDPORT;
+    }
+    //set it to nonblocking
+    fcntl(sockfd, F_SETFL, O_NONBLOCK);
+
+    //has to be set on every socket sharing the port, before bind()
+    int one = 1;
+    if(reusePort && setsockopt(sockfd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) == -1){
+        std::cout << "error in socket::checkports.cpp\n" 
+                    << "\t>> in openIt()"
+                    << "\t>> call to setsockopt(SO_REUSEPORT)\n" 
+                    << "\t>> port = " << port << "\n"
+                    << std::strerror(errno) << std::endl;
+        close(sockfd);
+        return INVALIDPORT;
+    }
+
+    int res = bind(sockfd, servinfo->ai_addr, servinfo->ai_addrlen);
+    if(res == -1){
+        std::cout << "error in socket::checkports.cpp\n" 
+                    << "\t>> in openIt()"
+                    << "\t>> call to bind()\n" 
+                    << "\t>> port = " << port << "\n"
+                    << std::strerror(errno) << std::endl;
+        return INVALIDPORT;
+    }
+
+    res = listen(sockfd, backlog);
+    if(res == -1){
+        std::cout << "error in socket::checkports.cpp\n" 
+                    << "\t>> in openIt()"
+                    << "\t>> call to listen()\n" 
+                    << "\t>> port = " << port << "\n"
+                    << std::strerror(errno) << std::endl;
+        close(sockfd);
+        return INVALIDPORT;
+    }
+
+    // page 46 of book
+    socketfd[0].fd = sockfd;
+    socketfd[0].events = POLLIN;
+
+    this->port = port;
+    return 1;
+}
+
+int socketstuffs::Socket::closeIt(){
+    // Some defensive programming
+    // 1) if port is not connected, socketfd should not be a socket 
+    //      in the first place, so we don't call close
+    //      and there's no need to reset port at that point
+    // 2) memset should be fine even if hints is empty
+    // 3) servinfo might be null
+    // 4) reset an array of struct (with only 1 element)
+    if(port != -1){
+        close(socketfd[0].fd);
+        port = -1;
+    }
+
+    std::memset(&hints, 0, sizeof(hints));
+    if(servinfo != NULL){
+        //std::cout << ">>>>its this" << std::endl;
+        freeaddrinfo(servinfo);
+        servinfo = NULL;
+        //std::cout << ">>>>or is it?" << std::endl;
+    }
+    std::memset(socketfd, 0, sizeof(socketfd[0]));  //this is find, so long as it's trivial
+
+    return 1;
+}
+
+int socketstuffs::Socket::acceptIt(int& clientFd){
+    if(port == -1){
+        return NOTOPENED;
+    }
+    while(true){
+        int fd = accept4(socketfd[0].fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if(fd != -1){
+            clientFd = fd;
+            return 1;
+        }
+        if(errno == EAGAIN || errno == EWOULDBLOCK){
+            return 0;
+        }
+        if(errno == EINTR || errno == ECONNABORTED){
+            //that one gave up before we got to it, try the next
+            continue;
+        }
+        return BADACCEPT;
+    }
+}
+
+int socketstuffs::Socket::getPort(){
+    return port;
+}
+
+int socketstuffs::Socket::getSocketFD(){
+    if(port == -1){
+        return -1;
+    }
+    return socketfd[0].fd;
+}
+
+/* Client stuff */
+template<typename Codec>
+socketstuffs::BasicClient<Codec>::BasicClient() : BasicClient(ringbuffer::STANDARD){
+}
+
+template<typename Codec>
+socketstuffs::BasicClient<Codec>::BasicClient(ringbuffer::RingType ringType){
+    clientfd[0].fd = -1;
+    this->ringType = ringType;
+    readerRunning = false;
+    readerStatus = 1;
+    idleShrinkTime = std::chrono::milliseconds(IDLESHRINKTIMER);
+    sendCalls = 0;
+    streaming = false;
+    streamRemaining = 0;
+    compressThreshold = 0;
+    compressLevel = Z_BEST_SPEED;
+    streamCompressed = false;
+    streamError = 1;
+    drained = false;
+    recvBroken = false;
+}
+
+template<typename Codec>
+socketstuffs::BasicClient<Codec>::~BasicClient(){
+    stopReader();
+    transport.closeIt();
+    if(clientfd[0].fd != -1){
+        close(clientfd[0].fd);
+        clientfd[0].fd = -1;
+    }
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::connectIt(Socket& s){
+    std::cout << "socket port is " << s.socketfd[0].fd << std::endl;
+    //the reader can't keep using the old buffer
+    stopReader();
+    transport.closeIt();
+    int val = poll(s.socketfd, 1, POLLTIMER);
+    if(val == 0){
+        return POLLTIMEDOUT;
+    }
+    else if(val < 0){
+        // Not sure what happens when poll comes out negative
+        // from the documentation
+    }
+    else{
+        if(s.socketfd[0].revents & POLLIN){
+            socklen_t add_size = sizeof(theiraddr);
+            clientfd[0].fd = accept(s.socketfd[0].fd,
+                                        (struct sockaddr*)&theiraddr,
+                                        &add_size);
+            prepareConnection();
+            return 1;
+        }
+    }
+    return UNKNOWNPOLLRESULT;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::connectIt(int fd){
+    if(fd == -1){
+        return NOTOPENED;
+    }
+    stopReader();
+    transport.closeIt();
+    if(clientfd[0].fd != -1 && clientfd[0].fd != fd){
+        close(clientfd[0].fd);
+    }
+    clientfd[0].fd = fd;
+    socklen_t add_size = sizeof(theiraddr);
+    if(getpeername(fd, (struct sockaddr*)&theiraddr, &add_size) == -1){
+        std::memset(&theiraddr, 0, sizeof(theiraddr));
+    }
+    prepareConnection();
+    return 1;
+}
+
+template<typename Codec>
+void socketstuffs::BasicClient<Codec>::prepareConnection(){
+    clientfd[0].events = POLLIN | POLLOUT;
+    //start small, getPacket grows it when a big packet shows up
+    // (except for SPSC, the reader thread can't wait on a resize)
+    size_t startSize = ringType == ringbuffer::SPSC ? MAXBUFFERSIZE : INITIALBUFFERSIZE;
+    if(buffer && buffer->capacity() == startSize){
+        //connected before and it didn't grow, so just empty it
+        buffer->consume(buffer->size());
+    }
+    else if(ringType == ringbuffer::MIRRORED){
+        buffer = std::make_unique<ringbuffer::MirroredRingBuffer>(INITIALBUFFERSIZE);
+    }
+    else if(ringType == ringbuffer::SPSC){
+        buffer = std::make_unique<ringbuffer::SPSCRingBuffer>(MAXBUFFERSIZE);
+    }
+    else{
+        buffer = std::make_unique<ringbuffer::RingBufferS>(INITIALBUFFERSIZE);
+    }
+    lastBigPacket = std::chrono::steady_clock::now();
+    //nothing of the last connection carries over
+    decoder.reset();
+    streaming = false;
+    streamRemaining = 0;
+    drained = false;
+    recvBroken = false;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::fillBuffer(size_t needed){
+    if(readerRunning.load(std::memory_order_relaxed)){
+        return waitForBuffer(needed);
+    }
+
+    //only ask about POLLIN here, otherwise poll() keeps returning 
+    // right away because the socket is writable
+    struct pollfd readfd[1];
+    readfd[0].fd = clientfd[0].fd;
+    readfd[0].events = POLLIN;
+
+    while(buffer->size() < needed){
+        if(transport.isOpen()){
+            //the ring does the waiting, no poll()
+            ssize_t bytesRead = recvIntoBuffer();
+            if(bytesRead < 0){
+                return errno == ETIME ? POLLTIMEDOUT : BADRECV;
+            }
+            else if(bytesRead == 0){
+                return READCLOSE;
+            }
+            continue;
+        }
+        int val = poll(readfd, 1, POLLTIMER);
+        if(val == 0){
+            return POLLTIMEDOUT;
+        }
+        else if(val < 0){
+            // Not sure what happens when poll comes out negative
+            // from the documentation
+            throw std::runtime_error(std::string("Oh lord please help me\n") + 
+                                     "error value: " + std::strerror(errno) + "\n" + 
+                                     "when polling\n" + 
+                                     "in fillBuffer() of socketLib.hpp");
+        }
+        if(!(readfd[0].revents & POLLIN)){
+            //POLLHUP or POLLERR without anything left to read
+            return READCLOSE;
+        }
+        ssize_t bytesRead = recvIntoBuffer();
+        if(bytesRead < 0){
+            //socket gives error
+            return BADRECV;
+        }
+        else if(bytesRead == 0){
+            //socket disconnected
+            return READCLOSE;
+        }
+    }
+    return 1;
+}
+
+template<typename Codec>
+ssize_t socketstuffs::BasicClient<Codec>::recvIntoBuffer(int flags){
+    //all of the free space, as (up to) two pieces
+    ringbuffer::WritableRegions regions = buffer->prepare(buffer->capacity());
+    struct iovec pieces[2];
+    int pieceCount = 0;
+    for(const std::span<char>& region : regions){
+        if(!region.empty()){
+            pieces[pieceCount].iov_base = region.data();
+            pieces[pieceCount].iov_len = region.size();
+            pieceCount++;
+        }
+    }
+    if(pieceCount == 0){
+        //defensive programming: fillBuffer() and the reader only
+        // call this when there is room
+        throw std::runtime_error("FATAL ERROR: there is no room in the buffer to recv into\n"
+                                    "in recvIntoBuffer() of Client class in socketLib.hpp");
+    }
+    ssize_t bytesRead;
+    if(transport.isOpen()){
+        //copies out of what the kernel already received,
+        // MSG_DONTWAIT -> don't wait for more if there's nothing
+        std::span<char> spans[2] = {regions[0], regions[1]};
+        bytesRead = transport.recv(spans, (flags & MSG_DONTWAIT) ? 0 : POLLTIMER);
+    }
+    else{
+        struct msghdr header = {};
+        header.msg_iov = pieces;
+        header.msg_iovlen = pieceCount;
+        bytesRead = recvmsg(clientfd[0].fd, &header, flags);
+    }
+    if(bytesRead > 0){
+        buffer->commit(bytesRead);
+    }
+    return bytesRead;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::growBuffer(size_t needed){
+    if(needed > MAXBUFFERSIZE){
+        return MSGTOOBIG;
+    }
+    if(needed > INITIALBUFFERSIZE){
+        lastBigPacket = std::chrono::steady_clock::now();
+    }
+    size_t newCapacity = buffer->capacity();
+    if(newCapacity >= needed){
+        return 1;
+    }
+    while(newCapacity < needed){
+        newCapacity *= 2;
+    }
+    buffer->resize(std::min(newCapacity, (size_t)MAXBUFFERSIZE));
+    return 1;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::shrinkIfIdle(){
+    //the reader thread is pushing into it, so leave it alone
+    if(!buffer || readerRunning.load(std::memory_order_relaxed)){
+        return 0;
+    }
+    if(buffer->capacity() <= INITIALBUFFERSIZE 
+        || buffer->size() > INITIALBUFFERSIZE
+        || std::chrono::steady_clock::now() - lastBigPacket < idleShrinkTime){
+        return 0;
+    }
+    buffer->resize(INITIALBUFFERSIZE);
+    return 1;
+}
+
+template<typename Codec>
+void socketstuffs::BasicClient<Codec>::setIdleShrinkTime(std::chrono::milliseconds idleTime){
+    idleShrinkTime = idleTime;
+}
+
+template<typename Codec>
+size_t socketstuffs::BasicClient<Codec>::getBufferMemory(){
+    if(!buffer){
+        return 0;
+    }
+    return buffer->capacity();
+}
+
+template<typename Codec>
+void socketstuffs::BasicClient<Codec>::wakeReaderWaiters(){
+    //taking the lock makes sure the other side is either still
+    // going to look at the ring, or already waiting to be told
+    { std::lock_guard<std::mutex> guard(readerLock); }
+    readerWake.notify_all();
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::waitForBuffer(size_t needed){
+    //the reader might be waiting for room that was made since
+    wakeReaderWaiters();
+
+    int status = 1;
+    std::unique_lock<std::mutex> guard(readerLock);
+    bool enough = readerWake.wait_for(guard, std::chrono::milliseconds(POLLTIMER), [this, needed, &status]{
+        //check the status before the size, the reader pushes whatever
+        // it got before it reports an error
+        status = readerStatus.load(std::memory_order_acquire);
+        return buffer->size() >= needed || status != 1;
+    });
+    if(buffer->size() >= needed){
+        return 1;
+    }
+    return enough ? status : POLLTIMEDOUT;
+}
+
+template<typename Codec>
+void socketstuffs::BasicClient<Codec>::readerLoop(){
+    struct pollfd readfd[1];
+    readfd[0].fd = clientfd[0].fd;
+    readfd[0].events = POLLIN;
+
+    //whatever the reader stops on, the consumer is told
+    auto stopWith = [this](int error){
+        readerStatus.store(error, std::memory_order_release);
+        wakeReaderWaiters();
+    };
+
+    while(readerRunning.load(std::memory_order_relaxed)){
+        //if the consumer is behind, sleep until it wants more 
+        // (waitForBuffer() wakes this up), checking for stopReader()
+        // every READERPOLLTIMER
+        if(buffer->size() == buffer->capacity()){
+            std::unique_lock<std::mutex> guard(readerLock);
+            readerWake.wait_for(guard, std::chrono::milliseconds(READERPOLLTIMER), [this]{
+                return buffer->size() < buffer->capacity() 
+                        || !readerRunning.load(std::memory_order_relaxed);
+            });
+            continue;
+        }
+        int val = poll(readfd, 1, READERPOLLTIMER);
+        if(val == 0){
+            continue;
+        }
+        else if(val < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            stopWith(UNKNOWNPOLLRESULT);
+            return;
+        }
+        if(!(readfd[0].revents & POLLIN)){
+            stopWith(READCLOSE);
+            return;
+        }
+        ssize_t bytesRead = recvIntoBuffer();
+        if(bytesRead < 0){
+            stopWith(BADRECV);
+            return;
+        }
+        else if(bytesRead == 0){
+            stopWith(READCLOSE);
+            return;
+        }
+        wakeReaderWaiters();
+    }
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::startReader(){
+    if(ringType != ringbuffer::SPSC || transport.isOpen()){
+        return BADRINGTYPE;
+    }
+    if(clientfd[0].fd == -1){
+        return NOTOPENED;
+    }
+    if(readerRunning.load()){
+        if(readerStatus.load() == 1){
+            return 1;
+        }
+        //it stopped on an error by itself, join it before
+        // starting a new one
+        stopReader();
+    }
+    readerStatus.store(1);
+    readerRunning.store(true);
+    reader = std::thread(&BasicClient::readerLoop, this);
+    return 1;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::stopReader(){
+    readerRunning.store(false);
+    wakeReaderWaiters();
+    if(reader.joinable()){
+        reader.join();
+    }
+    return 1;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::useUring(unsigned bufferCount, size_t bufferSize){
+    if(clientfd[0].fd == -1){
+        return NOTOPENED;
+    }
+    if(readerRunning.load()){
+        return BADRINGTYPE;
+    }
+    if(transport.isOpen()){
+        return 1;
+    }
+    if(transport.open(clientfd[0].fd, bufferCount, bufferSize) != 1){
+        return NOURING;
+    }
+    return 1;
+}
+
+template<typename Codec>
+bool socketstuffs::BasicClient<Codec>::usingUring(){
+    return transport.isOpen();
+}
+
+template<typename Codec>
+void socketstuffs::BasicClient<Codec>::peekHeader(typename Codec::Header& header){
+    size_t copied = 0;
+    ringbuffer::Regions headerBytes = buffer->peek(0, Codec::HEADERSIZE);
+    for(const std::span<const char>& region : headerBytes){
+        std::memcpy(header.data() + copied, region.data(), region.size());
+        copied += region.size();
+    }
+}
+
+template<typename Codec>
+void socketstuffs::BasicClient<Codec>::popRaw(std::string& message, size_t messageSize){
+    int val = buffer->pop(message, messageSize);
+    if(val != 1){
+        //This shouldnt be possible because parsePacket() checks
+        // the whole packet is there first
+        // something else is touching this so 
+        //throw a runtime_error
+        throw std::runtime_error("FATAL ERROR: This shouldn't have happened\n"
+                                    "in after we check if buffer holds the right amount of bytes\n"
+                                    "for grabbing the whole message\n"
+                                    "in popMessage() of Client class in socketLib.hpp");
+    }
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::popMessage(std::string& message, size_t messageSize, bool compressed){
+    if(!compressed){
+        popRaw(message, messageSize);
+        return 1;
+    }
+    recvScratch.clear();
+    popRaw(recvScratch, messageSize);
+    //decompress() appends, and message still holds the last packet
+    message.clear();
+    if(compression::decompress(recvScratch, message, Codec::MAXMESSAGE) != 1){
+        return BADCOMPRESSION;
+    }
+    return 1;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::popMessage(bufferpool::PooledBuffer& message, size_t messageSize, bool compressed){
+    //whatever the handle held goes back first, so a handle that's
+    // reused for every packet keeps getting its own buffer back
+    message.release();
+    if(!compressed){
+        //a buffer of the right size class that some earlier packet gave back
+        message = pool.get(messageSize);
+        popRaw(message.str(), messageSize);
+        return 1;
+    }
+    recvScratch.clear();
+    popRaw(recvScratch, messageSize);
+    //the prefix says how big it gets, so the pool can hand out the right class
+    uint32_t originalSize = compression::originalSize(recvScratch);
+    if(originalSize > Codec::MAXMESSAGE){
+        return BADCOMPRESSION;
+    }
+    message = pool.get(originalSize);
+    if(compression::decompress(recvScratch, message.str(), Codec::MAXMESSAGE) != 1){
+        return BADCOMPRESSION;
+    }
+    return 1;
+}
+
+template<typename Codec>
+template<typename Message>
+int socketstuffs::BasicClient<Codec>::parsePacket(framing::FrameId& id, Message& message, size_t& needed){
+    /*>>The header (message size + ID) of the message<<*/
+    // nothing gets popped until the whole packet is here, so a 
+    // POLLTIMEDOUT doesn't lose what was already received
+    if(buffer->size() < Codec::HEADERSIZE){
+        needed = Codec::HEADERSIZE;
+        return 0;
+    }
+
+    //copy the header out (it's a fixed array, nothing allocates)
+    typename Codec::Header header;
+    peekHeader(header);
+    uint32_t messageSize = Codec::decodeSize(header);
+    if(!Codec::messageFits(messageSize)){
+        recvBroken = true;
+        return MSGTOOBIG;
+    }
+
+    /*>>The message part of the message<<*/
+    int val = growBuffer(Codec::HEADERSIZE + messageSize);
+    if(val != 1){
+        recvBroken = true;
+        return val;
+    }
+    if(buffer->size() < Codec::HEADERSIZE + messageSize){
+        needed = Codec::HEADERSIZE + messageSize;
+        return 0;
+    }
+
+    /*>>The ID part of the message<<*/
+    id = Codec::decodeFrameId(header);
+
+    buffer->consume(Codec::HEADERSIZE);
+    return popMessage(message, messageSize, Codec::isCompressed(header));
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::getPacket(std::string& id, std::string& message){
+    framing::FrameId frameId;
+    int val = getPacket(frameId, message);
+    if(val == 1){
+        id.assign(frameId.view());
+    }
+    return val;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::getPacket(framing::FrameId& id, std::string& message){
+    return receivePacket(id, message);
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::getPacket(framing::FrameId& id, bufferpool::PooledBuffer& message){
+    return receivePacket(id, message);
+}
+
+template<typename Codec>
+template<typename Message>
+int socketstuffs::BasicClient<Codec>::receivePacket(framing::FrameId& id, Message& message){
+    if(clientfd[0].fd == -1){
+        throw std::runtime_error("ERROR: client fd is bad (client is not connected)\n"
+                                 "in getPacket() in Client in socketLib.hpp");
+    }
+    if(recvBroken){
+        return BADRECV;
+    }
+    if(streaming || decoder.inProgress()){
+        return MIDSTREAM;
+    }
+
+    shrinkIfIdle();
+
+    size_t needed = 0;
+    while(true){
+        int val = parsePacket(id, message, needed);
+        if(val != 0){
+            return val;
+        }
+        val = fillBuffer(needed);
+        if(val != 1){
+            return val;
+        }
+    }
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::getPackets(std::vector<Frame>& out, size_t max){
+    return receivePackets(out, max);
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::getPackets(std::vector<PooledFrame>& out, size_t max){
+    return receivePackets(out, max);
+}
+
+template<typename Codec>
+template<typename FrameType>
+int socketstuffs::BasicClient<Codec>::receivePackets(std::vector<FrameType>& out, size_t max){
+    if(clientfd[0].fd == -1){
+        throw std::runtime_error("ERROR: client fd is bad (client is not connected)\n"
+                                 "in getPackets() in Client in socketLib.hpp");
+    }
+    if(recvBroken){
+        return BADRECV;
+    }
+    if(streaming || decoder.inProgress()){
+        return MIDSTREAM;
+    }
+
+    shrinkIfIdle();
+
+    int count = 0;
+    size_t needed = 0;
+    FrameType frame;
+    while((size_t)count < max){
+        int val = parsePacket(frame.id, frame.message, needed);
+        if(val == 1){
+            out.push_back(std::move(frame));
+            frame = FrameType();
+            count++;
+            continue;
+        }
+        if(val == BADCOMPRESSION){
+            //that packet is already gone, so it can't wait for the next
+            // call (the ones before it are still in out, see the header)
+            return val;
+        }
+        if(val != 0){
+            //hand back what we already got, the error shows up next call
+            return count > 0 ? count : val;
+        }
+        if(count > 0){
+            //only wait when we have nothing to give back
+            break;
+        }
+        //readv() takes everything that fits, so this one read 
+        // usually brings in a whole burst of packets
+        val = fillBuffer(needed);
+        if(val != 1){
+            return val;
+        }
+    }
+    return count;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::getPacketStream(std::string& id, 
+                                            const std::function<void(std::span<const char>)>& onChunk){
+    if(clientfd[0].fd == -1){
+        throw std::runtime_error("ERROR: client fd is bad (client is not connected)\n"
+                                 "in getPacketStream() in Client in socketLib.hpp");
+    }
+    if(recvBroken){
+        return BADRECV;
+    }
+    if(decoder.inProgress()){
+        return MIDSTREAM;
+    }
+
+    if(!streaming){
+        shrinkIfIdle();
+
+        /*>>The header (message size + ID) of the message<<*/
+        if(buffer->size() < Codec::HEADERSIZE){
+            int val = fillBuffer(Codec::HEADERSIZE);
+            if(val != 1){
+                return val;
+            }
+        }
+        typename Codec::Header header;
+        peekHeader(header);
+        uint32_t messageSize = Codec::decodeSize(header);
+        if(!Codec::messageFits(messageSize)){
+            //the header stays where it is, nothing reads past it
+            recvBroken = true;
+            return MSGTOOBIG;
+        }
+        streamId = Codec::decodeFrameId(header);
+        buffer->consume(Codec::HEADERSIZE);
+        streamRemaining = messageSize;
+        streamCompressed = Codec::isCompressed(header);
+        streamError = streamCompressed ? inflater.reset() : 1;
+        streaming = true;
+    }
+    id.assign(streamId.view());
+
+    /*>>The message part, handed over as it shows up<<*/
+    // the buffer never has to hold the whole message, 
+    // so it doesn't grow past what one recv() brings in
+    while(true){
+        size_t taken = 0;
+        ringbuffer::Regions regions = buffer->readable_regions();
+        for(const std::span<const char>& region : regions){
+            size_t amount = std::min(region.size(), streamRemaining - taken);
+            if(amount > 0){
+                try{
+                    if(!streamCompressed){
+                        onChunk(region.first(amount));
+                    }
+                    else if(streamError == 1){
+                        //onChunk gets what comes out of zlib instead 
+                        // (after a bad piece the rest is only skipped over)
+                        streamError = inflater.feed(region.first(amount), Codec::MAXMESSAGE, onChunk);
+                    }
+                }
+                catch(...){
+                    //what onChunk was handed counts as delivered, so 
+                    // calling again doesn't hand it over a second time
+                    // (zlib was left partway through a piece, so the
+                    // rest of a compressed message is only skipped)
+                    if(streamCompressed){
+                        streamError = compression::BADDATA;
+                    }
+                    buffer->consume(taken + amount);
+                    streamRemaining -= taken + amount;
+                    throw;
+                }
+                taken += amount;
+            }
+        }
+        buffer->consume(taken);
+        streamRemaining -= taken;
+        if(streamRemaining == 0){
+            break;
+        }
+
+        int val = fillBuffer(1);
+        if(val != 1){
+            //still streaming, calling again picks up where it left off
+            return val;
+        }
+    }
+
+    streaming = false;
+    if(streamCompressed && (streamError != 1 || !inflater.finished())){
+        return BADCOMPRESSION;
+    }
+    return 1;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::tryGetPacket(std::string& id, std::string& message){
+    if(clientfd[0].fd == -1){
+        throw std::runtime_error("ERROR: client fd is bad (client is not connected)\n"
+                                 "in tryGetPacket() in Client in socketLib.hpp");
+    }
+    if(recvBroken){
+        return BADRECV;
+    }
+    if(streaming){
+        return MIDSTREAM;
+    }
+
+    bool triedRecv = false;
+    while(true){
+        //the decoder takes everything that's buffered (up to the end
+        // of a packet), so buffer never has to hold a whole packet
+        ringbuffer::Regions regions = buffer->readable_regions();
+        for(const std::span<const char>& region : regions){
+            if(region.empty()){
+                continue;
+            }
+            size_t used = 0;
+            int val = decoder.feed(region, used);
+            buffer->consume(used);
+            if(val == framing::FRAMEREADY){
+                bool compressed = decoder.isCompressed();
+                if(!compressed){
+                    decoder.take(id, message);
+                    return 1;
+                }
+                decoder.take(id, recvScratch);
+                message.clear();
+                if(compression::decompress(recvScratch, message, Codec::MAXMESSAGE) != 1){
+                    return BADCOMPRESSION;
+                }
+                return 1;
+            }
+            else if(val == framing::BADSIZE){
+                //same as getPacket, nothing after it can be read
+                recvBroken = true;
+                return MSGTOOBIG;
+            }
+        }
+
+        //only one recv() per call, then it's the readiness loop's turn 
+        // again (the reader thread does the recv() calls if it runs)
+        if(readerRunning.load(std::memory_order_relaxed)){
+            int status = readerStatus.load(std::memory_order_acquire);
+            if(status != 1 && buffer->size() > 0){
+                //the reader pushed its last bytes before it stopped
+                continue;
+            }
+            //the reader does the recv() calls, so there's nothing
+            // left for this one to drain (it may be asleep waiting for
+            // the room this call just made)
+            if(status == 1){
+                wakeReaderWaiters();
+            }
+            drained = true;
+            return status != 1 ? status : 0;
+        }
+        if(triedRecv){
+            drained = false;
+            return 0;
+        }
+        ssize_t bytesRead = recvIntoBuffer(MSG_DONTWAIT);
+        triedRecv = true;
+        if(bytesRead < 0){
+            if(errno == EAGAIN || errno == EWOULDBLOCK){
+                drained = true;
+                return 0;
+            }
+            //socket gives error
+            return BADRECV;
+        }
+        else if(bytesRead == 0){
+            //socket disconnected
+            return READCLOSE;
+        }
+    }
+}
+
+template<typename Codec>
+bool socketstuffs::BasicClient<Codec>::isDrained(){
+    return drained;
+}
+
+template<typename Codec>
+bufferpool::BufferPool& socketstuffs::BasicClient<Codec>::getPool(){
+    return pool;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::getFd(){
+    return clientfd[0].fd;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::sendParts(struct iovec* parts, int partCount, bool more){
+    //the first part that still has something left to send
+    int current = 0;
+    while(current < partCount && parts[current].iov_len == 0){
+        current++;
+    }
+
+    while(current < partCount){
+        struct msghdr header = {};
+        header.msg_iov = parts + current;
+        header.msg_iovlen = partCount - current;
+        ssize_t bytesSent;
+        if(transport.isOpen()){
+            //the ring waits for room on its own, so there's no poll()
+            bytesSent = transport.send(&header, more ? MSG_MORE : 0, POLLTIMER);
+            sendCalls++;
+            if(bytesSent == -1){
+                return errno == ETIME ? POLLTIMEDOUT : BADSEND;
+            }
+        }
+        else{
+            //try first, only poll() when the socket is full
+            int flags = MSG_DONTWAIT | (more ? MSG_MORE : 0);
+            bytesSent = sendmsg(clientfd[0].fd, &header, flags);
+            sendCalls++;
+        }
+        if(bytesSent == -1){
+            if(errno != EAGAIN && errno != EWOULDBLOCK){
+                return BADSEND;
+            }
+            //only wait on POLLOUT, incoming bytes shouldn't wake us up
+            struct pollfd writable = {clientfd[0].fd, POLLOUT, 0};
+            int val = poll(&writable, 1, POLLTIMER);
+            sendCalls++;
+            if(val == 0){
+                return POLLTIMEDOUT;
+            }
+            else if(val < 0){
+                // Not sure what happens when poll comes out negative
+                // from the documentation
+                throw std::runtime_error(std::string("Oh lord please help me\n") + 
+                                         "error value: " + std::strerror(errno) + "\n"
+                                         "in sending the packet\n"
+                                         "when polling\n"
+                                         "int sendParts() of socketLib.hpp");
+            }
+            continue;
+        }
+        else if(bytesSent == 0){
+            return SENDCLOSE;
+        }
+
+        //partial write, skip what went out and resume 
+        // from the middle of whichever part it stopped in
+        size_t sent = bytesSent;
+        while(current < partCount && sent >= parts[current].iov_len){
+            sent -= parts[current].iov_len;
+            current++;
+        }
+        if(current < partCount){
+            parts[current].iov_base = (char*)parts[current].iov_base + sent;
+            parts[current].iov_len -= sent;
+        }
+    }
+
+    return 1;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::sendPacket(const std::string& id, const std::string& message){
+    if(!framing::FrameId::fits(id)){
+        return IDTOOBIG;
+    }
+    return sendPacket(framing::FrameId(id), message);
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::sendPacket(const framing::FrameId& id, const std::string& message){
+    if(clientfd[0].fd == -1){
+        throw std::runtime_error("ERROR: client fd is bad (client is not connected)\n"
+                                 "in sendPacket() in Client in socketLib.hpp");
+    }
+
+    if(!Codec::messageFits(message.size())){
+        return MSGTOOBIG;
+    }
+
+    std::string_view body = message;
+    bool compressed = false;
+    if(compressThreshold > 0 && message.size() >= compressThreshold){
+        //only worth it if it actually came out smaller
+        if(compression::compress(message, sendScratch, compressLevel) == 1
+                && sendScratch.size() < message.size()){
+            body = sendScratch;
+            compressed = true;
+        }
+    }
+
+    //the header is built on the stack, the message goes out 
+    // straight from the caller's string (no packet copy)
+    typename Codec::Header header;
+    Codec::encode(header, body.size(), id, compressed);
+
+    struct iovec parts[2];
+    parts[0].iov_base = header.data();
+    parts[0].iov_len = header.size();
+    parts[1].iov_base = const_cast<char*>(body.data());
+    parts[1].iov_len = body.size();
+
+    return sendParts(parts, 2, false);
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::sendPackets(std::span<const OutFrame> frames){
+    if(clientfd[0].fd == -1){
+        throw std::runtime_error("ERROR: client fd is bad (client is not connected)\n"
+                                 "in sendPackets() in Client in socketLib.hpp");
+    }
+
+    for(const OutFrame& frame : frames){
+        if(!Codec::messageFits(frame.message.size())){
+            return MSGTOOBIG;
+        }
+        if(!Codec::idFits(frame.id.size())){
+            return IDTOOBIG;
+        }
+    }
+
+    typename Codec::Header headers[MAXSENDBATCH];
+    struct iovec parts[2 * MAXSENDBATCH];
+    for(size_t first = 0;first < frames.size();first += MAXSENDBATCH){
+        size_t count = std::min<size_t>(MAXSENDBATCH, frames.size() - first);
+        for(size_t i = 0;i<count;i++){
+            const OutFrame& frame = frames[first + i];
+            Codec::encode(headers[i], frame.message.size(), frame.id);
+            parts[2*i].iov_base = headers[i].data();
+            parts[2*i].iov_len = headers[i].size();
+            parts[2*i + 1].iov_base = const_cast<char*>(frame.message.data());
+            parts[2*i + 1].iov_len = frame.message.size();
+        }
+        bool more = first + count < frames.size();
+        int res = sendParts(parts, 2 * count, more);
+        if(res != 1){
+            return res;
+        }
+    }
+
+    return 1;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::sendFilePacket(const std::string& id, int fileFd,
+                                            off_t offset, size_t length){
+    if(clientfd[0].fd == -1){
+        throw std::runtime_error("ERROR: client fd is bad (client is not connected)\n"
+                                 "in sendFilePacket() in Client in socketLib.hpp");
+    }
+
+    if(!Codec::messageFits(length)){
+        return MSGTOOBIG;
+    }
+    if(!Codec::idFits(id.size())){
+        return IDTOOBIG;
+    }
+    //a short file would leave the peer waiting on a half sent packet,
+    // so check before the header goes out
+    struct stat fileStat;
+    if(offset < 0 || fstat(fileFd, &fileStat) == -1 
+        || (size_t)fileStat.st_size < (size_t)offset + length){
+        return BADFILE;
+    }
+
+    typename Codec::Header header;
+    Codec::encode(header, length, id);
+    struct iovec parts[1];
+    parts[0].iov_base = header.data();
+    parts[0].iov_len = header.size();
+    //MSG_MORE so the header shares a segment with the start of the body
+    int res = sendParts(parts, 1, length > 0);
+    if(res != 1){
+        return res;
+    }
+
+    size_t remaining = length;
+    while(remaining > 0){
+        struct pollfd writable = {clientfd[0].fd, POLLOUT, 0};
+        int val = poll(&writable, 1, POLLTIMER);
+        sendCalls++;
+        if(val == 0){
+            return POLLTIMEDOUT;
+        }
+        else if(val < 0){
+            // Not sure what happens when poll comes out negative
+            // from the documentation
+            throw std::runtime_error(std::string("Oh lord please help me\n") + 
+                                     "error value: " + std::strerror(errno) + "\n"
+                                     "in sending the file\n"
+                                     "when polling\n"
+                                     "int sendFilePacket() of socketLib.hpp");
+        }
+
+        //sendfile() moves offset along by itself
+        ssize_t bytesSent = sendfile(clientfd[0].fd, fileFd, &offset, remaining);
+        sendCalls++;
+        if(bytesSent == -1){
+            if(errno == EAGAIN || errno == EWOULDBLOCK){
+                continue;
+            }
+            return BADSEND;
+        }
+        else if(bytesSent == 0){
+            //the file got shorter after we checked it
+            return BADFILE;
+        }
+        remaining -= bytesSent;
+    }
+
+    return 1;
+}
+
+template<typename Codec>
+void socketstuffs::BasicClient<Codec>::setCompression(size_t threshold, int level){
+    compressThreshold = threshold;
+    compressLevel = level;
+}
+
+template<typename Codec>
+uint64_t socketstuffs::BasicClient<Codec>::getSendCalls(){
+    return sendCalls;
+}
+
+template<typename Codec>
+int socketstuffs::BasicClient<Codec>::closeIt(){
+    stopReader();
+    //before the fd goes, the ring's recv is still on it
+    transport.closeIt();
+
+    if(clientfd[0].fd != -1){
+        close(clientfd[0].fd);
+        clientfd[0].fd = -1;
+    }
+    //a buffer that grew isn't held on to for the next connection
+    // (one at the starting size is, see prepareConnection())
+    if(buffer && ringType != ringbuffer::SPSC && buffer->capacity() > INITIALBUFFERSIZE){
+        buffer.reset();
+    }
+
+    return 1;
+}
+
+/* Connection stuff */
+int socketstuffs::connectClient(Socket& s, Client& c, history::History& record){
+    std::vector<int> validPorts;
+    int res;
+    res = getValidScannedPorts(9000, 9100, validPorts);
+    if(res == socketstuffs::NONEMPTYVECTOR) { // defensive programming
+        throw std::logic_error(std::string("Please don't do this to me\n") + 
+                            "in getting validScannedPorts()\n" +
+                            "in the state INIT in job() in socketLib.cpp");
+    }
+    int index = 0;
+    record.addMessage(std::string("Attempting to open a socket at port ") + std::to_string(validPorts[index]));
+    res = s.openIt(validPorts[index]);
+    while(res != 1){
+        record.addMessage(">>Failed at this port:");
+        if(res == socketstuffs::INVALIDPORT){ // defensive programming
+            record.addMessage("\t- This port was invalid");
+        }
+        else if(res == socketstuffs::ALREADYOPEN){
+            record.addMessage("\t- This port is already used");
+        }
+        index++;
+        res = s.openIt(validPorts[index]);
+    }
+    if(res != 1){
+        throw std::runtime_error(std::string("Failed to open a socket in the port range (9000-9100)"));
+    }
+    record.addMessage("Attempting to connect to a client");
+    res = c.connectIt(s);
+    if(res == socketstuffs::UNKNOWNPOLLRESULT){
+        record.addMessage("Failed to connect to a client");
+        record.addMessage("The errno message is:");
+        record.addMessage(std::string("\t") + std::strerror(errno));
+        throw std::runtime_error(std::string("Oh I'm a gummy bear\n") + 
+                                "When I wanted to connect to client\n" + 
+                                "in the state OPEN in job in socketLib.cpp");
+    }
+    record.addMessage(">>>>Client connected successfully");
+    return 1;
+}
+
+int socketstuffs::sendQuery(const framing::FrameId& id, 
+                            const std::string& query, 
+                            Client& c, 
+                            history::History& record,
+                            std::string& response){
+    //first we send
+    record.addMessage(std::string("Trying to send message: ") + query + "\n" + 
+                    "\t> From " + id.toString() + "\n");
+    int res = c.sendPacket(id, query);
+    if(res == socketstuffs::MSGTOOBIG){
+        /*
+        throw std::runtime_error(std::string("You gave a message that's too big\n")+
+                                "when trying to send a query\n" + 
+                                "in sendQuery() function of socketLib.cpp");
+        */
+        //Not sure if crashing on bad message is a good idea
+        //The input is wrong, so we should be continuing 
+        record.addMessage(std::string("SEND ERROR: Message to big! Query size is ") + std::to_string(query.size()) + "\n" + 
+                        "In sendQuery() function in socketLib.cpp");
+        return socketstuffs::SENDERROR;
+    }
+    else if(res == socketstuffs::POLLTIMEDOUT){
+        /*
+        //not sure why this happens
+        //awaiting until someone encounters this
+        throw std::runtime_error(std::string("Somehow got that the socket poll() lagged out\n")+
+                                "while sending a message over the internet\n" + 
+                                "in sendQuery() function of socketLib.cpp");
+        */    
+        record.addMessage(std::string("SEND ERROR: Poll timed out in sending\n") + 
+                        "In sendQuery() function in socketLib.cpp");
+        return socketstuffs::SENDERROR;
+    }
+    record.addMessage(std::string(">>>>Message sent successfully\n"));
+
+    //now we wait
+    record.addMessage(std::string("Awaiting a response from the client\n") + 
+                    "I'm willing to wait " + std::to_string(socketstuffs::POLLTIMER/1000) + " secs\n");
+    //getPacket() appends, and clearing keeps the capacity, so a
+    // response string that is reused (like Connection's lastOutput)
+    // stops allocating once it has seen its biggest response
+    framing::FrameId responseID;
+    response.clear();
+    res = c.getPacket(responseID, response);
+    if(res == socketstuffs::POLLTIMEDOUT){
+        /*
+        //not sure why this happens
+        //awaiting until someone encounters this
+        throw std::runtime_error(std::string("got poll lag again\n"
+                                            "while trying to get a message over the internet\n"
+                                            "in sendQuery() function of socketLib.cpp"))
+        */
+        //I'm not sure if crashing on an empty poll is a good idea
+        // we should instead return a different value
+        record.addMessage(std::string(">>>>Got a bad poll response"));
+        return -1;
+    }
+    record.addMessage(std::string(">>>>Response received successfully: ") + response);
+
+    return 1;
+}
+
+int socketstuffs::verifyConnection(Client& c, history::History& record){
+    //first we send
+    record.addMessage(std::string("Trying to send message: ") + "PING\n" + 
+                    "\t> From SYS \n");
+    int res = c.sendPacket("SYS", "PING");
+    if(res == socketstuffs::MSGTOOBIG){
+        /*
+        throw std::runtime_error(std::string("You're telling me PING is too big?\n")+
+                                "when trying to send a query\n" + 
+                                "in verifyConnection() function of socketLib.cpp");
+        */
+        //Not sure if crashing on bad message is a good idea
+        record.addMessage(std::string("SEND ERROR: Message to big! Query size is ") + std::to_string(4) + "\n" + 
+                        "In verifyConnection() function in socketLib.cpp");
+        return socketstuffs::SENDERROR;
+    }
+    else if(res == socketstuffs::POLLTIMEDOUT){
+        /* 
+        //not sure why this happens
+        //awaiting until someone encounters this
+        throw std::runtime_error(std::string("Somehow got that the socket poll() lagged out\n")+
+                                "while sending \"PING\" over the internet\n" + 
+                                "in verifyConnection() function of socketLib.cpp");
+        */
+        //Don't want to crash on a bad poll but the user should know
+        // the connection may be buggin out
+        record.addMessage(std::string("SEND ERROR: Poll timed out in sending\n") + 
+                        "In verifyConnection() function in socketLib.cpp");
+        return socketstuffs::SENDERROR;
+    }
+    record.addMessage(std::string("Sent PING successfully\n"));
+
+    //now we wait
+    record.addMessage(std::string("Awaiting a response from the client\n") + 
+                    "I'm willing to wait " + std::to_string(socketstuffs::POLLTIMER/1000) + " secs\n");
+    std::string response;
+    framing::FrameId responseID;
+    res = c.getPacket(responseID, response);
+    if(res == socketstuffs::POLLTIMEDOUT){
+        /*
+        //not sure why this happens
+        //awaiting until someone encounters this
+        throw std::runtime_error(std::string("got poll lag again\n"
+                                            "while trying to get a message over the internet\n"
+                                            "in sendQuery() function of socketLib.cpp"))
+        */
+        //Don't want to crash on a bad poll but the user should know
+        // the connection may be buggin out
+        record.addMessage(std::string(">>>>Got a bad poll response"));
+        return -1;
+    }
+    if(response != "PONG"){
+        record.addMessage(std::string("You did not get PONG!. Instead, I got: \n") + 
+                                    "\t>> " + response);
+        return -1;
+    }
+    
+    return 1;
+}
+
+socketstuffs::Connection::Connection() : msgQueue(MSGQUEUESIZE){
+    state = socketstuffs::INIT;
+    lastOutput = "";
+}
+
+void socketstuffs::Connection::start(){
+    connectClient(s, c, record);
+    state = socketstuffs::IDLE;
+}
+
+int socketstuffs::Connection::input(std::vector<std::string>& args){
+    if(args.size() != 2){
+        /*
+        //Since it is the USER's fault, instead of a crash
+        //we need to DISPLAY to the user that the input was bad
+        throw invalid_argument(std::string("invalid argument size. number of arguments must be 2.\n") + 
+                                "Got a vector of size: " + std::to_string(args.size()) + "\n" + 
+                                "for input() function in socketLib.hpp");
+        */
+        record.addMessage(std::string("Invalid argument size. Number of arguments must be 2.\n") + 
+                        + "Got a vector f size: " + std::to_string(args.size()) + "\n" + 
+                        + "for input() function in socketLib.hpp");
+        return socketstuffs::BADINPUTERROR;
+    }
+    return enqueue(args[0], args[1], false);
+}
+
+int socketstuffs::Connection::enqueue(const std::string& id, const std::string& message, bool wait){
+    if(!framing::FrameId::fits(id)){
+        record.addMessage(std::string("The first argument (ID) is longer than 13 characters\n") + 
+                            "> it is " + std::to_string(id.size()) + " characters long\n" +
+                            "in enqueue() function in socketLib.hpp");
+        return socketstuffs::BADINPUTERROR;
+    }
+    if(message.size() > sharedstuff::Megabyte) {
+        record.addMessage(std::string("The message part of the argument exceeds the maximum message length (") + std::to_string(sharedstuff::Megabyte) + ")\n" + 
+                                    "the message size is " + std::to_string(message.size()) + "\n" + 
+                                    "in enqueue function in socketLib.hpp");
+        return socketstuffs::BADINPUTERROR;
+    }
+    if(message.size() == 0){
+        record.addMessage(std::string("Don't send an empty body\n") +
+                            "in enqueue function in socketLib.hpp");
+        return socketstuffs::BADINPUTERROR;
+    }
+
+    framing::FrameId frameId(id);
+    if(wait){
+        msgQueue.push(std::make_pair(frameId, message));
+    }
+    else if(!msgQueue.tryPush(std::make_pair(frameId, message))){
+        record.addMessage(std::string("The queue is full (") + std::to_string(msgQueue.capacity()) + " queries). Wait until job() catches up\n" + 
+                            "in enqueue function in socketLib.hpp");
+        return socketstuffs::QUEUEFULL;
+    }
+    record.addMessage(std::string("Got message! From: ") + id + "\n" +
+                        ">>" + message);
+    return 1;
+}
+
+size_t socketstuffs::Connection::getQueueDepth(){
+    return msgQueue.size();
+}
+
+void socketstuffs::Connection::exit(){
+    c.closeIt();
+    s.closeIt();
+}
+
+void socketstuffs::Connection::job() {
+    if(state == socketstuffs::IDLE){
+        //This part is mostly just doing idle things until we get an input
+        // maybe we try verifyConnection() in order to not let it die?
+        if(msgQueue.popBatch(batch, MAXJOBBATCH) > 0){
+            state = socketstuffs::BUSY;
+        }
+    }
+    if(state == socketstuffs::BUSY){
+        for(const std::pair<framing::FrameId, std::string>& query : batch){
+            //sendQuery() reuses response, so it stops allocating
+            int res = sendQuery(query.first, query.second, c, record, response);
+            {
+                std::lock_guard<std::mutex> guard(outputLock);
+                lastOutput = response;
+                if(res == 1){
+                    outputs.push_back(Frame{query.first, response});
+                }
+            }
+            if(res == -1){
+                record.addMessage(std::string("Didn't get a response from sendQuery\n") +
+                                    "in job() in socketLib.hpp");
+            }
+            else if(res == socketstuffs::SENDERROR){
+                record.addMessage(std::string("Wasn't able to send in sendQuery\n") +
+                                    "in job() in socketLib.cpp");
+            }
+        }
+        batch.clear();
+        state = socketstuffs::IDLE;
+    }
+}
+
+std::string socketstuffs::Connection::getLastOutput(){
+    std::lock_guard<std::mutex> guard(outputLock);
+    if(lastOutput == ""){
+        return ">@EMPTY@<";
+    }
+
+    return lastOutput;
+}
+
+size_t socketstuffs::Connection::getOutputs(std::vector<Frame>& out){
+    std::lock_guard<std::mutex> guard(outputLock);
+    size_t count = outputs.size();
+    for(Frame& output : outputs){
+        out.push_back(std::move(output));
+    }
+    outputs.clear();
+    return count;
+}
+
+std::list<std::string> socketstuffs::Connection::getRecord(){
+    return record.getMessage();
+}
+
+//the only codecs a Client can be made with
+template class socketstuffs::BasicClient<framing::DefaultCodec>;
+template class socketstuffs::BasicClient<framing::WideCodec>;
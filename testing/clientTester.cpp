@@ -1,357 +1,1130 @@
-#include "errorCPPPort.hpp"
-#include "socketLib.hpp"
-#include "testingSuite.hpp"
-
-
-#include <vector>
-#include <thread>
-#include <chrono>
-
-const int initTime = 3;
-const int communicateTime = 1;
-
-const std::string FILENAME = "clientTester.cpp";
-
-void initTest(testing::TestSuite& t, std::thread& pythonJob, const std::string& testName){
-    t = testing::TestSuite(testName, FILENAME);
-    pythonJob = std::thread(testing::runPythonThread);
-    std::cout << "Starting up the python thread\n"
-            << "Let it start up for " << initTime << " seconds"
-            << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(initTime));
-}
-
-void pauseForPython(const std::string& pauseReason, int time){
-    std::cout << "STATUS: ---PAUSE--- We are pausing for: " << pauseReason << std::endl;
-    std::cout << "\t>>Let's wait for " << time << " seconds" << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(time));
-}
-
-void finalizeTest(testing::TestSuite& t, std::thread& pythonJob){
-    testing::sendCommand("quit");
-    pythonJob.join();
-    t.printFinalOutput();
-}
-
-void clientConnectionTests(){
-    testing::TestSuite t;
-    std::thread pythonJob;
-    initTest(t, pythonJob, "Client Connections Test");
-
-    std::string command;
-    int res;
-    int pyRes;
-
-    socketstuffs::Socket s;
-
-    std::vector<int> validPorts;
-    int ret = socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
-    if(ret == socketstuffs::NONEMPTYVECTOR){
-        //this shouldn't happen
-        //I also shouldn't be consistently putting up vague
-        // depressing messages on impossible errors
-        //I won't know which is which
-        std::cout << "just .... end me now\n" 
-                    "Alright fine, this is in clientTester.cpp"
-                    << std::endl;
-        return;
-    }
-
-    // socket open
-    std::cout << "STATUS: Attempting socket connect" << std::endl;
-    size_t index = 0;
-    ret = s.openIt(validPorts[index]);
-    while(ret == socketstuffs::INVALIDPORT){
-        std::cout << "again, how?!?\n" 
-                    << "checked: " << index << std::endl
-                    << "in the socket open test of clientTester.cpp"
-                    << std::endl;
-        index++;
-        if(index >= validPorts.size()){
-            throw std::runtime_error("IM DONE!!!! (in clientTester.cpp)");
-        }
-        ret = s.openIt(validPorts[index]);
-    }
-    std::cout << "STATUS: socket opened on " << s.getPort() << std::endl;
-
-    //client connection
-    std::cout << "STATUS: attempting client connection" << std::endl;
-    socketstuffs::Client c;
-    command = "connect@" + std::to_string(s.getPort());
-    testing::sendCommand(command);
-    std::cout << "sent \"connect\" command at port " << s.getPort() << "\n"
-                << "Let it wait for " << communicateTime << " seconds"
-                << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(communicateTime));
-
-    ret = c.connectIt(s);
-    if(ret == socketstuffs::POLLTIMEDOUT){
-        std::cout << "Poll timed out!" << std::endl; 
-        throw std::domain_error("We should not have polled out, client did not connect");
-    }
-    else if(ret == socketstuffs::UNKNOWNPOLLRESULT){
-        std::cout << "Got some negative poll value?" << std::endl;
-        std::cout << "Oh. let's check it out: " <<std::endl;
-        std::cout << "\t>>" << strerror(errno) << std::endl;
-        throw std::runtime_error("Got negative poll value!");
-    }
-    else{
-        std::cout << "STATUS: client connected"  << std::endl;
-    }
-    pyRes = testing::readResult();
-
-    t.test("simple client connection test to valid socket", ret == 1
-                                                        && pyRes == testing::SUCCESS);
-
-
-    // Python-side disconnect test
-    command = "disconnect";
-    testing::sendCommand(command);
-    std::cout << "sent \"disconnect\" command\n"
-                << "Let it wait for " << initTime<< " seconds"
-                << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(initTime));
-    res = testing::readResult();
-    if(res == -1){
-        std::cout << "Error in Python-side disconnection test\n"
-            << "did not find file for disconnect command"
-            << std::endl;
-    }
-    t.test("Python-side disconnection from client", res == testing::SUCCESS);
-
-    // Python reconnection test
-    command = "connect@" + std::to_string(s.getPort());
-    testing::sendCommand(command);
-    std::cout << "sent \"connect\" command at port " << s.getPort() << "\n"
-                << "Let it wait for " << initTime<< " seconds"
-                << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(initTime));
-    ret = c.connectIt(s);
-    if(ret == socketstuffs::POLLTIMEDOUT){
-        std::cout << "Poll timed out!" << std::endl; 
-        throw std::domain_error("We should not have polled out, client did not connect");
-    }
-    else if(ret == socketstuffs::UNKNOWNPOLLRESULT){
-        std::cout << "Got some negative poll value?" << std::endl;
-        std::cout << "Oh. let's check it out: " <<std::endl;
-        std::cout << "\t>>" << strerror(errno) << std::endl;
-        throw std::runtime_error("Got negative poll value!");
-    }
-    else{
-        std::cout << "STATUS: client connected"  << std::endl;
-    }
-    res = testing::readResult();
-    if(res == -1){
-        std::cout << "Error in Python reconnection test\n"
-            << "did not find file for connect command"
-            << std::endl;
-    }
-    t.test("Python reconnection to client", res == testing::SUCCESS);
-
-    std::cout << "CLOSING PROGRAM" << std::endl;
-    c.closeIt();
-    s.closeIt();
-
-    finalizeTest(t, pythonJob);
-}
-
-void clientCommunicationTests(){
-    testing::TestSuite t;
-    std::thread pythonJob;
-    initTest(t, pythonJob, "Client Communications Test");
-
-    std::string id1 = "albert";
-    std::string id2 = "barbara";
-    std::string command;
-    int res, pyRes;
-    std::string sRes;
-
-    std::cout << "STATUS: Test initialized" << std::endl;
-
-    //set up connection amongst the server (this) and the client 
-    // (python port)
-    std::vector<int> validPorts; 
-    res = socketstuffs::getValidScannedPorts(9000, 9010, validPorts);
-    if(res == socketstuffs::NONEMPTYVECTOR){
-        std::cout << "How did we even get here\n"
-                << "in scanning for valid ports\n"
-                << "in the clientConnectionsTests() function in clientTester.cpp"
-                << std::endl;
-        throw std::runtime_error("MEH");
-    }
-    std::cout << "STATUS: Found valid ports" << std::endl;
-    socketstuffs::Socket s;
-    res = s.openIt(validPorts[0]);
-    if(res == socketstuffs::INVALIDPORT){
-        std::cout << "why are we still here....\n"
-                << "in opening the socket\n"
-                << "in the clientConnectionsTests() function in clientTester.cpp"
-                << std::endl;
-        throw std::runtime_error("just to suffer?");
-    }
-
-    std::cout << "STATUS: socket connected" << std::endl;
-    socketstuffs::Client c;
-    command = "connect@" + std::to_string(s.getPort());
-    testing::sendCommand(command);
-    pauseForPython("connect command", communicateTime);
-    res = c.connectIt(s);
-    if(res == socketstuffs::POLLTIMEDOUT){
-        std::cout << "Poll timed out\n"
-                << "in trying to connect to client\n"
-                << "in clientCommunicationsTest() in clientTester.cpp"
-                << std::endl;
-        throw std::runtime_error("Please don't quit on me");
-    }
-    else if(res < 0){
-        throw std::runtime_error(std::string("Poll is negative\n")
-                                + "in clientCommunicationsTest() in clientTester.cpp");
-    }
-    pyRes = testing::readResult(); // obligatory read from sendCommand
-
-    std::cout << "STATUS: client connected" << std::endl;
-
-    //Test 1: simple message [server -> "PING" -> client]
-    std::cout << "===TEST: starting test 1===" << std::endl;
-    res = c.sendPacket(id1, "PING"); 
-    if(res == socketstuffs::MSGTOOBIG){
-        throw std::runtime_error(std::string("Again, please stop with this frizzle\n")
-                                + "in test 1 of\n"
-                                + "clientCommunications() in clientTester.cpp");
-    }
-    std::cout << "sent ping" << std::endl;
-    command = "read@"+id1;
-    testing::sendCommand(command, "PING");
-    pauseForPython("read command", communicateTime);
-    pyRes = testing::readResult();
-    t.test("sending simple message: [server -> \"PING\" -> client]", pyRes == testing::SUCCESS);
-
-    //Test 2: simple messge 2  [server <- "Pong" <- client]
-    std::cout << "===TEST: starting test 2===" << std::endl;
-    command = "send@"+id1;
-    testing::sendCommand(command, "PONG");
-    pauseForPython("send command", communicateTime);
-    std::string incoming, incomingID;
-    res = c.getPacket(incomingID, incoming); 
-    std::cout << "res val is " << res << std::endl;
-    if(res == socketstuffs::MSGTOOBIG){
-        throw std::runtime_error(std::string("Be free my children!\n")
-                                + "in test 2 of\n"
-                                + "clientCommunications() in clientTester.cpp");
-    }
-    else if(res == socketstuffs::POLLTIMEDOUT){
-        throw std::runtime_error(std::string("I thought we needed to call run after a send command\n")
-                                            + "in test 2 of \n"
-                                            + "clientCommunications() in clientTester.cpp");
-    }
-    else if(res == socketstuffs::UNKNOWNPOLLRESULT){
-        throw std::runtime_error(std::string("Crack a few eggs to make an omelette\n")
-                                + "in test 2 of\n"
-                                + "clientCommunications() in clientTester.cpp");
-    }
-    std::cout << "RESULTS: " << std::endl;
-    std::cout << "\tgot " << incoming << "(length: " << incoming.size() << ")" << std::endl;
-    std::cout << "\tfrom " << incomingID << "(length: " << incomingID.size() << ")" <<  std::endl;
-    pyRes = testing::readResult();
-    t.test("reading simple message: [server <- \"PONG\" <- client]", pyRes == testing::SUCCESS
-                                                                    && incoming == "PONG"
-                                                                    && incomingID == id1);
-
-    //Test 3: multi-client [server -> "a:PING", "b:QING" -> client]
-    std::cout << "===TEST: starting test 3===" << std::endl;
-    res = c.sendPacket(id1, "PING"); 
-    if(res == socketstuffs::MSGTOOBIG){
-        throw std::runtime_error(std::string("Alright. Whos the big mama?\n")
-                                + "in test 3 of\n"
-                                + "clientCommunications() in clientTester.cpp");
-    }
-    std::cout << ">>OUTGOING:sent ping" << std::endl;
-    res = c.sendPacket(id2, "QING"); 
-    if(res == socketstuffs::MSGTOOBIG){
-        throw std::runtime_error(std::string("What's the big idea?\n")
-                                + "in test 3 of\n"
-                                + "clientCommunications() in clientTester.cpp");
-    }
-    std::cout << ">>OUTGOING::sent qing" << std::endl;
-    command = "read@"+id1;
-    testing::sendCommand(command, "PING");
-    pauseForPython("read command 1", communicateTime);
-    pyRes = testing::readResult();
-    command = "read@"+id2;
-    testing::sendCommand(command, "QING");
-    pauseForPython("read command 2", communicateTime);
-    int pyRes2 = testing::readResult();
-    t.test("sending multi-client message: [server -> \"a:PING\", \"b:QING\" -> client]", 
-        pyRes == testing::SUCCESS && pyRes2 == testing::SUCCESS);
-
-
-    //Test 4: multi-client [server <- "a:PONG", "b:QONG" <- client]
-    std::cout << "===TEST: starting test 4===" << std::endl;
-    command = "send@"+id1;
-    testing::sendCommand(command, "PONG");
-    pauseForPython("send command 1", communicateTime);
-    command = "send@"+id2;
-    testing::sendCommand(command, "QONG");
-    pauseForPython("send command 1", communicateTime);
-    incoming.clear(); incomingID.clear();
-    std::string incoming2, incoming2ID;
-    res = c.getPacket(incomingID, incoming); 
-    if(res == socketstuffs::MSGTOOBIG){
-        throw std::runtime_error(std::string("I'm running out of obscure things\n")
-                                + "in test 4 of\n"
-                                + "clientCommunications() in clientTester.cpp");
-    }
-    else if(res == socketstuffs::POLLTIMEDOUT){
-        throw std::runtime_error(std::string("I thought we needed to call run after a send command\n")
-                                            + "in test 4 of \n"
-                                            + "clientCommunications() in clientTester.cpp");
-    }
-    else if(res == socketstuffs::UNKNOWNPOLLRESULT){
-        throw std::runtime_error(std::string("Crack a few eggs to make an omelette\n")
-                                + "in test 4 of\n"
-                                + "clientCommunications() in clientTester.cpp");
-    }
-    res = c.getPacket(incoming2ID, incoming2); 
-    if(res == socketstuffs::MSGTOOBIG){
-        throw std::runtime_error(std::string("HUH, can't think rn\n")
-                                + "in test 4 of\n"
-                                + "clientCommunications() in clientTester.cpp");
-    }
-    else if(res == socketstuffs::POLLTIMEDOUT){
-        throw std::runtime_error(std::string("pulloololol\n")
-                                            + "in test 4 of \n"
-                                            + "clientCommunications() in clientTester.cpp");
-    }
-    else if(res == socketstuffs::UNKNOWNPOLLRESULT){
-        throw std::runtime_error(std::string("quote me\n")
-                                + "in test 4 of\n"
-                                + "clientCommunications() in clientTester.cpp");
-    }
-    /*
-    std::cout << "RESULTS: " << std::endl;
-    std::cout << "\tgot " << incoming << "(length: " << incoming.size() << ")" << std::endl;
-    std::cout << "\tfrom " << incomingID << "(length: " << incomingID.size() << ")" <<  std::endl;
-    */
-    pyRes = testing::readResult();
-    t.test("sending multiclient message: [server <- \"a:PONG\", \"b:QONG\" <- client]", pyRes == testing::SUCCESS
-                                                                    && incoming == "PONG"
-                                                                    && incomingID == id1
-                                                                    && incoming2 == "QONG"
-                                                                    && incoming2ID == id2);
-
-    c.closeIt();
-    s.closeIt();
-
-    finalizeTest(t, pythonJob);
-}
-
-void clientCommunicationLimitTests(){
-
-}
-
-int main(){
-    clientConnectionTests();
-    clientCommunicationTests();
-    clientCommunicationLimitTests();
-    return 0;
+#include "errorCPPPort.hpp"
+#include "socketLib.hpp"
+#include "testingSuite.hpp"
+#include "packetHelpers.hpp"
+
+
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <ctime>
+
+const int initTime = 3;
+const int communicateTime = 1;
+
+const std::string FILENAME = "clientTester.cpp";
+
+void initTest(testing::TestSuite& t, std::thread& pythonJob, const std::string& testName){
+    t = testing::TestSuite(testName, FILENAME);
+    pythonJob = std::thread(testing::runPythonThread);
+    std::cout << "Starting up the python thread\n"
+            << "Let it start up for " << initTime << " seconds"
+            << std::endl;
+    std::this_thread::sleep_for(std::chrono::seconds(initTime));
+}
+
+void pauseForPython(const std::string& pauseReason, int time){
+    std::cout << "STATUS: ---PAUSE--- We are pausing for: " << pauseReason << std::endl;
+    std::cout << "\t>>Let's wait for " << time << " seconds" << std::endl;
+    std::this_thread::sleep_for(std::chrono::seconds(time));
+}
+
+void finalizeTest(testing::TestSuite& t, std::thread& pythonJob){
+    testing::sendCommand("quit");
+    pythonJob.join();
+    t.printFinalOutput();
+}
+
+/*connects c to one end of a socketpair and returns the other end
+(the tests below play the peer on it, no python needed)*/
+int connectPair(socketstuffs::Client& c){
+    int fds[2];
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1){
+        throw std::runtime_error("could not make a socketpair\n"
+                                 "in connectPair() in clientTester.cpp");
+    }
+    c.connectIt(fds[0]);
+    return fds[1];
+}
+
+/*how much CPU time this process has used so far, in ms*/
+double cpuMillis(){
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1e6;
+}
+
+/*whether fd has nothing waiting to be read right now*/
+bool nothingWaiting(int fd){
+    char byte;
+    return recv(fd, &byte, 1, MSG_DONTWAIT) == -1 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+void clientConnectionTests(){
+    testing::TestSuite t;
+    std::thread pythonJob;
+    initTest(t, pythonJob, "Client Connections Test");
+
+    std::string command;
+    int res;
+    int pyRes;
+
+    socketstuffs::Socket s;
+
+    std::vector<int> validPorts;
+    int ret = socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    if(ret == socketstuffs::NONEMPTYVECTOR){
+        //this shouldn't happen
+        //I also shouldn't be consistently putting up vague
+        // depressing messages on impossible errors
+        //I won't know which is which
+        std::cout << "just .... end me now\n" 
+                    "Alright fine, this is in clientTester.cpp"
+                    << std::endl;
+        return;
+    }
+
+    // socket open
+    std::cout << "STATUS: Attempting socket connect" << std::endl;
+    size_t index = 0;
+    ret = s.openIt(validPorts[index]);
+    while(ret == socketstuffs::INVALIDPORT){
+        std::cout << "again, how?!?\n" 
+                    << "checked: " << index << std::endl
+                    << "in the socket open test of clientTester.cpp"
+                    << std::endl;
+        index++;
+        if(index >= validPorts.size()){
+            throw std::runtime_error("IM DONE!!!! (in clientTester.cpp)");
+        }
+        ret = s.openIt(validPorts[index]);
+    }
+    std::cout << "STATUS: socket opened on " << s.getPort() << std::endl;
+
+    //client connection
+    std::cout << "STATUS: attempting client connection" << std::endl;
+    socketstuffs::Client c;
+    command = "connect@" + std::to_string(s.getPort());
+    testing::sendCommand(command);
+    std::cout << "sent \"connect\" command at port " << s.getPort() << "\n"
+                << "Let it wait for " << communicateTime << " seconds"
+                << std::endl;
+    std::this_thread::sleep_for(std::chrono::seconds(communicateTime));
+
+    ret = c.connectIt(s);
+    if(ret == socketstuffs::POLLTIMEDOUT){
+        std::cout << "Poll timed out!" << std::endl; 
+        throw std::domain_error("We should not have polled out, client did not connect");
+    }
+    else if(ret == socketstuffs::UNKNOWNPOLLRESULT){
+        std::cout << "Got some negative poll value?" << std::endl;
+        std::cout << "Oh. let's check it out: " <<std::endl;
+        std::cout << "\t>>" << strerror(errno) << std::endl;
+        throw std::runtime_error("Got negative poll value!");
+    }
+    else{
+        std::cout << "STATUS: client connected"  << std::endl;
+    }
+    pyRes = testing::readResult();
+
+    t.test("simple client connection test to valid socket", ret == 1
+                                                        && pyRes == testing::SUCCESS);
+
+
+    // Python-side disconnect test
+    command = "disconnect";
+    testing::sendCommand(command);
+    std::cout << "sent \"disconnect\" command\n"
+                << "Let it wait for " << initTime<< " seconds"
+                << std::endl;
+    std::this_thread::sleep_for(std::chrono::seconds(initTime));
+    res = testing::readResult();
+    if(res == -1){
+        std::cout << "Error in Python-side disconnection test\n"
+            << "did not find file for disconnect command"
+            << std::endl;
+    }
+    t.test("Python-side disconnection from client", res == testing::SUCCESS);
+
+    // Python reconnection test
+    command = "connect@" + std::to_string(s.getPort());
+    testing::sendCommand(command);
+    std::cout << "sent \"connect\" command at port " << s.getPort() << "\n"
+                << "Let it wait for " << initTime<< " seconds"
+                << std::endl;
+    std::this_thread::sleep_for(std::chrono::seconds(initTime));
+    ret = c.connectIt(s);
+    if(ret == socketstuffs::POLLTIMEDOUT){
+        std::cout << "Poll timed out!" << std::endl; 
+        throw std::domain_error("We should not have polled out, client did not connect");
+    }
+    else if(ret == socketstuffs::UNKNOWNPOLLRESULT){
+        std::cout << "Got some negative poll value?" << std::endl;
+        std::cout << "Oh. let's check it out: " <<std::endl;
+        std::cout << "\t>>" << strerror(errno) << std::endl;
+        throw std::runtime_error("Got negative poll value!");
+    }
+    else{
+        std::cout << "STATUS: client connected"  << std::endl;
+    }
+    res = testing::readResult();
+    if(res == -1){
+        std::cout << "Error in Python reconnection test\n"
+            << "did not find file for connect command"
+            << std::endl;
+    }
+    t.test("Python reconnection to client", res == testing::SUCCESS);
+
+    std::cout << "CLOSING PROGRAM" << std::endl;
+    c.closeIt();
+    s.closeIt();
+
+    finalizeTest(t, pythonJob);
+}
+
+void clientCommunicationTests(){
+    testing::TestSuite t;
+    std::thread pythonJob;
+    initTest(t, pythonJob, "Client Communications Test");
+
+    std::string id1 = "albert";
+    std::string id2 = "barbara";
+    std::string command;
+    int res, pyRes;
+    std::string sRes;
+
+    std::cout << "STATUS: Test initialized" << std::endl;
+
+    //set up connection amongst the server (this) and the client 
+    // (python port)
+    std::vector<int> validPorts; 
+    res = socketstuffs::getValidScannedPorts(9000, 9010, validPorts);
+    if(res == socketstuffs::NONEMPTYVECTOR){
+        std::cout << "How did we even get here\n"
+                << "in scanning for valid ports\n"
+                << "in the clientConnectionsTests() function in clientTester.cpp"
+                << std::endl;
+        throw std::runtime_error("MEH");
+    }
+    std::cout << "STATUS: Found valid ports" << std::endl;
+    socketstuffs::Socket s;
+    res = s.openIt(validPorts[0]);
+    if(res == socketstuffs::INVALIDPORT){
+        std::cout << "why are we still here....\n"
+                << "in opening the socket\n"
+                << "in the clientConnectionsTests() function in clientTester.cpp"
+                << std::endl;
+        throw std::runtime_error("just to suffer?");
+    }
+
+    std::cout << "STATUS: socket connected" << std::endl;
+    socketstuffs::Client c;
+    command = "connect@" + std::to_string(s.getPort());
+    testing::sendCommand(command);
+    pauseForPython("connect command", communicateTime);
+    res = c.connectIt(s);
+    if(res == socketstuffs::POLLTIMEDOUT){
+        std::cout << "Poll timed out\n"
+                << "in trying to connect to client\n"
+                << "in clientCommunicationsTest() in clientTester.cpp"
+                << std::endl;
+        throw std::runtime_error("Please don't quit on me");
+    }
+    else if(res < 0){
+        throw std::runtime_error(std::string("Poll is negative\n")
+                                + "in clientCommunicationsTest() in clientTester.cpp");
+    }
+    pyRes = testing::readResult(); // obligatory read from sendCommand
+
+    std::cout << "STATUS: client connected" << std::endl;
+
+    //Test 1: simple message [server -> "PING" -> client]
+    std::cout << "===TEST: starting test 1===" << std::endl;
+    res = c.sendPacket(id1, "PING"); 
+    if(res == socketstuffs::MSGTOOBIG){
+        throw std::runtime_error(std::string("Again, please stop with this frizzle\n")
+                                + "in test 1 of\n"
+                                + "clientCommunications() in clientTester.cpp");
+    }
+    std::cout << "sent ping" << std::endl;
+    command = "read@"+id1;
+    testing::sendCommand(command, "PING");
+    pauseForPython("read command", communicateTime);
+    pyRes = testing::readResult();
+    t.test("sending simple message: [server -> \"PING\" -> client]", pyRes == testing::SUCCESS);
+
+    //Test 2: simple messge 2  [server <- "Pong" <- client]
+    std::cout << "===TEST: starting test 2===" << std::endl;
+    command = "send@"+id1;
+    testing::sendCommand(command, "PONG");
+    pauseForPython("send command", communicateTime);
+    std::string incoming, incomingID;
+    res = c.getPacket(incomingID, incoming); 
+    std::cout << "res val is " << res << std::endl;
+    if(res == socketstuffs::MSGTOOBIG){
+        throw std::runtime_error(std::string("Be free my children!\n")
+                                + "in test 2 of\n"
+                                + "clientCommunications() in clientTester.cpp");
+    }
+    else if(res == socketstuffs::POLLTIMEDOUT){
+        throw std::runtime_error(std::string("I thought we needed to call run after a send command\n")
+                                            + "in test 2 of \n"
+                                            + "clientCommunications() in clientTester.cpp");
+    }
+    else if(res == socketstuffs::UNKNOWNPOLLRESULT){
+        throw std::runtime_error(std::string("Crack a few eggs to make an omelette\n")
+                                + "in test 2 of\n"
+                                + "clientCommunications() in clientTester.cpp");
+    }
+    std::cout << "RESULTS: " << std::endl;
+    std::cout << "\tgot " << incoming << "(length: " << incoming.size() << ")" << std::endl;
+    std::cout << "\tfrom " << incomingID << "(length: " << incomingID.size() << ")" <<  std::endl;
+    pyRes = testing::readResult();
+    t.test("reading simple message: [server <- \"PONG\" <- client]", pyRes == testing::SUCCESS
+                                                                    && incoming == "PONG"
+                                                                    && incomingID == id1);
+
+    //Test 3: multi-client [server -> "a:PING", "b:QING" -> client]
+    std::cout << "===TEST: starting test 3===" << std::endl;
+    res = c.sendPacket(id1, "PING"); 
+    if(res == socketstuffs::MSGTOOBIG){
+        throw std::runtime_error(std::string("Alright. Whos the big mama?\n")
+                                + "in test 3 of\n"
+                                + "clientCommunications() in clientTester.cpp");
+    }
+    std::cout << ">>OUTGOING:sent ping" << std::endl;
+    res = c.sendPacket(id2, "QING"); 
+    if(res == socketstuffs::MSGTOOBIG){
+        throw std::runtime_error(std::string("What's the big idea?\n")
+                                + "in test 3 of\n"
+                                + "clientCommunications() in clientTester.cpp");
+    }
+    std::cout << ">>OUTGOING::sent qing" << std::endl;
+    command = "read@"+id1;
+    testing::sendCommand(command, "PING");
+    pauseForPython("read command 1", communicateTime);
+    pyRes = testing::readResult();
+    command = "read@"+id2;
+    testing::sendCommand(command, "QING");
+    pauseForPython("read command 2", communicateTime);
+    int pyRes2 = testing::readResult();
+    t.test("sending multi-client message: [server -> \"a:PING\", \"b:QING\" -> client]", 
+        pyRes == testing::SUCCESS && pyRes2 == testing::SUCCESS);
+
+
+    //Test 4: multi-client [server <- "a:PONG", "b:QONG" <- client]
+    std::cout << "===TEST: starting test 4===" << std::endl;
+    command = "send@"+id1;
+    testing::sendCommand(command, "PONG");
+    pauseForPython("send command 1", communicateTime);
+    command = "send@"+id2;
+    testing::sendCommand(command, "QONG");
+    pauseForPython("send command 1", communicateTime);
+    incoming.clear(); incomingID.clear();
+    std::string incoming2, incoming2ID;
+    res = c.getPacket(incomingID, incoming); 
+    if(res == socketstuffs::MSGTOOBIG){
+        throw std::runtime_error(std::string("I'm running out of obscure things\n")
+                                + "in test 4 of\n"
+                                + "clientCommunications() in clientTester.cpp");
+    }
+    else if(res == socketstuffs::POLLTIMEDOUT){
+        throw std::runtime_error(std::string("I thought we needed to call run after a send command\n")
+                                            + "in test 4 of \n"
+                                            + "clientCommunications() in clientTester.cpp");
+    }
+    else if(res == socketstuffs::UNKNOWNPOLLRESULT){
+        throw std::runtime_error(std::string("Crack a few eggs to make an omelette\n")
+                                + "in test 4 of\n"
+                                + "clientCommunications() in clientTester.cpp");
+    }
+    res = c.getPacket(incoming2ID, incoming2); 
+    if(res == socketstuffs::MSGTOOBIG){
+        throw std::runtime_error(std::string("HUH, can't think rn\n")
+                                + "in test 4 of\n"
+                                + "clientCommunications() in clientTester.cpp");
+    }
+    else if(res == socketstuffs::POLLTIMEDOUT){
+        throw std::runtime_error(std::string("pulloololol\n")
+                                            + "in test 4 of \n"
+                                            + "clientCommunications() in clientTester.cpp");
+    }
+    else if(res == socketstuffs::UNKNOWNPOLLRESULT){
+        throw std::runtime_error(std::string("quote me\n")
+                                + "in test 4 of\n"
+                                + "clientCommunications() in clientTester.cpp");
+    }
+    /*
+    std::cout << "RESULTS: " << std::endl;
+    std::cout << "\tgot " << incoming << "(length: " << incoming.size() << ")" << std::endl;
+    std::cout << "\tfrom " << incomingID << "(length: " << incomingID.size() << ")" <<  std::endl;
+    */
+    pyRes = testing::readResult();
+    t.test("sending multiclient message: [server <- \"a:PONG\", \"b:QONG\" <- client]", pyRes == testing::SUCCESS
+                                                                    && incoming == "PONG"
+                                                                    && incomingID == id1
+                                                                    && incoming2 == "QONG"
+                                                                    && incoming2ID == id2);
+
+    //Test 5: compressed message [server -> "PING...PING" (zlib) -> client]
+    std::cout << "===TEST: starting test 5===" << std::endl;
+    std::string longPing;
+    for(int i = 0;i<100;i++){
+        longPing += "PING";
+    }
+    c.setCompression(64);
+    res = c.sendPacket(id1, longPing);
+    c.setCompression(0);
+    command = "read@"+id1;
+    testing::sendCommand(command, longPing);
+    pauseForPython("read command", communicateTime);
+    pyRes = testing::readResult();
+    t.test("sending compressed message: [server -> \"PING...PING\" -> client]", res == 1
+                                                                    && pyRes == testing::SUCCESS);
+
+    //Test 6: compressed message [server <- "PONG...PONG" (zlib) <- client]
+    std::cout << "===TEST: starting test 6===" << std::endl;
+    std::string longPong;
+    for(int i = 0;i<100;i++){
+        longPong += "PONG";
+    }
+    command = "sendCompressed@"+id1;
+    testing::sendCommand(command, longPong);
+    pauseForPython("send command", communicateTime);
+    incoming.clear(); incomingID.clear();
+    res = c.getPacket(incomingID, incoming);
+    pyRes = testing::readResult();
+    t.test("reading compressed message: [server <- \"PONG...PONG\" <- client]", res == 1
+                                                                    && pyRes == testing::SUCCESS
+                                                                    && incoming == longPong
+                                                                    && incomingID == id1);
+
+    c.closeIt();
+    s.closeIt();
+
+    finalizeTest(t, pythonJob);
+}
+
+void clientCommunicationLimitTests(){
+
+}
+
+void clientBadHeaderTests(){
+    testing::TestSuite t("Client Bad Header Test", FILENAME);
+
+    //a size bigger than any packet (the flag bit left off), and a
+    // fine packet behind it that can't be found anymore
+    std::string badHeader(framing::DefaultCodec::HEADERSIZE, ' ');
+    badHeader[0] = 0x7F;
+    badHeader[1] = (char)0xFF;
+    badHeader[2] = (char)0xFF;
+
+    socketstuffs::Client c;
+    int peer = connectPair(c);
+    testing::sendAll(peer, badHeader + testing::makePacket("albert", "hello"));
+    std::string id, message;
+    int res = c.getPacket(id, message);
+    t.test("oversized header is MSGTOOBIG", res == socketstuffs::MSGTOOBIG);
+    res = c.getPacket(id, message);
+    t.test("the next getPacket is BADRECV", res == socketstuffs::BADRECV);
+    std::vector<socketstuffs::Frame> frames;
+    res = c.getPackets(frames, 10);
+    t.test("so is getPackets", res == socketstuffs::BADRECV && frames.empty());
+    res = c.getPacketStream(id, [](std::span<const char>){});
+    t.test("so is getPacketStream", res == socketstuffs::BADRECV);
+    close(peer);
+
+    peer = connectPair(c);
+    testing::sendAll(peer, testing::makePacket("albert", "hello"));
+    message.clear();
+    res = c.getPacket(id, message);
+    t.test("connecting again starts over", res == 1 && message == "hello");
+    close(peer);
+
+    peer = connectPair(c);
+    testing::sendAll(peer, badHeader);
+    res = c.getPacketStream(id, [](std::span<const char>){});
+    t.test("getPacketStream on an oversized header is MSGTOOBIG", res == socketstuffs::MSGTOOBIG);
+    res = c.getPacket(id, message);
+    t.test("and getPacket after it is BADRECV", res == socketstuffs::BADRECV);
+    close(peer);
+
+    //the same through tryGetPacket (the decoder)
+    peer = connectPair(c);
+    testing::sendAll(peer, badHeader + testing::makePacket("albert", "hello"));
+    res = c.tryGetPacket(id, message);
+    t.test("tryGetPacket on an oversized header is MSGTOOBIG", res == socketstuffs::MSGTOOBIG);
+    res = c.tryGetPacket(id, message);
+    t.test("the next tryGetPacket is BADRECV", res == socketstuffs::BADRECV);
+    res = c.getPacket(id, message);
+    t.test("and getPacket is BADRECV (not MIDSTREAM)", res == socketstuffs::BADRECV);
+    close(peer);
+
+    peer = connectPair(c);
+    testing::sendAll(peer, testing::makePacket("albert", "hello"));
+    message.clear();
+    while((res = c.tryGetPacket(id, message)) == 0 && !c.isDrained()){
+    }
+    t.test("connecting again resets the decoder", res == 1 && message == "hello");
+    close(peer);
+    c.closeIt();
+}
+
+void clientReaderTests(){
+    testing::TestSuite t("Client Reader Thread Test", FILENAME);
+
+    socketstuffs::Client c(ringbuffer::SPSC);
+    int peer = connectPair(c);
+    int res = c.startReader();
+    t.test("startReader on an SPSC client", res == 1 && c.startReader() == 1);
+
+    std::string all;
+    for(int i = 0;i<50;i++){
+        all += testing::makePacket("albert", std::string(i * 100, 'a' + i % 26));
+    }
+    testing::sendAll(peer, all);
+    bool same = true;
+    std::string id, message;
+    for(int i = 0;i<50;i++){
+        message.clear();
+        res = c.getPacket(id, message);
+        same = same && res == 1 && id == "albert" && message == std::string(i * 100, 'a' + i % 26);
+    }
+    t.test("packets come through the reader in order", same);
+
+    //nothing comes for a while, waiting for it shouldn't burn the CPU
+    std::thread late([peer]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        testing::sendAll(peer, testing::makePacket("barbara", "late"));
+    });
+    double before = cpuMillis();
+    message.clear();
+    res = c.getPacket(id, message);
+    double used = cpuMillis() - before;
+    late.join();
+    t.test("waiting on the reader sleeps", res == 1 && message == "late" && used < 100);
+
+    //more than the ring holds, so the reader has to wait for room
+    const int bigCount = 40;
+    const std::string bigMessage(100 * 1024, 'b');
+    std::thread flood([peer, &bigMessage]{
+        for(int i = 0;i<bigCount;i++){
+            testing::sendAll(peer, testing::makePacket("flood", bigMessage));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    before = cpuMillis();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    used = cpuMillis() - before;
+    t.test("a full ring doesn't make the reader spin", used < 100);
+    int got = 0;
+    for(int i = 0;i<bigCount;i++){
+        message.clear();
+        if(c.getPacket(id, message) == 1 && message == bigMessage){
+            got++;
+        }
+    }
+    flood.join();
+    t.test("everything arrives once the consumer catches up", got == bigCount);
+
+    //what was sent before the close still comes through first
+    testing::sendAll(peer, testing::makePacket("albert", "one") + testing::makePacket("albert", "two"));
+    close(peer);
+    std::string first, second;
+    int res1 = c.getPacket(id, first);
+    int res2 = c.getPacket(id, second);
+    res = c.getPacket(id, message);
+    t.test("peer closing while the reader runs", res1 == 1 && first == "one"
+                                                && res2 == 1 && second == "two"
+                                                && res == socketstuffs::READCLOSE);
+    t.test("startReader after the reader stopped on its own", c.startReader() == 1
+                                                && c.getPacket(id, message) == socketstuffs::READCLOSE);
+    c.stopReader();
+    c.closeIt();
+
+    socketstuffs::Client standard;
+    peer = connectPair(standard);
+    t.test("startReader needs an SPSC client", standard.startReader() == socketstuffs::BADRINGTYPE);
+    close(peer);
+}
+
+void clientBufferSizeTests(){
+    testing::TestSuite t("Client Buffer Grow/Shrink Test", FILENAME);
+
+    for(ringbuffer::RingType ringType : {ringbuffer::STANDARD, ringbuffer::MIRRORED}){
+        std::string name = ringType == ringbuffer::STANDARD ? "STANDARD" : "MIRRORED";
+        socketstuffs::Client c(ringType);
+        int peer = connectPair(c);
+        t.test(name + ": starts at INITIALBUFFERSIZE", c.getBufferMemory() == socketstuffs::INITIALBUFFERSIZE);
+
+        //bigger than the buffer starts out, so it has to grow for it
+        std::string big(4 * socketstuffs::INITIALBUFFERSIZE, 'g');
+        std::thread sender([peer, &big]{
+            testing::sendAll(peer, testing::makePacket("albert", big));
+        });
+        std::string id, message;
+        int res = c.getPacket(id, message);
+        sender.join();
+        t.test(name + ": big packet comes through whole", res == 1 && message == big);
+        t.test(name + ": the buffer grew for it", c.getBufferMemory() >= big.size() 
+                                                    + framing::DefaultCodec::HEADERSIZE);
+
+        //not idle long enough yet
+        testing::sendAll(peer, testing::makePacket("albert", "small"));
+        message.clear();
+        res = c.getPacket(id, message);
+        t.test(name + ": stays big while it's been busy", res == 1 && message == "small"
+                                                        && c.getBufferMemory() > socketstuffs::INITIALBUFFERSIZE);
+
+        c.setIdleShrinkTime(std::chrono::milliseconds(50));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        testing::sendAll(peer, testing::makePacket("albert", "after a while"));
+        message.clear();
+        res = c.getPacket(id, message);
+        t.test(name + ": shrinks back after going idle", res == 1 && message == "after a while"
+                                                        && c.getBufferMemory() == socketstuffs::INITIALBUFFERSIZE);
+        close(peer);
+        c.closeIt();
+    }
+}
+
+void clientBatchReceiveTests(){
+    testing::TestSuite t("Client Batch Receive Test", FILENAME);
+
+    socketstuffs::Client c;
+    int peer = connectPair(c);
+
+    //a burst of mixed sizes, all there before the first call
+    std::vector<std::string> sent;
+    std::string burst;
+    for(int i = 0;i<20;i++){
+        sent.push_back(std::string((i * 37) % 500, 'a' + i));
+        burst += testing::makePacket("user" + std::to_string(i), sent.back());
+    }
+    testing::sendAll(peer, burst);
+
+    std::vector<socketstuffs::Frame> frames;
+    int first = c.getPackets(frames, 8);
+    t.test("getPackets stops at max", first == 8 && frames.size() == 8);
+    int rest = c.getPackets(frames, 100);
+    t.test("the next call appends the rest", rest == 12 && frames.size() == 20);
+    bool same = true;
+    for(size_t i = 0;i<frames.size() && i<sent.size();i++){
+        same = same && frames[i].message == sent[i] 
+                    && std::string(frames[i].id.view()) == "user" + std::to_string(i);
+    }
+    t.test("every frame has its own id and message, in order", same);
+
+    //a packet and a half: only the whole one comes back, the half
+    // waits for the rest
+    std::string half = testing::makePacket("albert", std::string(300, 'h'));
+    testing::sendAll(peer, testing::makePacket("albert", "whole") + half.substr(0, 100));
+    frames.clear();
+    int res = c.getPackets(frames, 10);
+    t.test("only complete packets are handed back", res == 1 && frames[0].message == "whole");
+    testing::sendAll(peer, half.substr(100));
+    frames.clear();
+    res = c.getPackets(frames, 10);
+    t.test("the rest of the split one comes next", res == 1 && frames[0].message == std::string(300, 'h'));
+
+    //good packets and then an oversized header: the good ones come
+    // back first, the error on the call after
+    std::string badHeader(framing::DefaultCodec::HEADERSIZE, ' ');
+    badHeader[0] = 0x7F;
+    testing::sendAll(peer, testing::makePacket("albert", "a") + testing::makePacket("albert", "b") + badHeader);
+    frames.clear();
+    res = c.getPackets(frames, 10);
+    t.test("packets before an oversized header still come back", res == 2 && frames.size() == 2);
+    res = c.getPackets(frames, 10);
+    t.test("then the stream is broken", res == socketstuffs::BADRECV && frames.size() == 2);
+    close(peer);
+
+    peer = connectPair(c);
+    testing::sendAll(peer, badHeader);
+    frames.clear();
+    res = c.getPackets(frames, 10);
+    t.test("an oversized header first is MSGTOOBIG", res == socketstuffs::MSGTOOBIG && frames.empty());
+    close(peer);
+    c.closeIt();
+}
+
+void clientVectoredSendTests(){
+    testing::TestSuite t("Client Vectored Send Test", FILENAME);
+
+    socketstuffs::Client c;
+    int peer = connectPair(c);
+
+    //the bytes on the wire have to be exactly the header followed by
+    // the message, whatever size it is (the big one can't go out in
+    // one sendmsg(), so the rest is picked up partway through)
+    bool same = true;
+    for(size_t size : {(size_t)0, (size_t)1, (size_t)1000, (size_t)(600 * 1024)}){
+        std::string message(size, 'v');
+        std::string expected = testing::makePacket("albert", message);
+        std::string got;
+        std::thread receiver([peer, &got, &expected]{
+            got = testing::readExactly(peer, expected.size());
+        });
+        int res = c.sendPacket("albert", message);
+        receiver.join();
+        same = same && res == 1 && got == expected;
+    }
+    t.test("header and message go out back to back", same);
+
+    framing::FrameId frameId("barbara");
+    int res = c.sendPacket(frameId, "from a FrameId");
+    t.test("the FrameId overload sends the same bytes", res == 1 
+                && testing::readExactly(peer, framing::DefaultCodec::HEADERSIZE + 14) == testing::makePacket("barbara", "from a FrameId"));
+
+    res = c.sendPacket("albert", std::string(framing::DefaultCodec::MAXMESSAGE + 1, 'x'));
+    t.test("too big a message is MSGTOOBIG", res == socketstuffs::MSGTOOBIG && nothingWaiting(peer));
+    res = c.sendPacket(std::string(framing::FrameId::SIZE + 1, 'i'), "x");
+    t.test("too long an id is IDTOOBIG", res == socketstuffs::IDTOOBIG && nothingWaiting(peer));
+    close(peer);
+    c.closeIt();
+}
+
+void clientBatchSendTests(){
+    testing::TestSuite t("Client Batch Send Test", FILENAME);
+
+    socketstuffs::Client c;
+    int peer = connectPair(c);
+
+    //more than MAXSENDBATCH, so it takes a few sendmsg() calls, with
+    // sizes all over the place
+    std::vector<std::string> ids, messages;
+    std::string expected;
+    for(int i = 0;i<3 * socketstuffs::MAXSENDBATCH + 5;i++){
+        ids.push_back("user" + std::to_string(i % 50));
+        messages.push_back(std::string((i * 97) % 3000, 'a' + i % 26));
+        expected += testing::makePacket(ids.back(), messages.back());
+    }
+    std::vector<socketstuffs::OutFrame> frames;
+    for(size_t i = 0;i<ids.size();i++){
+        frames.push_back(socketstuffs::OutFrame{ids[i], messages[i]});
+    }
+    std::string got;
+    std::thread receiver([peer, &got, &expected]{
+        got = testing::readExactly(peer, expected.size());
+    });
+    int res = c.sendPackets(std::span<const socketstuffs::OutFrame>(frames));
+    receiver.join();
+    t.test("a batch of mixed sizes goes out in order", res == 1 && got == expected);
+
+    //and a Client on the other end reads them back as packets
+    socketstuffs::Client receiving;
+    int other = connectPair(receiving);
+    std::thread feeder([other, &expected]{
+        testing::sendAll(other, expected);
+    });
+    std::vector<socketstuffs::Frame> received;
+    while(received.size() < frames.size()){
+        if(receiving.getPackets(received, frames.size()) < 0){
+            break;
+        }
+    }
+    feeder.join();
+    bool same = received.size() == frames.size();
+    for(size_t i = 0;same && i<received.size();i++){
+        same = std::string(received[i].id.view()) == ids[i] && received[i].message == messages[i];
+    }
+    t.test("getPackets reads the batch back", same);
+    close(other);
+    receiving.closeIt();
+
+    t.test("an empty batch sends nothing", c.sendPackets(std::span<const socketstuffs::OutFrame>()) == 1
+                                            && nothingWaiting(peer));
+
+    //one bad frame in the middle: nothing of the batch goes out
+    std::string tooBig(framing::DefaultCodec::MAXMESSAGE + 1, 'x');
+    std::vector<socketstuffs::OutFrame> partial = {
+        {"albert", "first"}, {"albert", tooBig}, {"albert", "last"}
+    };
+    res = c.sendPackets(std::span<const socketstuffs::OutFrame>(partial));
+    t.test("a batch with a MSGTOOBIG frame sends none of it", res == socketstuffs::MSGTOOBIG 
+                                                            && nothingWaiting(peer));
+    std::string longId(framing::FrameId::SIZE + 1, 'i');
+    partial[1] = socketstuffs::OutFrame{longId, "x"};
+    res = c.sendPackets(std::span<const socketstuffs::OutFrame>(partial));
+    t.test("so does one with an IDTOOBIG frame", res == socketstuffs::IDTOOBIG && nothingWaiting(peer));
+
+    //the connection is still fine after that
+    res = c.sendPacket("albert", "still here");
+    t.test("sending after a rejected batch", res == 1
+            && testing::readExactly(peer, framing::DefaultCodec::HEADERSIZE + 10) == testing::makePacket("albert", "still here"));
+    close(peer);
+    c.closeIt();
+}
+
+/*a temporary file holding content (unlinked right away, it's gone
+once fd is closed)*/
+int makeTempFile(const std::string& content){
+    char path[] = "/tmp/clientTesterXXXXXX";
+    int fd = mkstemp(path);
+    if(fd == -1){
+        throw std::runtime_error("could not make a temporary file\n"
+                                 "in makeTempFile() in clientTester.cpp");
+    }
+    unlink(path);
+    size_t written = 0;
+    while(written < content.size()){
+        ssize_t val = write(fd, content.data() + written, content.size() - written);
+        if(val <= 0){
+            break;
+        }
+        written += val;
+    }
+    return fd;
+}
+
+void clientFileSendTests(){
+    testing::TestSuite t("Client File Send Test", FILENAME);
+
+    socketstuffs::Client c;
+    int peer = connectPair(c);
+    socketstuffs::Client receiving;
+    receiving.connectIt(dup(peer));
+
+    std::string content;
+    for(int i = 0;i<300 * 1024;i++){
+        content += (char)('a' + i % 26);
+    }
+    int file = makeTempFile(content);
+    off_t before = lseek(file, 0, SEEK_CUR);
+
+    //bigger than the socket holds, so the receiver has to run alongside
+    int res = 0;
+    std::thread sender([&c, &res, file, &content]{
+        res = c.sendFilePacket("albert", file, 0, content.size());
+    });
+    std::string id, message;
+    int got = receiving.getPacket(id, message);
+    sender.join();
+    t.test("whole file as a packet", res == 1 && got == 1 && id == "albert" && message == content);
+    t.test("the file's own offset is left alone", lseek(file, 0, SEEK_CUR) == before);
+
+    res = c.sendFilePacket("barbara", file, 1000, 5000);
+    message.clear();
+    got = receiving.getPacket(id, message);
+    t.test("a piece from the middle of the file", res == 1 && got == 1 && id == "barbara"
+                                                    && message == content.substr(1000, 5000));
+
+    res = c.sendFilePacket("albert", file, content.size() - 10, 11);
+    t.test("past the end of the file is BADFILE", res == socketstuffs::BADFILE && nothingWaiting(peer));
+    res = c.sendFilePacket("albert", file, -1, 10);
+    t.test("a negative offset is BADFILE", res == socketstuffs::BADFILE && nothingWaiting(peer));
+    res = c.sendFilePacket("albert", -1, 0, 10);
+    t.test("a bad fd is BADFILE", res == socketstuffs::BADFILE && nothingWaiting(peer));
+    res = c.sendFilePacket(std::string(framing::FrameId::SIZE + 1, 'i'), file, 0, 10);
+    t.test("too long an id is IDTOOBIG", res == socketstuffs::IDTOOBIG && nothingWaiting(peer));
+    res = c.sendFilePacket("albert", file, 0, framing::DefaultCodec::MAXMESSAGE + 1);
+    t.test("too big a length is MSGTOOBIG", res == socketstuffs::MSGTOOBIG && nothingWaiting(peer));
+    close(file);
+
+    int empty = makeTempFile("");
+    res = c.sendFilePacket("empty", empty, 0, 0);
+    message.clear();
+    got = receiving.getPacket(id, message);
+    t.test("a zero-length file is an empty packet", res == 1 && got == 1 && id == "empty" && message.empty());
+    close(empty);
+
+    receiving.closeIt();
+    close(peer);
+    c.closeIt();
+}
+
+void clientStreamTests(){
+    testing::TestSuite t("Client Stream Receive Test", FILENAME);
+
+    socketstuffs::Client sending;
+    int peer = connectPair(sending);
+    socketstuffs::Client c;
+    c.connectIt(dup(peer));
+
+    std::string big;
+    for(int i = 0;i<500 * 1024;i++){
+        big += (char)('a' + (i * 7) % 26);
+    }
+
+    //plain: bigger than the buffer ever gets, so it comes in pieces
+    std::thread sender([&sending, &big]{
+        sending.sendPacket("albert", big);
+    });
+    std::string id, collected;
+    int chunks = 0;
+    int res = c.getPacketStream(id, [&collected, &chunks](std::span<const char> chunk){
+        collected.append(chunk.data(), chunk.size());
+        chunks++;
+    });
+    sender.join();
+    t.test("plain message through onChunk", res == 1 && id == "albert" && collected == big && chunks > 1);
+    t.test("the buffer didn't grow for it", c.getBufferMemory() == socketstuffs::INITIALBUFFERSIZE);
+
+    //compressed: onChunk gets the inflated bytes
+    std::string repetitive;
+    for(int i = 0;i<5000;i++){
+        repetitive += "PING";
+    }
+    sending.setCompression(64);
+    res = sending.sendPacket("barbara", repetitive);
+    sending.setCompression(0);
+    collected.clear();
+    int got = c.getPacketStream(id, [&collected](std::span<const char> chunk){
+        collected.append(chunk.data(), chunk.size());
+    });
+    t.test("compressed message comes out inflated", res == 1 && got == 1 && id == "barbara"
+                                                    && collected == repetitive);
+
+    //onChunk throwing halfway leaves it mid message
+    std::thread sender2([&sending, &big]{
+        sending.sendPacket("albert", big);
+    });
+    collected.clear();
+    bool thrown = false;
+    try{
+        c.getPacketStream(id, [&collected](std::span<const char> chunk){
+            collected.append(chunk.data(), chunk.size());
+            throw std::runtime_error("not now");
+        });
+    }
+    catch(const std::runtime_error&){
+        thrown = true;
+    }
+    std::string otherId, message;
+    std::vector<socketstuffs::Frame> frames;
+    t.test("mid stream, getPacket is MIDSTREAM", thrown && c.getPacket(otherId, message) == socketstuffs::MIDSTREAM);
+    t.test("and so are getPackets and tryGetPacket", c.getPackets(frames, 10) == socketstuffs::MIDSTREAM
+                                                    && c.tryGetPacket(otherId, message) == socketstuffs::MIDSTREAM);
+    res = c.getPacketStream(id, [&collected](std::span<const char> chunk){
+        collected.append(chunk.data(), chunk.size());
+    });
+    sender2.join();
+    t.test("calling again carries on after the chunk that threw", res == 1 && collected == big);
+
+    //a compressed one that throws is skipped to its end
+    sending.setCompression(64);
+    sending.sendPacket("barbara", repetitive);
+    sending.setCompression(0);
+    sending.sendPacket("albert", "after");
+    try{
+        c.getPacketStream(id, [](std::span<const char>){
+            throw std::runtime_error("not now");
+        });
+    }
+    catch(const std::runtime_error&){
+    }
+    res = c.getPacketStream(id, [](std::span<const char>){});
+    message.clear();
+    got = c.getPacket(id, message);
+    t.test("a compressed one that threw ends in BADCOMPRESSION", res == socketstuffs::BADCOMPRESSION
+                                                                && got == 1 && message == "after");
+
+    //tryGetPacket partway through a packet blocks getPacketStream
+    std::string packet = testing::makePacket("albert", "split in two");
+    testing::sendAll(sending.getFd(), packet.substr(0, 10));
+    res = c.tryGetPacket(id, message);
+    got = c.getPacketStream(id, [](std::span<const char>){});
+    t.test("getPacketStream while tryGetPacket is mid packet is MIDSTREAM", res == 0 
+                                                                && got == socketstuffs::MIDSTREAM);
+    testing::sendAll(sending.getFd(), packet.substr(10));
+    message.clear();
+    while((res = c.tryGetPacket(id, message)) == 0 && !c.isDrained()){
+    }
+    t.test("tryGetPacket finishes it", res == 1 && message == "split in two");
+
+    testing::sendAll(sending.getFd(), testing::makePacket("albert", "streamed"));
+    collected.clear();
+    res = c.getPacketStream(id, [&collected](std::span<const char> chunk){
+        collected.append(chunk.data(), chunk.size());
+    });
+    t.test("then streaming works again", res == 1 && collected == "streamed");
+
+    c.closeIt();
+    close(peer);
+    sending.closeIt();
+}
+
+void clientPooledReceiveTests(){
+    testing::TestSuite t("Client Pooled Receive Test", FILENAME);
+
+    socketstuffs::Client c;
+    int peer = connectPair(c);
+    bufferpool::BufferPool& pool = c.getPool();
+
+    std::string first(1000, 'p'), second(900, 'q');
+    testing::sendAll(peer, testing::makePacket("albert", first) + testing::makePacket("barbara", second));
+    framing::FrameId id;
+    bufferpool::PooledBuffer message;
+    int res = c.getPacket(id, message);
+    t.test("pooled getPacket fills the buffer", res == 1 && message.str() == first
+                                                && std::string(id.view()) == "albert");
+    t.test("the first one is allocated", pool.getAllocated() == 1 && pool.getReused() == 0);
+
+    //same size class, so once it's given back it's the same buffer again
+    const char* storage = message.str().data();
+    message.release();
+    bufferpool::PooledBuffer next;
+    res = c.getPacket(id, next);
+    t.test("a released buffer is handed out again", res == 1 && next.str() == second
+                                                    && next.str().data() == storage
+                                                    && pool.getReused() == 1 && pool.getAllocated() == 1);
+
+    //getting another packet into a handle gives back what it held
+    testing::sendAll(peer, testing::makePacket("albert", first));
+    res = c.getPacket(id, next);
+    t.test("reusing a handle gives its old buffer back first", res == 1 && next.str() == first
+                                                    && pool.getReused() == 2 && pool.getAllocated() == 1);
+    next.release();
+
+    //a batch of mixed sizes
+    std::vector<std::string> sent;
+    std::string burst;
+    for(int i = 0;i<6;i++){
+        sent.push_back(std::string(100 << i, 'a' + i));
+        burst += testing::makePacket("user" + std::to_string(i), sent.back());
+    }
+    testing::sendAll(peer, burst);
+    std::vector<socketstuffs::PooledFrame> frames;
+    res = c.getPackets(frames, 10);
+    bool same = res == 6 && frames.size() == 6;
+    for(size_t i = 0;same && i<frames.size();i++){
+        same = frames[i].message.str() == sent[i] && std::string(frames[i].id.view()) == "user" + std::to_string(i);
+    }
+    t.test("pooled getPackets fills every buffer", same);
+
+    //clearing the vector gives all of them back, so the same batch
+    // again doesn't allocate
+    frames.clear();
+    size_t allocated = pool.getAllocated();
+    size_t reused = pool.getReused();
+    testing::sendAll(peer, burst);
+    res = c.getPackets(frames, 10);
+    t.test("a second batch reuses the buffers", res == 6 && pool.getAllocated() == allocated
+                                                && pool.getReused() == reused + 6
+                                                && frames[5].message.str() == sent[5]);
+
+    //compressed ones are inflated into a buffer of the right class
+    socketstuffs::Client sending;
+    sending.connectIt(dup(peer));
+    std::string repetitive;
+    for(int i = 0;i<2000;i++){
+        repetitive += "PONG";
+    }
+    sending.setCompression(64);
+    sending.sendPacket("albert", repetitive);
+    bufferpool::PooledBuffer inflated;
+    res = c.getPacket(id, inflated);
+    t.test("pooled getPacket inflates a compressed message", res == 1 && inflated.str() == repetitive);
+    sending.closeIt();
+
+    //a buffer can outlive the Client it came from
+    close(peer);
+    c.closeIt();
+    {
+        socketstuffs::Client shortLived;
+        int other = connectPair(shortLived);
+        testing::sendAll(other, testing::makePacket("albert", "outlives it"));
+        shortLived.getPacket(id, message);
+        close(other);
+    }
+    t.test("a buffer outlives its Client", message.str() == "outlives it");
+    message.release();
+}
+
+void clientCompressedTests(){
+    testing::TestSuite t("Client Compressed Test", FILENAME);
+
+    //the bytes of a compressed packet, with its last one (part of
+    // zlib's checksum) broken
+    socketstuffs::Client sending;
+    int peer = connectPair(sending);
+    std::string repetitive;
+    for(int i = 0;i<1000;i++){
+        repetitive += "PONG";
+    }
+    sending.setCompression(64);
+    sending.sendPacket("albert", repetitive);
+    std::string broken(64 * 1024, '\0');
+    ssize_t val = recv(peer, broken.data(), broken.size(), MSG_DONTWAIT);
+    broken.resize(val > 0 ? val : 0);
+    t.test("the packet went out compressed", val > 0 && (size_t)val < repetitive.size());
+    if(!broken.empty()){
+        broken.back() ^= 0x55;
+    }
+    close(peer);
+    sending.closeIt();
+
+    //good ones around it: the ones before it stay in the vector
+    socketstuffs::Client c;
+    peer = connectPair(c);
+    testing::sendAll(peer, testing::makePacket("albert", "a") + testing::makePacket("albert", "b") + broken + testing::makePacket("albert", "c"));
+    std::vector<socketstuffs::Frame> frames;
+    int res = c.getPackets(frames, 10);
+    t.test("a broken one is BADCOMPRESSION right away", res == socketstuffs::BADCOMPRESSION);
+    t.test("the packets before it are left in out", frames.size() == 2 && frames[0].message == "a"
+                                                    && frames[1].message == "b");
+    frames.clear();
+    res = c.getPackets(frames, 10);
+    t.test("and the one after it comes next", res == 1 && frames[0].message == "c");
+    close(peer);
+    c.closeIt();
+
+    //compressed both ways at once on the same Clients
+    const int ROUNDS = 200;
+    socketstuffs::Client left, right;
+    peer = connectPair(left);
+    right.connectIt(peer);
+    left.setCompression(64);
+    right.setCompression(64);
+    auto body = [&repetitive](char side, int i){
+        return std::string(1, side) + std::to_string(i) + repetitive;
+    };
+    std::thread leftSends([&left, &body]{
+        for(int i = 0;i<ROUNDS;i++){
+            left.sendPacket("left", body('l', i));
+        }
+    });
+    int rightGood = 0;
+    std::thread rightWorks([&right, &body, &rightGood]{
+        for(int i = 0;i<ROUNDS;i++){
+            right.sendPacket("right", body('r', i));
+        }
+        std::string id, message;
+        for(int i = 0;i<ROUNDS;i++){
+            if(right.getPacket(id, message) == 1 && message == body('l', i)){
+                rightGood++;
+            }
+        }
+    });
+    int leftGood = 0;
+    std::string id, message;
+    for(int i = 0;i<ROUNDS;i++){
+        if(left.getPacket(id, message) == 1 && message == body('r', i)){
+            leftGood++;
+        }
+    }
+    leftSends.join();
+    rightWorks.join();
+    //(the same string for every getPacket, so this also checks a
+    // compressed one replaces what was in it)
+    t.test("sending and receiving on two threads", leftGood == ROUNDS && rightGood == ROUNDS);
+    left.closeIt();
+    right.closeIt();
+}
+
+int main(){
+    clientConnectionTests();
+    clientCommunicationTests();
+    clientCommunicationLimitTests();
+    clientBadHeaderTests();
+    clientReaderTests();
+    clientBufferSizeTests();
+    clientBatchReceiveTests();
+    clientVectoredSendTests();
+    clientBatchSendTests();
+    clientFileSendTests();
+    clientStreamTests();
+    clientPooledReceiveTests();
+    clientCompressedTests();
+    return 0;
 }
\ No newline at end of file
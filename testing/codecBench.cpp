@@ -0,0 +1,87 @@
+#include "frameCodec.hpp"
+#include "sharedstuff.hpp"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <chrono>
+
+/*Micro-benchmark of encoding/decoding one packet header:
+    strings     -> the old way (uintToStr() + a padded id string
+                    concatenated, strToUint() + a trimmed id string)
+    DefaultCodec, WideCodec -> FrameCodec into a fixed std::array
+
+Everything goes to stdout as CSV:
+    make -s codecBench > bench_output.txt
+*/
+
+const size_t ITERATIONS = 5000000;
+
+//so the compiler can't throw the work away
+volatile size_t sink = 0;
+
+template<typename Op>
+double timeIt(Op op){
+    auto begin = std::chrono::steady_clock::now();
+    for(size_t i = 0;i<ITERATIONS;i++){
+        op(i);
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(finish - begin).count();
+}
+
+void printRow(const std::string& codec, const std::string& op, double secs){
+    std::cout << codec << "," << op << "," << ITERATIONS << ","
+                << secs * 1e9 / ITERATIONS << std::endl;
+}
+
+template<typename Codec>
+void benchCodec(const std::string& name, const std::string& id){
+    double secs = timeIt([&](size_t i){
+        typename Codec::Header header = Codec::encode((uint32_t)(i & 0xFFFF), id);
+        sink = sink + (unsigned char)header[Codec::SIZEBYTES - 1];
+    });
+    printRow(name, "encode", secs);
+
+    typename Codec::Header header = Codec::encode(0xBEEF, id);
+    secs = timeIt([&](size_t i){
+        header[Codec::SIZEBYTES - 1] = (char)i;
+        uint32_t size = Codec::decodeSize(header);
+        std::string_view decoded = Codec::decodeId(header);
+        sink = sink + size + decoded.size();
+    });
+    printRow(name, "decode", secs);
+}
+
+void benchStrings(const std::string& id){
+    double secs = timeIt([&](size_t i){
+        std::string idPadded = id;
+        idPadded.append((size_t)sharedstuff::IDSIZEBYTECOUNT - id.size(), ' ');
+        std::string header = sharedstuff::uintToStr((uint32_t)(i & 0xFFFF)) + idPadded;
+        sink = sink + (unsigned char)header[sharedstuff::MSGSIZEBYTECOUNT - 1];
+    });
+    printRow("strings", "encode", secs);
+
+    std::string idPadded = id;
+    idPadded.append((size_t)sharedstuff::IDSIZEBYTECOUNT - id.size(), ' ');
+    std::string header = sharedstuff::uintToStr(0xBEEF) + idPadded;
+    secs = timeIt([&](size_t i){
+        header[sharedstuff::MSGSIZEBYTECOUNT - 1] = (char)i;
+        uint32_t size = sharedstuff::strToUint(header.substr(0, sharedstuff::MSGSIZEBYTECOUNT));
+        std::string decoded = header.substr(sharedstuff::MSGSIZEBYTECOUNT);
+        size_t lastNonspace = decoded.find_last_not_of(' ');
+        decoded.erase(lastNonspace == std::string::npos ? 0 : lastNonspace + 1);
+        sink = sink + size + decoded.size();
+    });
+    printRow("strings", "decode", secs);
+}
+
+int main(){
+    std::string id = "albert";
+
+    std::cout << "codec,op,iterations,ns_per_op" << std::endl;
+    benchStrings(id);
+    benchCodec<framing::DefaultCodec>("DefaultCodec", id);
+    benchCodec<framing::WideCodec>("WideCodec", id);
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "socketLib.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+/*What compressing in sendPacket() (setCompression()) does to a
+JSON-like message going to a peer on loopback and coming back:
+    off -> sent as is
+    on  -> everything compressed at Z_BEST_SPEED
+
+The peer just echoes every byte it gets, so the compressed packets
+come back compressed and getPacket() inflates them. Every row is
+how many bytes went over the wire per packet and how long a round
+trip took, and everything goes to stdout as CSV:
+    make -s compressBench > bench_output.txt
+*/
+
+const size_t ROUNDTRIPS = 500;      // packets sent (and received) per row
+
+std::atomic<uint64_t> wireBytes(0);  // what the peer received
+
+/*connects to port and sends everything it reads back, until the
+other side closes*/
+void echo(int port){
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1){
+        std::cout << "peer could not connect" << std::endl;
+        close(fd);
+        return;
+    }
+    std::vector<char> dest(256 * 1024);
+    while(true){
+        ssize_t got = recv(fd, dest.data(), dest.size(), 0);
+        if(got <= 0){
+            break;
+        }
+        wireBytes.fetch_add(got, std::memory_order_relaxed);
+        ssize_t sent = 0;
+        while(sent < got){
+            ssize_t val = send(fd, dest.data() + sent, got - sent, MSG_NOSIGNAL);
+            if(val <= 0){
+                close(fd);
+                return;
+            }
+            sent += val;
+        }
+    }
+    close(fd);
+}
+
+/*records like a small REST response, about size bytes of them*/
+std::string makeJson(size_t size){
+    std::string json = "[";
+    for(size_t i = 0;json.size() < size;i++){
+        json += "{\"id\":" + std::to_string(i) +
+                ",\"name\":\"user" + std::to_string(i % 97) +
+                "\",\"active\":" + (i % 3 == 0 ? "true" : "false") +
+                ",\"score\":" + std::to_string((i * 7919) % 1000) +
+                ",\"tags\":[\"alpha\",\"beta\"]},";
+    }
+    json.resize(size - 1);
+    json += "]";
+    return json;
+}
+
+void printRow(const std::string& mode, size_t size, uint64_t bytes, double secs){
+    std::cout << mode << "," << size << "," << ROUNDTRIPS << ","
+                << (double)bytes / ROUNDTRIPS << ","
+                << secs * 1e6 / ROUNDTRIPS << std::endl;
+}
+
+int main(){
+    std::vector<int> validPorts;
+    socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    if(validPorts.empty()){
+        std::cout << "no free port to bench on" << std::endl;
+        return 1;
+    }
+    int port = validPorts[0];
+
+    socketstuffs::Socket s;
+    if(s.openIt(port) != 1){
+        std::cout << "could not open the socket" << std::endl;
+        return 1;
+    }
+    std::thread peer(echo, port);
+    socketstuffs::Client c;
+    if(c.connectIt(s) != 1){
+        std::cout << "could not connect the client" << std::endl;
+        peer.join();
+        return 1;
+    }
+
+    std::cout << "mode,size,roundtrips,wire_bytes_per_packet,us_per_roundtrip" << std::endl;
+    for(size_t size : {1024, 16 * 1024, 256 * 1024}){
+        std::string message = makeJson(size);
+        for(bool on : {false, true}){
+            c.setCompression(on ? 1 : 0);
+
+            std::string id = "bench";
+            std::string gotId, got;
+            bool ok = true;
+            uint64_t before = wireBytes.load();
+            auto begin = std::chrono::steady_clock::now();
+            for(size_t i = 0;i<ROUNDTRIPS && ok;i++){
+                got.clear();
+                ok = c.sendPacket(id, message) == 1
+                        && c.getPacket(gotId, got) == 1
+                        && got == message;
+            }
+            auto finish = std::chrono::steady_clock::now();
+            if(!ok){
+                std::cout << "round trip failed" << std::endl;
+                break;
+            }
+            printRow(on ? "on" : "off", size, wireBytes.load() - before,
+                        std::chrono::duration<double>(finish - begin).count());
+        }
+    }
+
+    c.closeIt();
+    peer.join();
+    s.closeIt();
+    return 0;
+}
@@ -1,2 +1,92 @@
-#include "socketLib.hpp"
-
+#include "socketLib.hpp"
+#include "testingSuite.hpp"
+
+#include <iostream>
+#include <vector>
+#include <list>
+#include <string>
+#include <thread>
+#include <atomic>
+
+void testEnqueue(){
+    testing::TestSuite t("Connection queue", "socketLib.hpp");
+
+    socketstuffs::Connection connection;
+    int good = 0;
+    for(int i = 0;i<socketstuffs::MSGQUEUESIZE;i++){
+        if(connection.enqueue("albert", "query " + std::to_string(i), false) == 1){
+            good++;
+        }
+    }
+    t.test("fills up to MSGQUEUESIZE", good == socketstuffs::MSGQUEUESIZE
+                                        && connection.getQueueDepth() == socketstuffs::MSGQUEUESIZE);
+
+    int res = connection.enqueue("albert", "one too many", false);
+    t.test("enqueue on a full queue is QUEUEFULL", res == socketstuffs::QUEUEFULL
+                                                    && connection.getQueueDepth() == socketstuffs::MSGQUEUESIZE);
+    std::list<std::string> record = connection.getRecord();
+    t.test("and it's written down", !record.empty() 
+                                    && record.front().find("The queue is full") != std::string::npos);
+
+    std::vector<std::string> args = {"albert", "through input"};
+    t.test("so is input()", connection.input(args) == socketstuffs::QUEUEFULL);
+
+    t.test("bad id is BADINPUTERROR", connection.enqueue("this id is way too long", "x", false) 
+                                        == socketstuffs::BADINPUTERROR);
+    t.test("empty body is BADINPUTERROR", connection.enqueue("albert", "", false) 
+                                        == socketstuffs::BADINPUTERROR);
+
+    std::vector<socketstuffs::Frame> outputs;
+    t.test("nothing answered yet", connection.getOutputs(outputs) == 0 && outputs.empty()
+                                    && connection.getLastOutput() == ">@EMPTY@<");
+
+    t.printFinalOutput();
+}
+
+void testHistoryThreads(){
+    testing::TestSuite t("History from many threads", "history.hpp");
+
+    history::History record;
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> writers;
+    for(int i = 0;i<4;i++){
+        writers.emplace_back([&record, &stop, i]{
+            int n = 0;
+            while(!stop.load()){
+                record.addMessage("writer " + std::to_string(i) + " message " + std::to_string(n++));
+            }
+        });
+    }
+    //let them fill it up first
+    while(record.getMessage().size() < (size_t)history::MAXHISTORYSIZE){
+        std::this_thread::yield();
+    }
+    //copies taken while the writers keep going are always whole lists
+    bool sane = true;
+    for(int i = 0;i<2000;i++){
+        std::list<std::string> messages = record.getMessage();
+        size_t counted = 0;
+        for(const std::string& message : messages){
+            sane = sane && message.rfind("writer ", 0) == 0;
+            counted++;
+        }
+        sane = sane && counted == messages.size() && counted <= (size_t)history::MAXHISTORYSIZE;
+    }
+    history::History copy(record);
+    stop.store(true);
+    for(std::thread& writer : writers){
+        writer.join();
+    }
+    t.test("getMessage() while others add", sane);
+    t.test("copying while others add", copy.getMessage().size() <= (size_t)history::MAXHISTORYSIZE);
+    t.test("keeps the newest MAXHISTORYSIZE", record.getMessage().size() == (size_t)history::MAXHISTORYSIZE);
+
+    t.printFinalOutput();
+}
+
+int main(){
+    testEnqueue();
+    testHistoryThreads();
+
+    return 0;
+}
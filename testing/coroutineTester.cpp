@@ -0,0 +1,200 @@
+#include "asyncClient.hpp"
+#include "testingSuite.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+const int CONVERSATIONS = 1000;     // running at once on one Reactor
+const int ROUNDS = 10;              // queries each of them sends
+
+/*a connected pair of Clients over a socketpair*/
+struct Pair{
+    socketstuffs::Client left;
+    socketstuffs::Client right;
+
+    Pair(){
+        int fds[2];
+        if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1){
+            throw std::runtime_error("could not make a socketpair\nin Pair in coroutineTester.cpp");
+        }
+        left.connectIt(fds[0]);
+        right.connectIt(fds[1]);
+    }
+};
+
+tasks::Task<int> giveBack(int value){
+    co_return value;
+}
+
+tasks::Task<int> addUp(int a, int b){
+    int x = co_await giveBack(a);
+    int y = co_await giveBack(b);
+    co_return x + y;
+}
+
+tasks::Task<int> throwing(){
+    throw std::runtime_error("boom");
+    co_return 0;
+}
+
+tasks::Task<void> checkThrow(bool& caught){
+    try{
+        co_await throwing();
+    }
+    catch(const std::runtime_error&){
+        caught = true;
+    }
+}
+
+tasks::Task<void> storeSum(int& out){
+    out = co_await addUp(2, 3);
+}
+
+void testTask(){
+    testing::TestSuite t("Task", "task.hpp");
+
+    int sum = 0;
+    tasks::Task<void> lazy = storeSum(sum);
+    t.test("lazy until awaited", sum == 0 && !lazy.isDone());
+    tasks::spawn(std::move(lazy));
+    t.test("spawn runs it to the end", sum == 5);
+
+    bool caught = false;
+    tasks::spawn(checkThrow(caught));
+    t.test("exception comes out of co_await", caught);
+}
+
+/*sends back every packet until the other side hangs up*/
+tasks::Task<void> echo(socketstuffs::AsyncClient& peer, int& hangups){
+    while(true){
+        socketstuffs::AsyncFrame frame = co_await peer.recvFrame();
+        if(frame.status != 1){
+            if(frame.status == socketstuffs::READCLOSE){
+                hangups++;
+            }
+            co_return;
+        }
+        if(co_await peer.sendFrame(frame.id, frame.message) != 1){
+            co_return;
+        }
+    }
+}
+
+/*ROUNDS queries one after the other, then hangs up*/
+tasks::Task<void> converse(socketstuffs::AsyncClient& me, int index, int& good, int& finished,
+                            socketstuffs::Reactor& reactor){
+    for(int i = 0;i<ROUNDS;i++){
+        std::string message = std::to_string(index) + ":" + std::to_string(i);
+        socketstuffs::AsyncFrame reply = co_await me.query("user" + std::to_string(index % 100), message);
+        if(reply.status == 1 && reply.message == message){
+            good++;
+        }
+    }
+    shutdown(me.getClient().getFd(), SHUT_WR);
+    finished++;
+    if(finished == CONVERSATIONS){
+        reactor.stop();
+    }
+}
+
+void testConversations(){
+    testing::TestSuite t("Many conversations", "asyncClient.hpp");
+
+    socketstuffs::Reactor reactor;
+    std::vector<std::unique_ptr<Pair>> pairs;
+    std::vector<std::unique_ptr<socketstuffs::AsyncClient>> clients;
+    int good = 0, finished = 0, hangups = 0;
+    for(int i = 0;i<CONVERSATIONS;i++){
+        pairs.push_back(std::make_unique<Pair>());
+        clients.push_back(std::make_unique<socketstuffs::AsyncClient>(pairs[i]->left, reactor));
+        clients.push_back(std::make_unique<socketstuffs::AsyncClient>(pairs[i]->right, reactor));
+        tasks::spawn(echo(*clients[2 * i + 1], hangups));
+        tasks::spawn(converse(*clients[2 * i], i, good, finished, reactor));
+    }
+    reactor.run();
+    //the last hang ups are still on their way to the echoes
+    while(reactor.runOnce(100) > 0){
+    }
+
+    t.test("every conversation finished", finished == CONVERSATIONS);
+    t.test("every reply matched its query", good == CONVERSATIONS * ROUNDS);
+    t.test("every echo saw the hang up", hangups == CONVERSATIONS);
+    clients.clear();
+    t.test("destroying them stops the watches", reactor.getWatchCount() == 0);
+}
+
+/*reads one packet and stops the Reactor*/
+tasks::Task<void> recvAndStop(socketstuffs::AsyncClient& me, socketstuffs::AsyncFrame& got,
+                            socketstuffs::Reactor& reactor){
+    got = co_await me.recvFrame();
+    reactor.stop();
+}
+
+tasks::Task<void> recvInto(socketstuffs::AsyncClient& me, socketstuffs::AsyncFrame& got){
+    got = co_await me.recvFrame();
+}
+
+tasks::Task<void> sendInto(socketstuffs::AsyncClient& me, std::string id, std::string message, int& status){
+    status = co_await me.sendFrame(id, message);
+}
+
+void testEdges(){
+    testing::TestSuite t("Big packets, errors and hang ups", "asyncClient.hpp");
+
+    socketstuffs::Reactor reactor;
+    {
+        Pair pair;
+        socketstuffs::AsyncClient left(pair.left, reactor);
+        socketstuffs::AsyncClient right(pair.right, reactor);
+
+        std::string big(framing::DefaultCodec::MAXMESSAGE, 'b');
+        //more than the socket holds, so it has to wait for the peer
+        int status = 0;
+        tasks::spawn(sendInto(left, "big", big, status));
+        t.test("a big send waits for room", status == 0 && left.getPendingBytes() > 0);
+
+        socketstuffs::AsyncFrame got{0, {}, {}};
+        tasks::spawn(recvAndStop(right, got, reactor));
+        reactor.run();
+        t.test("big send finished", status == 1 && left.getPendingBytes() == 0);
+        t.test("big packet came through whole", got.status == 1 && got.message == big && got.id.substr(0, 3) == "big");
+
+        socketstuffs::AsyncFrame first{0, {}, {}}, second{0, {}, {}};
+        tasks::spawn(recvInto(right, first));
+        tasks::spawn(recvInto(right, second));
+        t.test("a second reader is ALREADYBUSY", second.status == socketstuffs::ALREADYBUSY && first.status == 0);
+
+        int badId = 0, tooBig = 0;
+        tasks::spawn(sendInto(left, std::string(100, 'i'), "x", badId));
+        tasks::spawn(sendInto(left, "id", std::string(framing::DefaultCodec::MAXMESSAGE + 1, 'x'), tooBig));
+        t.test("IDTOOBIG and MSGTOOBIG right away", badId == socketstuffs::IDTOOBIG
+                                                    && tooBig == socketstuffs::MSGTOOBIG);
+
+        shutdown(pair.left.getFd(), SHUT_WR);
+        while(first.status == 0 && reactor.runOnce(1000) > 0){
+        }
+        t.test("a waiting reader hears the hang up", first.status == socketstuffs::READCLOSE);
+    }
+    {
+        Pair pair;
+        socketstuffs::AsyncClient left(pair.left, reactor);
+        pair.right.closeIt();
+        int status = 0;
+        tasks::spawn(sendInto(left, "id", "hello?", status));
+        int after = 0;
+        tasks::spawn(sendInto(left, "id", "anyone?", after));
+        t.test("sending to a closed peer is SENDCLOSE", status == socketstuffs::SENDCLOSE
+                                                        && after == socketstuffs::SENDCLOSE);
+    }
+}
+
+int main(){
+    testTask();
+    testConversations();
+    testEdges();
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include "frameDecoder.hpp"
+#include "frameId.hpp"
+#include "testingSuite.hpp"
+#include "packetHelpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+
+void testWholePackets(){
+    testing::TestSuite t("Whole packets in one piece", "frameDecoder.hpp");
+
+    framing::FrameDecoder decoder;
+    std::string stream = testing::makePacket("albert", "hello") + testing::makePacket("", "")
+                            + testing::makePacket("barbara", std::string(5000, 'z'));
+    std::span<const char> input(stream.data(), stream.size());
+
+    std::string id, message;
+    size_t used = 0;
+    int val = decoder.feed(input, used);
+    decoder.take(id, message);
+    t.test("first packet", val == framing::FRAMEREADY && id == "albert" && message == "hello"
+                            && used == sharedstuff::HEADERSIZE + 5);
+    input = input.subspan(used);
+
+    val = decoder.feed(input, used);
+    decoder.take(id, message);
+    t.test("empty id and message", val == framing::FRAMEREADY && id == "" && message == "");
+    input = input.subspan(used);
+
+    val = decoder.feed(input, used);
+    decoder.take(id, message);
+    t.test("bigger packet", val == framing::FRAMEREADY && id == "barbara"
+                            && message == std::string(5000, 'z'));
+    t.test("everything was used", used == input.size() && !decoder.inProgress());
+
+    t.printFinalOutput();
+}
+
+void testByteAtATime(){
+    testing::TestSuite t("Packets one byte at a time", "frameDecoder.hpp");
+
+    framing::FrameDecoder decoder;
+    std::string stream = testing::makePacket("carl", "abcdef") + testing::makePacket("dana", "ghi");
+    std::vector<std::string> ids, messages;
+    std::vector<int> states;
+    bool needMore = true;
+
+    for(size_t i = 0;i<stream.size();i++){
+        size_t used = 0;
+        int val = decoder.feed(std::span<const char>(stream.data() + i, 1), used);
+        if(used != 1){
+            needMore = false;
+        }
+        if(i < 16){
+            states.push_back(decoder.getState());
+        }
+        if(val == framing::FRAMEREADY){
+            std::string id, message;
+            decoder.take(id, message);
+            ids.push_back(id);
+            messages.push_back(message);
+        }
+        else if(val != framing::NEEDMORE){
+            needMore = false;
+        }
+    }
+
+    t.test("every byte was taken", needMore);
+    t.test("waits on the size first", states[0] == framing::AWAITSIZE && states[1] == framing::AWAITSIZE);
+    t.test("then the id", states[2] == framing::AWAITID && states[14] == framing::AWAITID);
+    t.test("then the body", states[15] == framing::AWAITBODY);
+    t.test("both packets came out", ids.size() == 2
+                                    && ids[0] == "carl" && messages[0] == "abcdef"
+                                    && ids[1] == "dana" && messages[1] == "ghi");
+
+    t.printFinalOutput();
+}
+
+void testBadOperations(){
+    testing::TestSuite t("Bad operations", "frameDecoder.hpp");
+
+    framing::FrameDecoder decoder;
+    std::string id, message;
+    t.test("take without a packet", decoder.take(id, message) == framing::NEEDMORE);
+
+    //0xFFFFFF is way past what a packet can hold
+    std::string stream = "\xff\xff\xff" + std::string(sharedstuff::IDSIZEBYTECOUNT, ' ');
+    size_t used = 0;
+    int val = decoder.feed(std::span<const char>(stream.data(), stream.size()), used);
+    t.test("size too big", val == framing::BADSIZE);
+
+    //nothing after a bad size lines up with a packet, so it stays bad
+    std::string after = testing::makePacket("erin", "xyz");
+    val = decoder.feed(std::span<const char>(after.data(), after.size()), used);
+    t.test("more data after BADSIZE is still BADSIZE", val == framing::BADSIZE && used == 0
+                                                        && decoder.getState() == framing::FAILED);
+    val = decoder.feed(std::span<const char>(after.data(), after.size()), used);
+    t.test("every time", val == framing::BADSIZE && used == 0 && decoder.take(id, message) == framing::NEEDMORE);
+
+    decoder.reset();
+    t.test("reset clears it", !decoder.inProgress() && decoder.getState() == framing::AWAITSIZE);
+
+    std::string packet = testing::makePacket("erin", "xyz");
+    val = decoder.feed(std::span<const char>(packet.data(), packet.size()), used);
+    t.test("works after reset", val == framing::FRAMEREADY);
+
+    //a second feed before take() doesn't take anything
+    val = decoder.feed(std::span<const char>(packet.data(), packet.size()), used);
+    t.test("feed waits for take", val == framing::FRAMEREADY && used == 0);
+
+    t.printFinalOutput();
+}
+
+void testCodecs(){
+    testing::TestSuite t("Other codecs and bytes above 0x7F", "frameCodec.hpp");
+
+    //0x80 and up used to sign extend in strToUint
+    t.test("strToUint with high bytes", sharedstuff::strToUint("\x01\xff\x80") == 0x01FF80);
+    framing::DefaultCodec::Header header = framing::DefaultCodec::encode(0x0FFFF0, "high");
+    t.test("decodeSize with high bytes", framing::DefaultCodec::decodeSize(header) == 0x0FFFF0
+                                            && framing::DefaultCodec::decodeId(header) == "high");
+
+    //a message a 3 byte size can't describe
+    std::string message(1500000, 'w');
+    framing::WideCodec::Header wideHeader = framing::WideCodec::encode(message.size(), "wide");
+    std::string stream = std::string(wideHeader.data(), wideHeader.size()) + message;
+    framing::BasicFrameDecoder<framing::WideCodec> decoder;
+    std::string id, got;
+    size_t used = 0;
+    int val = decoder.feed(std::span<const char>(stream.data(), stream.size()), used);
+    decoder.take(id, got);
+    t.test("wide header is 17 bytes", wideHeader.size() == 17);
+    t.test("wide packet", val == framing::FRAMEREADY && id == "wide" && got == message);
+
+    t.printFinalOutput();
+}
+
+void testFrameId(){
+    testing::TestSuite t("FrameId", "frameId.hpp");
+
+    framing::FrameId albert("albert");
+    t.test("keeps the id", albert.view() == "albert" && albert.size() == 6 && albert == "albert");
+    t.test("wire form is padded", std::string(albert.wire(), framing::FrameId::SIZE) == "albert       ");
+
+    framing::DefaultCodec::Header header = framing::DefaultCodec::encode(5, "albert");
+    framing::FrameId fromHeader = framing::DefaultCodec::decodeFrameId(header);
+    t.test("same id from a header", fromHeader == albert && fromHeader.hash() == albert.hash());
+    t.test("trailing spaces are padding", framing::FrameId("albert  ") == albert);
+    t.test("different ids", !(framing::FrameId("albert1") == albert) 
+                            && !(framing::FrameId("") == albert)
+                            && framing::FrameId("") == framing::FrameId());
+    t.test("full length id", framing::FrameId("thirteenchars").size() == 13);
+
+    std::unordered_map<framing::FrameId, int> routes;
+    routes[albert] = 1;
+    routes[framing::FrameId("barbara")] = 2;
+    t.test("works as a map key", routes.at(fromHeader) == 1 && routes.count(framing::FrameId("carl")) == 0);
+
+    bool errorGiven = false;
+    try{
+        framing::FrameId tooLong("fourteen chars");
+    }
+    catch(const std::invalid_argument& e){
+        std::cout << e.what() << std::endl;
+        errorGiven = true;
+    }
+    t.test("too long is an exception", errorGiven);
+
+    t.printFinalOutput();
+}
+
+int main(){
+    testWholePackets();
+    testByteAtATime();
+    testBadOperations();
+    testCodecs();
+    testFrameId();
+
+    return 0;
+}
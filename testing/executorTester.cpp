@@ -0,0 +1,175 @@
+#include "commandDispatcher.hpp"
+#include "testingSuite.hpp"
+#include "packetHelpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+
+/*replies with everything after "echo "*/
+class EchoCommand : public commands::AbstractCommand{
+public:
+    inline int executeCommand(const std::string&) override{
+        return 1;
+    }
+    inline int executeCommand(const std::string& command, std::string& reply) override{
+        reply = command.substr(command.find(' ') + 1);
+        return 1;
+    }
+};
+
+/*takes a while, then replies with what it returns ("1")*/
+class SlowCommand : public commands::AbstractCommand{
+public:
+    inline int executeCommand(const std::string&) override{
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        return 1;
+    }
+};
+
+class ThrowingCommand : public commands::AbstractCommand{
+public:
+    inline int executeCommand(const std::string&) override{
+        throw std::runtime_error("boom");
+    }
+};
+
+void testPool(){
+    testing::TestSuite t("Work stealing pool", "workStealingPool.hpp");
+
+    std::atomic<int> ran(0);
+    {
+        executor::WorkStealingPool pool(4);
+        t.test("thread count", pool.getThreadCount() == 4);
+        for(int i = 0;i<1000;i++){
+            pool.submit([&]{
+                ran++;
+            });
+        }
+        pool.stop();
+        t.test("stop runs everything queued", ran == 1000 && pool.getExecuted() == 1000 && pool.getQueued() == 0);
+        t.test("nothing after stop", !pool.submit([]{}));
+    }
+
+    //one worker queues up work on its own deque and then gets stuck,
+    // the other one has to steal all of it
+    executor::WorkStealingPool pool(2);
+    std::atomic<int> children(0);
+    std::atomic<bool> stuckDone(false);
+    std::atomic<bool> stolenFirst(false);
+    pool.submit([&]{
+        for(int i = 0;i<20;i++){
+            pool.submit([&]{
+                children++;
+            });
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while(children < 20 && std::chrono::steady_clock::now() < deadline){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        stolenFirst = children == 20;
+        stuckDone = true;
+    });
+    pool.stop();
+    t.test("a stuck worker's tasks get stolen", stuckDone && stolenFirst && pool.getSteals() >= 20);
+
+    t.printFinalOutput();
+}
+
+void testDispatcher(){
+    testing::TestSuite t("Command dispatcher", "commandDispatcher.hpp");
+
+    std::vector<int> validPorts;
+    socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    if(validPorts.empty()){
+        throw std::runtime_error("no free port\nin testDispatcher() in executorTester.cpp");
+    }
+    int port = validPorts[0];
+
+    executor::WorkStealingPool pool(2);
+    socketstuffs::CommandDispatcher dispatcher(pool);
+    dispatcher.addCommand("echo", std::make_shared<EchoCommand>());
+    dispatcher.addCommand("slow", std::make_shared<SlowCommand>());
+    dispatcher.addCommand("boom", std::make_shared<ThrowingCommand>());
+
+    socketstuffs::Reactor reactor;
+    socketstuffs::Server server(reactor,
+        [&](socketstuffs::Client& client, const std::string& id, std::string& message){
+            dispatcher.dispatch(server, client, id, message);
+        });
+    t.test("open", server.openIt(port) == 1);
+    std::thread loop([&]{
+        reactor.run();
+    });
+
+    int slowPeer = testing::connectTo(port);
+    int fastPeer = testing::connectTo(port);
+    std::string slow = testing::makePacket("slowpoke", "slow");
+    send(slowPeer, slow.data(), slow.size(), MSG_NOSIGNAL);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto begin = std::chrono::steady_clock::now();
+    std::string echo = testing::makePacket("quick", "echo hi there");
+    send(fastPeer, echo.data(), echo.size(), MSG_NOSIGNAL);
+    std::string reply = testing::readReply(fastPeer);
+    auto took = std::chrono::steady_clock::now() - begin;
+    t.test("a slow command doesn't hold up another peer", reply == "hi there"
+                                                            && took < std::chrono::milliseconds(200));
+    t.test("the slow one still answers", testing::readReply(slowPeer) == "1");
+
+    std::string boom = testing::makePacket("quick", "boom");
+    send(fastPeer, boom.data(), boom.size(), MSG_NOSIGNAL);
+    t.test("a command that throws", testing::readReply(fastPeer) == std::to_string(socketstuffs::COMMANDFAILED));
+    std::string unknown = testing::makePacket("quick", "nope");
+    send(fastPeer, unknown.data(), unknown.size(), MSG_NOSIGNAL);
+    t.test("an unknown command", testing::readReply(fastPeer) == std::to_string(socketstuffs::UNKNOWNCOMMAND));
+
+    //hangs up before the reply is ready
+    send(slowPeer, slow.data(), slow.size(), MSG_NOSIGNAL);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    close(slowPeer);
+    pool.stop();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while(dispatcher.getDropped() == 0 && std::chrono::steady_clock::now() < deadline){
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    t.test("a reply for a peer that left is dropped", dispatcher.getDropped() == 1
+                                                        && dispatcher.getCompleted() == 3);
+
+    reactor.stop();
+    loop.join();
+    server.closeIt();
+    close(fastPeer);
+
+    //a stopped Reactor with a full queue: the reply can't be posted,
+    // so it's dropped instead of holding the worker (and stop()) up
+    executor::WorkStealingPool stuckPool(1);
+    socketstuffs::CommandDispatcher stuck(stuckPool);
+    stuck.addCommand("echo", std::make_shared<EchoCommand>());
+    for(int i = 0;i<socketstuffs::REACTORQUEUESIZE;i++){
+        reactor.post([]{});
+    }
+    int pair[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, pair);
+    socketstuffs::Client client;
+    client.connectIt(pair[0]);
+    int queued = stuck.dispatch(server, client, "quick", "echo hi");
+    begin = std::chrono::steady_clock::now();
+    stuckPool.stop();
+    t.test("a reply to a stopped Reactor is dropped", queued == 1 && stuck.getDropped() == 1
+                            && std::chrono::steady_clock::now() - begin < std::chrono::seconds(5));
+    client.closeIt();
+    close(pair[1]);
+
+    t.printFinalOutput();
+}
+
+int main(){
+    testPool();
+    testDispatcher();
+
+    return 0;
+}
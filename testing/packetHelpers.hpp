@@ -0,0 +1,92 @@
+#pragma once
+#include "frameCodec.hpp"
+
+#include <sys/socket.h>     // For socket(), send() and recv()
+#include <netinet/in.h>     // For sockaddr_in
+#include <arpa/inet.h>      // For htons() and htonl()
+#include <unistd.h>         // For close()
+
+#include <string>
+#include <algorithm>
+#include <cstddef>
+
+/*What the tests and benches use to play the other side of a
+connection with a plain socket (no Client), so they can check the
+exact bytes that go over the wire*/
+namespace testing{
+
+/*builds a packet the same way Client::sendPacket does*/
+inline std::string makePacket(const std::string& id, const std::string& message){
+    framing::DefaultCodec::Header header = framing::DefaultCodec::encode(message.size(), id);
+    return std::string(header.data(), header.size()) + message;
+}
+
+/*a plain socket connected to port on loopback (-1 if it can't)*/
+inline int connectTo(int port){
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1){
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*writes all of bytes to fd (stops early if the other side is gone)*/
+inline void sendAll(int fd, const std::string& bytes){
+    size_t sent = 0;
+    while(sent < bytes.size()){
+        ssize_t val = send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if(val <= 0){
+            return;
+        }
+        sent += val;
+    }
+}
+
+/*reads exactly size bytes into dest
+returns false if the other side closes first*/
+inline bool readInto(int fd, char* dest, size_t size){
+    size_t have = 0;
+    while(have < size){
+        ssize_t val = recv(fd, dest + have, size - have, 0);
+        if(val <= 0){
+            return false;
+        }
+        have += val;
+    }
+    return true;
+}
+
+/*reads exactly size bytes (less if the other side closes)*/
+inline std::string readExactly(int fd, size_t size){
+    std::string got(size, '\0');
+    size_t have = 0;
+    while(have < size){
+        ssize_t val = recv(fd, got.data() + have, size - have, 0);
+        if(val <= 0){
+            break;
+        }
+        have += val;
+    }
+    got.resize(have);
+    return got;
+}
+
+/*reads one packet, returns its message ("" if the other side closes)*/
+inline std::string readReply(int fd){
+    framing::DefaultCodec::Header header;
+    if(!readInto(fd, header.data(), header.size())){
+        return "";
+    }
+    std::string message(framing::DefaultCodec::decodeSize(header), '\0');
+    if(!readInto(fd, message.data(), message.size())){
+        return "";
+    }
+    return message;
+}
+
+}
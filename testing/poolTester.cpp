@@ -0,0 +1,77 @@
+#include "bufferPool.hpp"
+#include "testingSuite.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+
+void testSimpleOperations(){
+    testing::TestSuite t("Simple operations", "bufferPool.hpp");
+
+    bufferpool::BufferPool pool;
+    const char* first = nullptr;
+    {
+        bufferpool::PooledBuffer buffer = pool.get(1000);
+        t.test("rounded up to its size class", buffer.str().capacity() >= 1024 && buffer.size() == 0);
+        buffer.str().assign(1000, 'x');
+        first = buffer.str().data();
+    }
+    t.test("the first get allocates", pool.getAllocated() == 1 && pool.getReused() == 0);
+
+    bufferpool::PooledBuffer again = pool.get(700);
+    t.test("the same class gets the same buffer back", again.str().data() == first
+                                                        && again.size() == 0
+                                                        && pool.getReused() == 1);
+
+    bufferpool::PooledBuffer other = pool.get(100);
+    t.test("a different class allocates", other.str().data() != first && pool.getAllocated() == 2);
+
+    bufferpool::PooledBuffer moved = std::move(again);
+    t.test("moving keeps the buffer", moved.str().data() == first && again.str().capacity() < 1024);
+    moved.release();
+    t.test("release gives it back right away", pool.get(1024).str().data() == first);
+
+    bufferpool::PooledBuffer huge = pool.get(3 * 1024 * 1024);
+    t.test("bigger than the largest class still works", huge.str().capacity() >= 3 * 1024 * 1024);
+
+    t.printFinalOutput();
+}
+
+void testLimits(){
+    testing::TestSuite t("Limits and lifetimes", "bufferPool.hpp");
+
+    bufferpool::BufferPool pool;
+    {
+        std::vector<bufferpool::PooledBuffer> buffers;
+        for(size_t i = 0;i<bufferpool::MAXPERCLASS + 4;i++){
+            buffers.push_back(pool.get(4096));
+        }
+    }
+    //only MAXPERCLASS of them were kept, so the rest allocate again
+    std::vector<bufferpool::PooledBuffer> buffers;
+    for(size_t i = 0;i<bufferpool::MAXPERCLASS + 4;i++){
+        buffers.push_back(pool.get(4096));
+    }
+    t.test("a class only keeps MAXPERCLASS buffers", pool.getReused() == bufferpool::MAXPERCLASS
+                                                        && pool.getAllocated() == bufferpool::MAXPERCLASS + 8);
+
+    bufferpool::PooledBuffer outlives;
+    {
+        bufferpool::BufferPool shortLived;
+        outlives = shortLived.get(64);
+        outlives.str() = "still here";
+    }
+    t.test("a handle can outlive its pool", outlives.view() == "still here");
+    outlives.release();
+    t.test("and still be released", outlives.size() == 0);
+
+    t.printFinalOutput();
+}
+
+int main(){
+    testSimpleOperations();
+    testLimits();
+
+    return 0;
+}
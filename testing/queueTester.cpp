@@ -0,0 +1,166 @@
+#include "mpscQueue.hpp"
+#include "testingSuite.hpp"
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <chrono>
+
+void testBadInit(){
+    testing::TestSuite t("Bad init - when capacity is 0", "mpscQueue.hpp");
+    bool errorGiven = false;
+    try{
+        ringbuffer::MPSCQueue<int> queue(0);
+    }
+    catch(const std::invalid_argument& e){
+        std::cout << e.what() << std::endl;
+        errorGiven = true;
+    }
+
+    t.test("Should be an exception", errorGiven);
+
+    t.printFinalOutput();
+}
+
+void testSimpleOperations(){
+    testing::TestSuite t("Simple operations", "mpscQueue.hpp");
+
+    ringbuffer::MPSCQueue<std::pair<std::string, std::string>> queue(3);
+    t.test("capacity is rounded up to a power of two", queue.capacity() == 4);
+
+    bool pushed = true;
+    for(int i = 0;i<4;i++){
+        pushed = pushed && queue.tryPush(std::make_pair("id" + std::to_string(i), "msg"));
+    }
+    t.test("fill the queue", pushed && queue.size() == 4);
+
+    t.test("push on a full queue fails", !queue.tryPush(std::make_pair("late", "msg")));
+
+    std::pair<std::string, std::string> value;
+    bool popped = queue.tryPop(value);
+    t.test("pop gives the oldest entry", popped && value.first == "id0");
+
+    t.test("push after a pop", queue.tryPush(std::make_pair("id4", "msg")));
+
+    std::vector<std::pair<std::string, std::string>> batch;
+    size_t taken = queue.popBatch(batch, 2);
+    t.test("popBatch takes at most max", taken == 2 && batch.size() == 2
+                                        && batch[0].first == "id1"
+                                        && batch[1].first == "id2");
+
+    taken = queue.popBatch(batch, 10);
+    t.test("popBatch takes the rest in order", taken == 2 && batch.size() == 4
+                                                && batch[2].first == "id3"
+                                                && batch[3].first == "id4");
+
+    t.test("empty after everything is popped", queue.size() == 0 && !queue.tryPop(value));
+
+    t.printFinalOutput();
+}
+
+void testManyProducers(){
+    testing::TestSuite t("Many producers, one consumer", "mpscQueue.hpp");
+
+    const int producerCount = 4;
+    const int perProducer = 20000;
+    //small on purpose so producers keep hitting a full queue
+    ringbuffer::MPSCQueue<std::pair<int, int>> queue(16);
+
+    std::vector<std::thread> producers;
+    for(int p = 0;p<producerCount;p++){
+        producers.emplace_back([&queue, p, perProducer](){
+            for(int i = 0;i<perProducer;i++){
+                queue.push(std::make_pair(p, i));
+            }
+        });
+    }
+
+    //every producer's entries should come out in the order it pushed them
+    std::vector<int> next(producerCount, 0);
+    bool inOrder = true;
+    int received = 0;
+    std::vector<std::pair<int, int>> batch;
+    while(received < producerCount * perProducer){
+        batch.clear();
+        size_t taken = queue.popBatch(batch, 8);
+        for(const std::pair<int, int>& value : batch){
+            if(value.second != next[value.first]){
+                inOrder = false;
+            }
+            next[value.first]++;
+        }
+        received += taken;
+        if(taken == 0){
+            std::this_thread::yield();
+        }
+    }
+    for(std::thread& producer : producers){
+        producer.join();
+    }
+
+    t.test("every entry arrived", received == producerCount * perProducer && queue.size() == 0);
+    t.test("each producer's entries are in order", inOrder);
+
+    t.printFinalOutput();
+}
+
+/*a payload that counts how often it's copied*/
+struct Counted{
+    static inline int copies = 0;
+    std::string data;
+
+    Counted() = default;
+    Counted(std::string data) : data(std::move(data)){}
+    Counted(const Counted& other) : data(other.data){
+        copies++;
+    }
+    Counted(Counted&&) = default;
+    Counted& operator=(const Counted& other){
+        data = other.data;
+        copies++;
+        return *this;
+    }
+    Counted& operator=(Counted&&) = default;
+};
+
+void testFullQueueCopies(){
+    testing::TestSuite t("Pushing into a full queue", "mpscQueue.hpp");
+
+    ringbuffer::MPSCQueue<Counted> queue(2);
+    queue.tryPush(Counted("a"));
+    queue.tryPush(Counted("b"));
+
+    Counted big(std::string(1024 * 1024, 'x'));
+    Counted::copies = 0;
+    bool pushed = queue.tryPush(big);
+    t.test("a failed tryPush doesn't copy", !pushed && Counted::copies == 0);
+    pushed = queue.tryPush(std::move(big));
+    t.test("a failed move leaves the value alone", !pushed && big.data.size() == 1024 * 1024);
+
+    //the consumer makes room only after push() has been waiting a while
+    std::thread consumer([&queue]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        Counted out;
+        queue.tryPop(out);
+    });
+    queue.push(std::move(big));
+    consumer.join();
+    Counted out;
+    queue.tryPop(out);
+    queue.tryPop(out);
+    t.test("push waits without copying", Counted::copies == 0 && out.data.size() == 1024 * 1024);
+
+    t.printFinalOutput();
+}
+
+int main(){
+    testBadInit();
+    testSimpleOperations();
+    testManyProducers();
+    testFullQueueCopies();
+
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "reactor.hpp"
+#include "testingSuite.hpp"
+#include "packetHelpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <chrono>
+
+void writeByte(int fd, char byte){
+    if(write(fd, &byte, 1) != 1){
+        throw std::runtime_error("could not write to the pipe\nin writeByte() in reactorTester.cpp");
+    }
+}
+
+void testWatching(){
+    testing::TestSuite t("Watching fds", "reactor.hpp");
+
+    socketstuffs::Reactor reactor;
+    int pipeFds[2];
+    if(pipe(pipeFds) == -1){
+        throw std::runtime_error("could not make a pipe\nin testWatching() in reactorTester.cpp");
+    }
+    fcntl(pipeFds[0], F_SETFL, O_NONBLOCK);
+
+    int calls = 0;
+    uint32_t lastEvents = 0;
+    int val = reactor.add(pipeFds[0], socketstuffs::READABLE, [&](uint32_t events){
+        calls++;
+        lastEvents = events;
+    });
+    t.test("add", val == 1 && reactor.getWatchCount() == 1);
+    t.test("adding twice", reactor.add(pipeFds[0], socketstuffs::READABLE, [](uint32_t){})
+                                == socketstuffs::ALREADYWATCHED);
+
+    t.test("nothing ready times out", reactor.runOnce(0) == 0 && calls == 0);
+    writeByte(pipeFds[1], 'x');
+    t.test("readable calls the handler", reactor.runOnce(1000) == 1 && calls == 1
+                                            && (lastEvents & socketstuffs::READABLE));
+    //edge-triggered: the byte is still there, but nothing new happened
+    t.test("no second call for the same bytes", reactor.runOnce(0) == 0 && calls == 1);
+    writeByte(pipeFds[1], 'y');
+    t.test("but new bytes are a new edge", reactor.runOnce(1000) == 1 && calls == 2);
+
+    t.test("remove", reactor.remove(pipeFds[0]) == 1 && reactor.getWatchCount() == 0);
+    writeByte(pipeFds[1], 'z');
+    t.test("removed fds aren't reported", reactor.runOnce(0) == 0 && calls == 2);
+    t.test("removing twice", reactor.remove(pipeFds[0]) == socketstuffs::NOTWATCHED
+                                && reactor.modify(pipeFds[0], socketstuffs::READABLE) == socketstuffs::NOTWATCHED);
+
+    //a handler that removes itself and the fd after it in the same batch
+    int otherPipe[2];
+    if(pipe(otherPipe) == -1){
+        throw std::runtime_error("could not make a pipe\nin testWatching() in reactorTester.cpp");
+    }
+    int firstCalls = 0, secondCalls = 0;
+    reactor.add(pipeFds[0], socketstuffs::READABLE, [&](uint32_t){
+        firstCalls++;
+        reactor.remove(pipeFds[0]);
+        reactor.remove(otherPipe[0]);
+    });
+    reactor.add(otherPipe[0], socketstuffs::READABLE, [&](uint32_t){
+        secondCalls++;
+        reactor.remove(pipeFds[0]);
+        reactor.remove(otherPipe[0]);
+    });
+    writeByte(pipeFds[1], 'a');
+    writeByte(otherPipe[1], 'b');
+    reactor.runOnce(1000);
+    t.test("removing from a handler", firstCalls + secondCalls == 1 && reactor.getWatchCount() == 0);
+
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+    close(otherPipe[0]);
+    close(otherPipe[1]);
+
+    t.printFinalOutput();
+}
+
+void testWakeups(){
+    testing::TestSuite t("post() and stop()", "reactor.hpp");
+
+    socketstuffs::Reactor reactor;
+    int ran = 0;
+    std::thread poster([&]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        reactor.post([&]{
+            ran++;
+        });
+    });
+    //would wait forever without the eventfd
+    int val = reactor.runOnce(5000);
+    poster.join();
+    t.test("post wakes up a waiting runOnce", val == 1 && ran == 1);
+
+    std::thread stopper([&]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        reactor.post([&]{
+            ran++;
+        });
+        reactor.stop();
+    });
+    auto begin = std::chrono::steady_clock::now();
+    val = reactor.run();
+    stopper.join();
+    t.test("stop ends run", val == 1 && ran == 2
+                            && std::chrono::steady_clock::now() - begin < std::chrono::seconds(5));
+
+    //like a thread that's told to stop before it got into run()
+    reactor.stop();
+    begin = std::chrono::steady_clock::now();
+    val = reactor.run();
+    t.test("stop before run still ends it", val == 1
+                            && std::chrono::steady_clock::now() - begin < std::chrono::seconds(5));
+
+    //that stop was used up, so this one waits for its own
+    std::thread late([&]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        reactor.post([&]{
+            ran++;
+        });
+        reactor.stop();
+    });
+    val = reactor.run();
+    late.join();
+    t.test("the next run goes until the next stop", val == 1 && ran == 3);
+
+    t.printFinalOutput();
+}
+
+void testClients(){
+    testing::TestSuite t("Serving clients", "reactor.hpp");
+
+    std::vector<int> validPorts;
+    socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    socketstuffs::Socket s;
+    if(validPorts.empty() || s.openIt(validPorts[0]) != 1){
+        throw std::runtime_error("could not open a socket\nin testClients() in reactorTester.cpp");
+    }
+
+    const int PEERS = 20;
+    const int PACKETS = 10;
+    std::string big(100 * 1024, 'b');      // bigger than a Client's first buffer
+
+    socketstuffs::Reactor reactor;
+    std::vector<std::unique_ptr<socketstuffs::Client>> clients;
+    int packets = 0, bigPackets = 0, closed = 0, otherErrors = 0;
+    reactor.watchSocket(s, [&](int fd){
+        clients.push_back(std::make_unique<socketstuffs::Client>());
+        socketstuffs::Client& c = *clients.back();
+        c.connectIt(fd);
+        reactor.watchClient(c, [&](const std::string& id, std::string& message){
+            if(message == big){
+                bigPackets++;
+            }
+            else if(message == id + " says hi"){
+                packets++;
+            }
+        }, [&](int error){
+            if(error == socketstuffs::READCLOSE){
+                closed++;
+            }
+            else{
+                otherErrors++;
+            }
+            c.closeIt();
+        });
+    });
+
+    int port = validPorts[0];
+    std::vector<std::thread> peers;
+    for(int i = 0;i<PEERS;i++){
+        peers.emplace_back([&, i]{
+            int fd = testing::connectTo(port);
+            std::string id = "peer" + std::to_string(i);
+            std::string burst;
+            for(int j = 0;j<PACKETS;j++){
+                burst += testing::makePacket(id, id + " says hi");
+            }
+            burst += testing::makePacket(id, big);
+            testing::sendAll(fd, burst);
+            close(fd);
+        });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while(closed + otherErrors < PEERS && std::chrono::steady_clock::now() < deadline){
+        reactor.runOnce(100);
+    }
+    for(std::thread& peer : peers){
+        peer.join();
+    }
+
+    t.test("every connection was accepted", (int)clients.size() == PEERS);
+    t.test("every packet came through", packets == PEERS * PACKETS && bigPackets == PEERS);
+    t.test("every hang up was noticed", closed == PEERS && otherErrors == 0);
+    t.test("and removed", reactor.getWatchCount() == 1);    // just the Socket
+
+    reactor.remove(s.getSocketFD());
+    s.closeIt();
+
+    t.printFinalOutput();
+}
+
+int main(){
+    testWatching();
+    testWakeups();
+    testClients();
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include "ring.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <span>
+#include <memory>
+#include <algorithm>
+
+/*Micro-benchmark of the ring buffers on the hot path
+
+Sweeps:
+    - op size from 1 byte to 1MB
+    - the op:
+        push_pop    -> push(span) and then pop_into(span) of size bytes
+        pop_string  -> push(span) and then pop(std::string&) of size bytes
+        getContents -> getContents() of a buffer holding size bytes
+    - the wrap pattern:
+        aligned     -> the ops never cross the end of the data
+        straddle    -> every op crosses the end of the data (half before
+                        and half after the wrap point)
+    - the ring: RingBufferS, MirroredRingBuffer, SPSCRingBuffer (used from
+        one thread) and the old byte-at-a-time loops as a baseline
+
+Everything goes to stdout as CSV so runs can be diffed/plotted:
+    make -s ringBench > bench_output.txt
+*/
+
+/*A copy of the old byte-at-a-time push/pop loops of RingBufferS
+so we have something to compare against.
+It only keeps the parts that matter for the timing.*/
+struct LegacyRing{
+    std::vector<char> data;
+    size_t maxLength, start, end, currSize;
+
+    LegacyRing(size_t maxLength) : data(maxLength, '\0'), maxLength(maxLength),
+                                    start(0), end(0), currSize(0){}
+
+    int push(const std::string& toAdd, size_t size){
+        if(size > maxLength - currSize){
+            return ringbuffer::OUTOFBOUNDS;
+        }
+        for(size_t i = 0;i<size;i++){
+            data[end] = toAdd[i];
+            end++;
+            if(end >= maxLength){
+                end = 0;
+            }
+        }
+        currSize += size;
+        return 1;
+    }
+
+    int pop(std::string& dest, size_t popAmount){
+        size_t limit = popAmount > currSize ? currSize : popAmount;
+        for(size_t i = 0;i<limit;i++){
+            dest += data[start];
+            start++;
+            if(start >= maxLength){
+                start = 0;
+            }
+        }
+        currSize -= limit;
+        return 1;
+    }
+};
+
+const size_t RINGSIZE = 2 * 1024 * 1024;
+const size_t BYTESPERRUN = 256 * 1024 * 1024;   // roughly how much each row moves
+const size_t LEGACYBYTESPERRUN = 32 * 1024 * 1024;
+const size_t MINITERATIONS = 1000;
+const size_t MAXITERATIONS = 2000000;
+
+size_t iterationsFor(size_t size){
+    return std::clamp(BYTESPERRUN / size, MINITERATIONS, MAXITERATIONS);
+}
+
+void printRow(const std::string& ring, const std::string& op, size_t size,
+                const std::string& pattern, size_t iterations, double secs){
+    double nsPerOp = secs * 1e9 / iterations;
+    double bytesPerSec = (double)size * iterations / secs;
+    std::cout << ring << "," << op << "," << size << "," << pattern << ","
+                << iterations << "," << nsPerOp << "," << bytesPerSec << std::endl;
+}
+
+/*moves the ring so the next op of size bytes starts half of it
+before the wrap point (the ring has to be empty)
+commit/consume only move the indices, nothing gets copied*/
+void moveToStraddle(ringbuffer::ByteRing& ring, size_t size){
+    size_t capacity = ring.capacity();
+    //where the empty ring currently starts
+    ringbuffer::WritableRegions free = ring.prepare(capacity);
+    size_t current = capacity - free[0].size();
+    size_t target = capacity - size / 2;
+    size_t shift = (target + capacity - current) % capacity;
+    ring.commit(shift);
+    ring.consume(shift);
+}
+
+template<typename Op>
+double timeIt(size_t iterations, Op op){
+    auto begin = std::chrono::steady_clock::now();
+    for(size_t i = 0;i<iterations;i++){
+        op();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(finish - begin).count();
+}
+
+void benchRing(const std::string& name, ringbuffer::ByteRing& ring, size_t size){
+    std::vector<char> in(size, 'x');
+    std::vector<char> out(size);
+    std::string dest;
+    dest.reserve(size);
+    size_t iterations = iterationsFor(size);
+
+    for(const std::string pattern : {"aligned", "straddle"}){
+        bool straddle = pattern == "straddle";
+        if(straddle && size < 2){
+            continue;       // can't split a single byte
+        }
+
+        double secs = timeIt(iterations, [&](){
+            if(straddle){
+                moveToStraddle(ring, size);
+            }
+            ring.push(std::span<const char>(in.data(), size));
+            ring.pop_into(std::span<char>(out.data(), size));
+        });
+        printRow(name, "push_pop", size, pattern, iterations, secs);
+
+        secs = timeIt(iterations, [&](){
+            if(straddle){
+                moveToStraddle(ring, size);
+            }
+            ring.push(std::span<const char>(in.data(), size));
+            dest.clear();
+            ring.pop(dest, size);
+        });
+        printRow(name, "pop_string", size, pattern, iterations, secs);
+
+        if(straddle){
+            moveToStraddle(ring, size);
+        }
+        ring.push(std::span<const char>(in.data(), size));
+        size_t total = 0;
+        secs = timeIt(iterations, [&](){
+            total += ring.getContents().size();
+        });
+        ring.consume(size);
+        if(total != size * iterations){
+            std::cout << "getContents() gave the wrong size!" << std::endl;
+        }
+        printRow(name, "getContents", size, pattern, iterations, secs);
+    }
+}
+
+void benchLegacy(size_t size){
+    LegacyRing ring(RINGSIZE);
+    std::string in(size, 'x');
+    std::string dest;
+    //the old loops are slow, so don't let them run forever
+    size_t iterations = std::min(iterationsFor(size), std::max<size_t>(1, LEGACYBYTESPERRUN / size));
+    double secs = timeIt(iterations, [&](){
+        ring.push(in, size);
+        dest.clear();
+        ring.pop(dest, size);
+    });
+    printRow("legacy", "pop_string", size, "aligned", iterations, secs);
+}
+
+int main(){
+    std::vector<size_t> sizes;
+    for(size_t size = 1;size <= 1024 * 1024;size *= 4){
+        sizes.push_back(size);
+    }
+
+    std::cout << "ring,op,size,pattern,iterations,ns_per_op,bytes_per_sec" << std::endl;
+    for(size_t size : sizes){
+        benchLegacy(size);
+
+        ringbuffer::RingBufferS standard(RINGSIZE);
+        benchRing("RingBufferS", standard, size);
+
+        ringbuffer::MirroredRingBuffer mirrored(RINGSIZE);
+        benchRing("MirroredRingBuffer", mirrored, size);
+
+        auto spsc = std::make_unique<ringbuffer::SPSCRingBuffer>(RINGSIZE);
+        benchRing("SPSCRingBuffer", *spsc, size);
+    }
+    return 0;
+}
@@ -1,217 +1,586 @@
-#include "ring.hpp"
-#include "testingSuite.hpp"
-
-#include <iostream>
-#include <vector>
-#include <stdexcept>
-#include <string>
-
-void testBadInit(){
-    testing::TestSuite t("Bad init - when maxLength is 0", "ring.hpp");
-    bool errorGiven = false;
-    try{
-        ringbuffer::RingBufferS buffer(0);
-    }
-    catch(const std::invalid_argument& e){
-        std::cout << e.what() << std::endl;
-        errorGiven = true;
-    }
-
-    t.test("Should be an exception", errorGiven);
-
-    t.printFinalOutput();
-}
-void testSimpleOperations(){
-    testing::TestSuite t("Simple operations", "ring.hpp");
-
-    ringbuffer::RingBufferS buffer(10);
-
-    //simple push case
-    std::string simple = "hello";
-    size_t simpleSize = simple.size();
-    bool pushed = false;
-    try{
-        buffer.push(simple, simpleSize);
-        pushed = true;
-    }catch(const std::runtime_error& e){
-        std::cout << ">>There was an error!" << std::endl;
-    }
-    t.test("Simple push case (\"Hello\")", pushed);
-
-    //size test
-    std::cout << "Size is " << buffer.size() << std::endl;
-    t.test("size test - should be " + std::to_string(simpleSize), 
-                        buffer.size() == simpleSize);
-
-    //contents test
-    std::string content = buffer.getContents();
-    std::cout << "Content is " << content << std::endl;
-    t.test("contents test", content == simple);
-
-    //empty test
-    t.test("empty test", !buffer.isEmpty());
-
-    //pop test
-    const size_t popAmount = 3;
-    std::string poppedContent;
-    bool popped = false;
-    try{
-        buffer.pop(poppedContent, popAmount);
-        popped = true;
-    }catch(const std::runtime_error& e){
-        std::cout << ">>Error happend" << std::endl;
-    }
-    t.test("Simple pop", popped);
-
-    //expectation test
-    std::string expectedPoppedContent = "hel";
-    std::cout << "popped content is " << poppedContent << std::endl;
-    t.test("expectation test", expectedPoppedContent == poppedContent);
-
-    //size test (pop)
-    size_t expectedSize = simpleSize - popAmount;
-    t.test("size test pt 2 (pop)", buffer.size() == expectedSize);
-
-    //content test (pop)
-    content = buffer.getContents();
-    std::string expectedContent = "lo";
-    std::cout << "current content is " << content << std::endl; 
-    t.test("content test pt 2 (pop)", expectedContent == content);
-
-    //empty test (pop)
-    t.test("empty test pt 2 (pop) - should be false", !buffer.isEmpty());
-
-
-    //pop everything case
-    popped = false;
-    poppedContent.clear();
-    try{
-        buffer.pop(poppedContent, 2);
-        popped = true;
-    }catch(const std::runtime_error& e){
-        std::cout << ">>There was an error!" << std::endl;
-    }
-    t.test("pop everything case", popped);
-
-    //expectation test
-    expectedPoppedContent = "lo";
-    std::cout << "popped content is " << poppedContent << std::endl;
-    t.test("expectation test", expectedPoppedContent == poppedContent);
-
-    //size test (pop)
-    expectedSize = 0;
-    t.test("size test pt 3 (everything gone)", buffer.size() == expectedSize);
-
-    //content test (pop)
-    content = buffer.getContents();
-    expectedContent = "";
-    std::cout << "current content is " << content << std::endl; 
-    t.test("content test pt 3 (everything gone)", expectedContent == content);
-
-    //empty test (pop)
-    t.test("empty test pt 3 (everything gone) - should be false", buffer.isEmpty());
-
-    t.printFinalOutput();
-}
-void testBadOperations(){
-    testing::TestSuite t("Bad operations", "ring.hpp");
-
-    ringbuffer::RingBufferS buffer(10);
-
-    //start simple
-    std::string simple = "hello";
-    size_t simpleSize = simple.size();
-    bool pushed = false;
-    try{
-        buffer.push(simple, simpleSize);
-        pushed = true;
-    }catch(const std::runtime_error& e){
-        std::cout << ">>There was an error!" << std::endl;
-    }
-    t.test("Simple push case (\"Hello\")", pushed);
-
-    //contents test
-    std::string content = buffer.getContents();
-    std::cout << "Content is " << content << std::endl;
-    t.test("contents test", content == simple);
-    
-    //overpush test
-    std::string bigstring = "what the heck, when did we as for this";
-    pushed = false;
-    try{
-        int val = buffer.push(bigstring, bigstring.size());
-        std::cout << "return value is " << val << std::endl;
-        pushed = val == 1;
-    }catch(const std::runtime_error& e){
-        //here just cuz we need to catch something
-    }
-    t.test("overpush test", !pushed);
-
-    //contents test
-    content = buffer.getContents();
-    std::cout << "Content is " << content << std::endl;
-    t.test("contents test (should be " + simple + ")", content == simple);
-    
-    //push again test
-    std::string anotherstring = "bye";
-    pushed = false;
-    try{
-        buffer.push(anotherstring, anotherstring.size());
-        pushed = true;
-    }catch(const std::runtime_error& e){
-        std::cout << ">>There was an error" << std::endl;
-    }
-    t.test("since we used try-catch, push should succeed", pushed);
-
-    simple += anotherstring;
-    //contents test
-    content = buffer.getContents();
-    std::cout << "Content is " << content << std::endl;
-    t.test("contents test (should be " + simple + ")", content == simple);
-
-    //too many pop test
-    const size_t popAmount = 100;
-    std::string poppedContent;
-    bool popped = false;
-    int val = 0;
-    try{
-        val = buffer.pop(poppedContent, popAmount);
-        popped = true;
-    }catch(const std::runtime_error& e){
-        std::cout << ">>Error happend" << std::endl;
-    }
-    t.test("MANY pop", popped && val == ringbuffer::OUTOFBOUNDS);
-
-    //expectation test
-    std::string expectedPoppedContent = "hellobye";
-    std::cout << "popped content is " << poppedContent << std::endl;
-    t.test("expectation test", expectedPoppedContent == poppedContent);
-
-    //size test (pop)
-    size_t expectedSize = 0;
-    t.test("size test (everything pop)", buffer.size() == expectedSize);
-
-    //content test (pop)
-    content = buffer.getContents();
-    std::string expectedContent = "";
-    std::cout << "current content is " << content << std::endl; 
-    t.test("content test (everything pop)", expectedContent == content);
-
-    //empty test (pop)
-    t.test("empty test (everything pop) - should be true", buffer.isEmpty());
-
-    t.printFinalOutput();
-}
-
-void testLimits(){
-
-}
-
-int main(){
-    testBadInit();
-    testSimpleOperations();
-    testBadOperations();
-
-    return 0;
-}
-
+#include "ring.hpp"
+#include "testingSuite.hpp"
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+void testBadInit(){
+    testing::TestSuite t("Bad init - when maxLength is 0", "ring.hpp");
+    bool errorGiven = false;
+    try{
+        ringbuffer::RingBufferS buffer(0);
+    }
+    catch(const std::invalid_argument& e){
+        std::cout << e.what() << std::endl;
+        errorGiven = true;
+    }
+
+    t.test("Should be an exception", errorGiven);
+
+    t.printFinalOutput();
+}
+void testSimpleOperations(){
+    testing::TestSuite t("Simple operations", "ring.hpp");
+
+    ringbuffer::RingBufferS buffer(10);
+
+    //simple push case
+    std::string simple = "hello";
+    size_t simpleSize = simple.size();
+    bool pushed = false;
+    try{
+        buffer.push(simple, simpleSize);
+        pushed = true;
+    }catch(const std::runtime_error& e){
+        std::cout << ">>There was an error!" << std::endl;
+    }
+    t.test("Simple push case (\"Hello\")", pushed);
+
+    //size test
+    std::cout << "Size is " << buffer.size() << std::endl;
+    t.test("size test - should be " + std::to_string(simpleSize), 
+                        buffer.size() == simpleSize);
+
+    //contents test
+    std::string content = buffer.getContents();
+    std::cout << "Content is " << content << std::endl;
+    t.test("contents test", content == simple);
+
+    //empty test
+    t.test("empty test", !buffer.isEmpty());
+
+    //pop test
+    const size_t popAmount = 3;
+    std::string poppedContent;
+    bool popped = false;
+    try{
+        buffer.pop(poppedContent, popAmount);
+        popped = true;
+    }catch(const std::runtime_error& e){
+        std::cout << ">>Error happend" << std::endl;
+    }
+    t.test("Simple pop", popped);
+
+    //expectation test
+    std::string expectedPoppedContent = "hel";
+    std::cout << "popped content is " << poppedContent << std::endl;
+    t.test("expectation test", expectedPoppedContent == poppedContent);
+
+    //size test (pop)
+    size_t expectedSize = simpleSize - popAmount;
+    t.test("size test pt 2 (pop)", buffer.size() == expectedSize);
+
+    //content test (pop)
+    content = buffer.getContents();
+    std::string expectedContent = "lo";
+    std::cout << "current content is " << content << std::endl; 
+    t.test("content test pt 2 (pop)", expectedContent == content);
+
+    //empty test (pop)
+    t.test("empty test pt 2 (pop) - should be false", !buffer.isEmpty());
+
+
+    //pop everything case
+    popped = false;
+    poppedContent.clear();
+    try{
+        buffer.pop(poppedContent, 2);
+        popped = true;
+    }catch(const std::runtime_error& e){
+        std::cout << ">>There was an error!" << std::endl;
+    }
+    t.test("pop everything case", popped);
+
+    //expectation test
+    expectedPoppedContent = "lo";
+    std::cout << "popped content is " << poppedContent << std::endl;
+    t.test("expectation test", expectedPoppedContent == poppedContent);
+
+    //size test (pop)
+    expectedSize = 0;
+    t.test("size test pt 3 (everything gone)", buffer.size() == expectedSize);
+
+    //content test (pop)
+    content = buffer.getContents();
+    expectedContent = "";
+    std::cout << "current content is " << content << std::endl; 
+    t.test("content test pt 3 (everything gone)", expectedContent == content);
+
+    //empty test (pop)
+    t.test("empty test pt 3 (everything gone) - should be false", buffer.isEmpty());
+
+    t.printFinalOutput();
+}
+void testBadOperations(){
+    testing::TestSuite t("Bad operations", "ring.hpp");
+
+    ringbuffer::RingBufferS buffer(10);
+
+    //start simple
+    std::string simple = "hello";
+    size_t simpleSize = simple.size();
+    bool pushed = false;
+    try{
+        buffer.push(simple, simpleSize);
+        pushed = true;
+    }catch(const std::runtime_error& e){
+        std::cout << ">>There was an error!" << std::endl;
+    }
+    t.test("Simple push case (\"Hello\")", pushed);
+
+    //contents test
+    std::string content = buffer.getContents();
+    std::cout << "Content is " << content << std::endl;
+    t.test("contents test", content == simple);
+    
+    //overpush test
+    std::string bigstring = "what the heck, when did we as for this";
+    pushed = false;
+    try{
+        int val = buffer.push(bigstring, bigstring.size());
+        std::cout << "return value is " << val << std::endl;
+        pushed = val == 1;
+    }catch(const std::runtime_error& e){
+        //here just cuz we need to catch something
+    }
+    t.test("overpush test", !pushed);
+
+    //contents test
+    content = buffer.getContents();
+    std::cout << "Content is " << content << std::endl;
+    t.test("contents test (should be " + simple + ")", content == simple);
+    
+    //push again test
+    std::string anotherstring = "bye";
+    pushed = false;
+    try{
+        buffer.push(anotherstring, anotherstring.size());
+        pushed = true;
+    }catch(const std::runtime_error& e){
+        std::cout << ">>There was an error" << std::endl;
+    }
+    t.test("since we used try-catch, push should succeed", pushed);
+
+    simple += anotherstring;
+    //contents test
+    content = buffer.getContents();
+    std::cout << "Content is " << content << std::endl;
+    t.test("contents test (should be " + simple + ")", content == simple);
+
+    //too many pop test
+    const size_t popAmount = 100;
+    std::string poppedContent;
+    bool popped = false;
+    int val = 0;
+    try{
+        val = buffer.pop(poppedContent, popAmount);
+        popped = true;
+    }catch(const std::runtime_error& e){
+        std::cout << ">>Error happend" << std::endl;
+    }
+    t.test("MANY pop", popped && val == ringbuffer::OUTOFBOUNDS);
+
+    //expectation test
+    std::string expectedPoppedContent = "hellobye";
+    std::cout << "popped content is " << poppedContent << std::endl;
+    t.test("expectation test", expectedPoppedContent == poppedContent);
+
+    //size test (pop)
+    size_t expectedSize = 0;
+    t.test("size test (everything pop)", buffer.size() == expectedSize);
+
+    //content test (pop)
+    content = buffer.getContents();
+    std::string expectedContent = "";
+    std::cout << "current content is " << content << std::endl; 
+    t.test("content test (everything pop)", expectedContent == content);
+
+    //empty test (pop)
+    t.test("empty test (everything pop) - should be true", buffer.isEmpty());
+
+    t.printFinalOutput();
+}
+
+void testSpanOperations(){
+    testing::TestSuite t("Span push/pop_into across the wrap point", "ring.hpp");
+
+    ringbuffer::RingBufferS buffer(8);
+
+    std::string first = "abcdef";
+    int val = buffer.push(std::span<const char>(first.data(), first.size()));
+    t.test("span push", val == 1 && buffer.size() == first.size());
+
+    char popped[4];
+    size_t poppedCount = buffer.pop_into(std::span<char>(popped, 4));
+    t.test("pop_into returns the amount popped", poppedCount == 4);
+    t.test("pop_into expectation test", std::string(popped, 4) == "abcd");
+
+    //this one has to wrap around the end of data
+    std::string second = "ghijkl";
+    val = buffer.push(std::span<const char>(second.data(), second.size()));
+    t.test("wrapping span push", val == 1 && buffer.size() == 8);
+
+    std::string content = buffer.getContents();
+    std::cout << "Content is " << content << std::endl;
+    t.test("contents test (wrapped)", content == "efghijkl");
+
+    //full buffer should not take anything else
+    val = buffer.push(std::span<const char>(second.data(), 1));
+    t.test("overpush test (full)", val == ringbuffer::OUTOFBOUNDS);
+
+    std::string dest = "->";
+    val = buffer.pop(dest, 5);
+    t.test("pop appends to dest", val == 1 && dest == "->efghi");
+
+    char rest[10];
+    poppedCount = buffer.pop_into(std::span<char>(rest, 10));
+    t.test("pop_into with too much room", poppedCount == 3 
+                                            && std::string(rest, 3) == "jkl"
+                                            && buffer.isEmpty());
+
+    //copies should keep the size
+    std::string third = "mno";
+    buffer.push(third, third.size());
+    ringbuffer::RingBufferS copy = buffer;
+    t.test("copy keeps contents", copy.size() == 3 && copy.getContents() == "mno");
+
+    t.printFinalOutput();
+}
+
+/*glues the regions of a peek back together so we can compare it*/
+std::string regionsToString(const ringbuffer::Regions& regions){
+    std::string ret;
+    for(const std::span<const char>& region : regions){
+        ret.append(region.data(), region.size());
+    }
+    return ret;
+}
+
+void testPeekOperations(){
+    testing::TestSuite t("peek/readable_regions/consume", "ring.hpp");
+
+    ringbuffer::RingBufferS buffer(8);
+    std::string first = "abcdef";
+    buffer.push(first, first.size());
+    buffer.consume(4);
+    std::string second = "ghijkl";
+    buffer.push(second, second.size());
+
+    //buffer is now "efghijkl" with the wrap point between "h" and "i"
+    ringbuffer::Regions regions = buffer.readable_regions();
+    t.test("readable_regions splits at the wrap point", regions[0].size() == 4 
+                                                        && regions[1].size() == 4);
+    t.test("readable_regions contents", regionsToString(regions) == "efghijkl");
+
+    regions = buffer.peek(1, 2);
+    t.test("peek before the wrap point", regionsToString(regions) == "fg"
+                                        && regions[1].empty());
+
+    regions = buffer.peek(2, 4);
+    t.test("peek across the wrap point", regionsToString(regions) == "ghij");
+
+    regions = buffer.peek(6, 2);
+    t.test("peek after the wrap point", regionsToString(regions) == "kl"
+                                        && regions[1].empty());
+
+    regions = buffer.peek(6, 3);
+    t.test("peek too far gives nothing", regions[0].empty() && regions[1].empty());
+
+    t.test("peek does not pop", buffer.size() == 8);
+
+    int val = buffer.consume(5);
+    t.test("consume", val == 1 && buffer.getContents() == "jkl");
+
+    val = buffer.consume(10);
+    t.test("consume too much", val == ringbuffer::OUTOFBOUNDS && buffer.isEmpty());
+
+    t.printFinalOutput();
+}
+
+void testMirroredOperations(){
+    testing::TestSuite t("MirroredRingBuffer", "ring.hpp");
+
+    bool errorGiven = false;
+    try{
+        ringbuffer::MirroredRingBuffer bad(0);
+    }
+    catch(const std::invalid_argument& e){
+        errorGiven = true;
+    }
+    t.test("Bad init - should be an exception", errorGiven);
+
+    ringbuffer::MirroredRingBuffer buffer(10);
+    size_t capacity = buffer.capacity();
+    t.test("capacity is rounded up to a page", capacity >= 10 && capacity % 4096 == 0);
+
+    //move start close to the end of the first mapping
+    std::string filler(capacity - 3, 'z');
+    buffer.push(filler, filler.size());
+    buffer.consume(filler.size());
+
+    std::string msg = "This was a triumph";
+    int val = buffer.push(std::span<const char>(msg.data(), msg.size()));
+    t.test("push across the wrap point", val == 1 && buffer.size() == msg.size());
+
+    ringbuffer::Regions regions = buffer.readable_regions();
+    t.test("readable_regions is one piece", regions[1].empty()
+                                        && regionsToString(regions) == msg);
+
+    regions = buffer.peek(1, 5);
+    t.test("peek across the wrap point", regionsToString(regions) == "his w");
+
+    std::string popped;
+    val = buffer.pop(popped, 4);
+    t.test("pop across the wrap point", val == 1 && popped == "This");
+    t.test("contents after pop", buffer.getContents() == " was a triumph");
+
+    char rest[100];
+    size_t poppedCount = buffer.pop_into(std::span<char>(rest, 100));
+    t.test("pop_into with too much room", poppedCount == msg.size() - 4 && buffer.isEmpty());
+
+    std::string tooBig(capacity + 1, 'x');
+    val = buffer.push(tooBig, tooBig.size());
+    t.test("overpush test", val == ringbuffer::OUTOFBOUNDS && buffer.isEmpty());
+
+    ringbuffer::MirroredRingBuffer moved = std::move(buffer);
+    moved.push(msg, msg.size());
+    t.test("moved buffer still works", moved.getContents() == msg);
+
+    t.printFinalOutput();
+}
+
+void testSPSCOperations(){
+    testing::TestSuite t("SPSCRingBuffer", "ring.hpp");
+
+    ringbuffer::SPSCRingBuffer buffer(6);
+    t.test("capacity is rounded up to a power of two", buffer.capacity() == 8);
+
+    std::string first = "abcdef";
+    buffer.push(first, first.size());
+    buffer.consume(4);
+    std::string second = "ghijkl";
+    int val = buffer.push(second, second.size());
+    t.test("wrapping push", val == 1 && buffer.size() == 8);
+    t.test("contents test (wrapped)", buffer.getContents() == "efghijkl");
+
+    val = buffer.push(second, 1);
+    t.test("overpush test (full)", val == ringbuffer::OUTOFBOUNDS);
+
+    ringbuffer::Regions regions = buffer.peek(2, 4);
+    t.test("peek across the wrap point", regionsToString(regions) == "ghij");
+
+    std::string popped;
+    val = buffer.pop(popped, 5);
+    t.test("pop", val == 1 && popped == "efghi");
+
+    char rest[10];
+    size_t poppedCount = buffer.pop_into(std::span<char>(rest, 10));
+    t.test("pop_into with too much room", poppedCount == 3 
+                                            && std::string(rest, 3) == "jkl"
+                                            && buffer.isEmpty());
+
+    //one thread pushes a known pattern while this one pops it
+    const size_t total = 4 * 1024 * 1024;
+    ringbuffer::SPSCRingBuffer shared(4096);
+    std::thread producer([&shared, total](){
+        char chunk[333];
+        size_t sent = 0;
+        while(sent < total){
+            size_t amount = std::min(sizeof(chunk), total - sent);
+            for(size_t i = 0;i<amount;i++){
+                chunk[i] = (char)((sent + i) % 251);
+            }
+            while(shared.push(std::span<const char>(chunk, amount)) != 1){
+                std::this_thread::yield();
+            }
+            sent += amount;
+        }
+    });
+    size_t received = 0;
+    bool inOrder = true;
+    char out[517];
+    while(received < total){
+        size_t got = shared.pop_into(std::span<char>(out, sizeof(out)));
+        for(size_t i = 0;i<got;i++){
+            if(out[i] != (char)((received + i) % 251)){
+                inOrder = false;
+            }
+        }
+        received += got;
+    }
+    producer.join();
+    t.test("two threads: every byte arrives in order", inOrder && received == total
+                                                        && shared.isEmpty());
+
+    t.printFinalOutput();
+}
+
+void testResize(){
+    testing::TestSuite t("resize keeps the contents", "ring.hpp");
+
+    ringbuffer::RingBufferS buffer(8);
+    std::string first = "abcdef";
+    buffer.push(first, first.size());
+    buffer.consume(4);
+    std::string second = "ghijkl";
+    buffer.push(second, second.size());
+
+    int val = buffer.resize(4);
+    t.test("too small to hold the contents", val == ringbuffer::OUTOFBOUNDS 
+                                            && buffer.capacity() == 8);
+
+    val = buffer.resize(32);
+    t.test("grow a wrapped buffer", val == 1 && buffer.capacity() == 32
+                                    && buffer.getContents() == "efghijkl");
+
+    std::string more = "mnop";
+    buffer.push(more, more.size());
+    t.test("push after growing", buffer.getContents() == "efghijklmnop");
+
+    val = buffer.resize(12);
+    t.test("shrink to exactly the contents", val == 1 && buffer.getContents() == "efghijklmnop");
+    t.test("full after shrinking", buffer.push(more, 1) == ringbuffer::OUTOFBOUNDS);
+
+    ringbuffer::MirroredRingBuffer mirrored(10);
+    mirrored.push(first, first.size());
+    val = mirrored.resize(mirrored.capacity() * 2);
+    t.test("grow a mirrored buffer", val == 1 && mirrored.getContents() == first);
+
+    ringbuffer::SPSCRingBuffer spsc(8);
+    spsc.push(first, first.size());
+    spsc.consume(4);
+    spsc.push(second, second.size());
+    val = spsc.resize(20);
+    t.test("grow a wrapped spsc buffer", val == 1 && spsc.capacity() == 32
+                                        && spsc.getContents() == "efghijkl");
+
+    t.printFinalOutput();
+}
+
+/*writes msg into whatever prepare() handed out*/
+size_t writeInto(const ringbuffer::WritableRegions& regions, const std::string& msg){
+    size_t written = 0;
+    for(const std::span<char>& region : regions){
+        for(size_t i = 0;i<region.size() && written < msg.size();i++){
+            region[i] = msg[written];
+            written++;
+        }
+    }
+    return written;
+}
+
+void testPrepareCommit(){
+    testing::TestSuite t("prepare/commit", "ring.hpp");
+
+    ringbuffer::RingBufferS buffer(8);
+    std::string first = "abcdef";
+    buffer.push(first, first.size());
+    buffer.consume(4);
+
+    //free space is [6, 8) and then [0, 4)
+    ringbuffer::WritableRegions regions = buffer.prepare(100);
+    t.test("prepare gives all of the free space in two pieces", regions[0].size() == 2
+                                                                && regions[1].size() == 4);
+    t.test("nothing is pushed before commit", buffer.size() == 2);
+
+    size_t written = writeInto(regions, "ghijk");
+    int val = buffer.commit(written);
+    t.test("commit across the wrap point", val == 1 && buffer.getContents() == "efghijk");
+
+    regions = buffer.prepare(100);
+    t.test("prepare with one character left", regions[0].size() == 1 && regions[1].empty());
+
+    val = buffer.commit(2);
+    t.test("commit more than the free space", val == ringbuffer::OUTOFBOUNDS && buffer.size() == 7);
+
+    ringbuffer::MirroredRingBuffer mirrored(10);
+    std::string filler(mirrored.capacity() - 2, 'z');
+    mirrored.push(filler, filler.size());
+    mirrored.consume(filler.size());
+    regions = mirrored.prepare(5);
+    t.test("mirrored prepare is one piece", regions[0].size() == 5 && regions[1].empty());
+    mirrored.commit(writeInto(regions, "hello"));
+    t.test("mirrored commit", mirrored.getContents() == "hello");
+
+    ringbuffer::SPSCRingBuffer spsc(8);
+    spsc.push(first, first.size());
+    spsc.consume(4);
+    regions = spsc.prepare(100);
+    t.test("spsc prepare", regions[0].size() == 2 && regions[1].size() == 4);
+    spsc.commit(writeInto(regions, "ghijk"));
+    t.test("spsc commit", spsc.getContents() == "efghijk");
+
+    t.printFinalOutput();
+}
+
+void testTemplateRing(){
+    testing::TestSuite t("RingBuffer<T, Capacity>", "ring.hpp");
+
+    ringbuffer::RingBuffer<char, 8> bytes;
+    t.test("capacity is known at compile time", ringbuffer::RingBuffer<char, 8>::capacity() == 8);
+
+    std::string first = "abcdef";
+    int val = bytes.push(std::span<const char>(first.data(), first.size()));
+    t.test("span push", val == 1 && bytes.size() == 6);
+
+    char popped[4];
+    size_t poppedCount = bytes.pop_into(std::span<char>(popped, 4));
+    t.test("pop_into", poppedCount == 4 && std::string(popped, 4) == "abcd");
+
+    std::string second = "ghijkl";
+    val = bytes.push(std::span<const char>(second.data(), second.size()));
+    std::vector<char> contents = bytes.getContents();
+    t.test("wrapping push", val == 1 && std::string(contents.begin(), contents.end()) == "efghijkl");
+
+    t.test("overpush test (full)", bytes.push('m') == ringbuffer::OUTOFBOUNDS);
+    t.test("at() across the wrap point", bytes.at(3) == 'h' && bytes.at(4) == 'i');
+
+    //a queue of something that isn't a char
+    struct FrameDescriptor{
+        std::string id;
+        size_t size;
+    };
+    ringbuffer::RingBuffer<FrameDescriptor, 4> frames;
+    for(size_t i = 0;i<4;i++){
+        frames.push(FrameDescriptor{"id" + std::to_string(i), i * 10});
+    }
+    t.test("full queue of structs", frames.size() == 4
+                                    && frames.push(FrameDescriptor{"late", 0}) == ringbuffer::OUTOFBOUNDS);
+
+    FrameDescriptor frame;
+    frames.pop(frame);
+    t.test("pop gives the oldest struct", frame.id == "id0" && frames.front().id == "id1");
+
+    frames.push(FrameDescriptor{"id4", 40});
+    frames.consume(3);
+    t.test("consume and wrap", frames.size() == 1 && frames.front().size == 40);
+
+    val = frames.consume(5);
+    t.test("consume too much", val == ringbuffer::OUTOFBOUNDS && frames.isEmpty()
+                                && frames.pop(frame) == ringbuffer::OUTOFBOUNDS);
+
+    t.printFinalOutput();
+}
+
+void testLimits(){
+
+}
+
+int main(){
+    testBadInit();
+    testSimpleOperations();
+    testBadOperations();
+    testSpanOperations();
+    testPeekOperations();
+    testMirroredOperations();
+    testSPSCOperations();
+    testResize();
+    testPrepareCommit();
+    testTemplateRing();
+
+    return 0;
+}
+
@@ -0,0 +1,100 @@
+#include "socketLib.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <span>
+
+/*How many syscalls (poll() + sendmsg()) each packet costs when
+a lot of small packets go out at once:
+    sendPacket  -> one sendPacket() call per packet
+    sendPackets -> all of them in one sendPackets() call
+
+Both go to a peer on loopback that just reads everything, and
+everything goes to stdout as CSV:
+    make -s sendBench > bench_output.txt
+*/
+
+const size_t FRAMES = 20000;    // packets sent per row
+
+/*connects to port and reads until the other side closes*/
+void drain(int port){
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1){
+        std::cout << "peer could not connect" << std::endl;
+        close(fd);
+        return;
+    }
+    std::vector<char> dest(256 * 1024);
+    while(recv(fd, dest.data(), dest.size(), 0) > 0){
+    }
+    close(fd);
+}
+
+void printRow(const std::string& method, size_t size, uint64_t calls, double secs){
+    std::cout << method << "," << size << "," << FRAMES << ","
+                << (double)calls / FRAMES << ","
+                << secs * 1e9 / FRAMES << std::endl;
+}
+
+int main(){
+    std::vector<int> validPorts;
+    socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    if(validPorts.empty()){
+        std::cout << "no free port to bench on" << std::endl;
+        return 1;
+    }
+    int port = validPorts[0];
+
+    socketstuffs::Socket s;
+    if(s.openIt(port) != 1){
+        std::cout << "could not open the socket" << std::endl;
+        return 1;
+    }
+    std::thread peer(drain, port);
+    socketstuffs::Client c;
+    if(c.connectIt(s) != 1){
+        std::cout << "could not connect the client" << std::endl;
+        peer.join();
+        return 1;
+    }
+
+    std::cout << "method,size,frames,calls_per_frame,ns_per_frame" << std::endl;
+    for(size_t size : {16, 64, 256, 1024}){
+        std::string id = "bench";
+        std::string message(size, 'x');
+
+        uint64_t before = c.getSendCalls();
+        auto begin = std::chrono::steady_clock::now();
+        for(size_t i = 0;i<FRAMES;i++){
+            if(c.sendPacket(id, message) != 1){
+                std::cout << "sendPacket failed" << std::endl;
+                break;
+            }
+        }
+        auto finish = std::chrono::steady_clock::now();
+        printRow("sendPacket", size, c.getSendCalls() - before,
+                    std::chrono::duration<double>(finish - begin).count());
+
+        std::vector<socketstuffs::OutFrame> frames(FRAMES, socketstuffs::OutFrame{id, message});
+        before = c.getSendCalls();
+        begin = std::chrono::steady_clock::now();
+        if(c.sendPackets(std::span<const socketstuffs::OutFrame>(frames)) != 1){
+            std::cout << "sendPackets failed" << std::endl;
+        }
+        finish = std::chrono::steady_clock::now();
+        printRow("sendPackets", size, c.getSendCalls() - before,
+                    std::chrono::duration<double>(finish - begin).count());
+    }
+
+    c.closeIt();
+    peer.join();
+    s.closeIt();
+    return 0;
+}
@@ -0,0 +1,228 @@
+#include "server.hpp"
+#include "shardedServer.hpp"
+#include "testingSuite.hpp"
+#include "packetHelpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+
+void testClientTable(){
+    testing::TestSuite t("Client table", "server.hpp");
+
+    socketstuffs::ClientTable table;
+    std::vector<int> fds;
+    for(size_t i = 0;i<socketstuffs::CLIENTSLABSIZE + 1;i++){
+        int pair[2];
+        if(socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == -1){
+            throw std::runtime_error("could not make a socketpair\nin testClientTable() in serverTester.cpp");
+        }
+        close(pair[1]);
+        fds.push_back(pair[0]);
+    }
+
+    socketstuffs::Client* first = table.insert(fds[0]);
+    t.test("insert", first != nullptr && first->getFd() == fds[0] && table.size() == 1);
+    t.test("find", table.find(fds[0]) == first && table.find(fds[1]) == nullptr);
+    t.test("inserting the same fd twice", table.insert(fds[0]) == nullptr && table.size() == 1);
+    t.test("inserting a bad fd", table.insert(-1) == nullptr);
+
+    for(size_t i = 1;i<fds.size();i++){
+        table.insert(fds[i]);
+    }
+    t.test("one more than a slab makes a second slab", table.size() == fds.size()
+                                                        && table.getSlabCount() == 2);
+
+    //a buffer the first connection gave back to its Client's pool
+    const char* pooled;
+    {
+        bufferpool::PooledBuffer buffer = first->getPool().get(100);
+        pooled = buffer.str().data();
+    }
+    first->setCompression(64);
+
+    t.test("erase closes the fd", table.erase(fds[0]) == 1 && table.find(fds[0]) == nullptr
+                                    && fcntl(fds[0], F_GETFD) == -1);
+    t.test("erasing twice", table.erase(fds[0]) == socketstuffs::UNKNOWNCLIENT);
+
+    //the kernel hands the lowest free fd out again, and the slot is reused
+    int pair[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, pair);
+    socketstuffs::Client* again = table.insert(pair[0]);
+    t.test("a freed slot is used again", again == first && table.getSlabCount() == 2);
+    bufferpool::PooledBuffer reused = again->getPool().get(100);
+    t.test("and so is its Client (with its pool)", reused.str().data() == pooled
+                                    && again->getBufferMemory() == socketstuffs::INITIALBUFFERSIZE);
+    reused.release();
+    //it's a new connection, so it doesn't compress like the last one
+    std::string message(1000, 'z');
+    again->sendPacket("albert", message);
+    t.test("settings of the last connection don't carry over",
+            testing::readExactly(pair[1], testing::makePacket("albert", message).size()) == testing::makePacket("albert", message));
+    close(pair[1]);
+
+    size_t seen = 0;
+    table.forEach([&](int fd, socketstuffs::Client& c){
+        if(c.getFd() == fd){
+            seen++;
+        }
+    });
+    t.test("forEach", seen == table.size());
+
+    for(int fd : fds){
+        table.erase(fd);
+    }
+    table.erase(pair[0]);
+    t.test("empty again", table.size() == 0);
+
+    t.printFinalOutput();
+}
+
+void testEchoServer(){
+    testing::TestSuite t("Echo server", "server.hpp");
+
+    std::vector<int> validPorts;
+    socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    if(validPorts.empty()){
+        throw std::runtime_error("no free port\nin testEchoServer() in serverTester.cpp");
+    }
+    int port = validPorts[0];
+
+    socketstuffs::Reactor reactor;
+    std::atomic<int> closes(0);
+    socketstuffs::Server server(reactor,
+        [](socketstuffs::Client& client, const std::string& id, std::string& message){
+            client.sendPacket(id, message);
+        },
+        [&](int, int error){
+            if(error == socketstuffs::READCLOSE){
+                closes++;
+            }
+        });
+    t.test("open", server.openIt(port, 128) == 1 && server.getPort() == port);
+
+    const int PEERS = 50;
+    std::vector<int> peerFds;
+    for(int i = 0;i<PEERS;i++){
+        peerFds.push_back(testing::connectTo(port));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(server.getClientCount() < PEERS && std::chrono::steady_clock::now() < deadline){
+        reactor.runOnce(100);
+    }
+    t.test("every peer is in the table", server.getClientCount() == PEERS
+                                            && server.getAcceptCount() == PEERS);
+
+    //everyone sends at once, the reactor thread answers all of them
+    std::thread loop([&]{
+        reactor.run();
+    });
+    int echoed = 0;
+    for(int i = 0;i<PEERS;i++){
+        std::string packet = testing::makePacket("p" + std::to_string(i), "hi from " + std::to_string(i));
+        send(peerFds[i], packet.data(), packet.size(), MSG_NOSIGNAL);
+    }
+    for(int i = 0;i<PEERS;i++){
+        std::string packet = testing::makePacket("p" + std::to_string(i), "hi from " + std::to_string(i));
+        if(testing::readExactly(peerFds[i], packet.size()) == packet){
+            echoed++;
+        }
+    }
+    t.test("every peer got its own packet back", echoed == PEERS);
+
+    for(int i = 0;i<PEERS / 2;i++){
+        close(peerFds[i]);
+    }
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(closes < PEERS / 2 && std::chrono::steady_clock::now() < deadline){
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    reactor.stop();
+    loop.join();
+    t.test("hang ups leave the table", closes == PEERS / 2 && server.getClientCount() == PEERS - PEERS / 2);
+
+    server.closeIt();
+    t.test("closeIt drops everyone", server.getClientCount() == 0 && reactor.getWatchCount() == 0
+                                        && testing::readExactly(peerFds[PEERS - 1], 1).empty());
+    for(int i = PEERS / 2;i<PEERS;i++){
+        close(peerFds[i]);
+    }
+
+    t.printFinalOutput();
+}
+
+void testShardedServer(){
+    testing::TestSuite t("Sharded server", "shardedServer.hpp");
+
+    std::vector<int> validPorts;
+    socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    if(validPorts.empty()){
+        throw std::runtime_error("no free port\nin testShardedServer() in serverTester.cpp");
+    }
+    int port = validPorts[0];
+
+    const size_t SHARDS = 4;
+    socketstuffs::ShardedServer server(SHARDS,
+        [](socketstuffs::Client& client, const std::string& id, std::string& message){
+            client.sendPacket(id, message);
+        });
+    t.test("open every shard on one port", server.openIt(port) == 1 && server.getPort() == port
+                                            && server.getShardCount() == SHARDS);
+    socketstuffs::Socket other;
+    t.test("a plain Socket can't take the port", other.openIt(port) == socketstuffs::INVALIDPORT);
+    t.test("start pinned", server.start(true) == 1);
+
+    const int PEERS = 40;
+    std::vector<int> peerFds;
+    int echoed = 0;
+    for(int i = 0;i<PEERS;i++){
+        peerFds.push_back(testing::connectTo(port));
+        std::string packet = testing::makePacket("p" + std::to_string(i), "hi from " + std::to_string(i));
+        send(peerFds[i], packet.data(), packet.size(), MSG_NOSIGNAL);
+        if(testing::readExactly(peerFds[i], packet.size()) == packet){
+            echoed++;
+        }
+    }
+    t.test("every peer got its own packet back", echoed == PEERS);
+
+    socketstuffs::ShardStats total;
+    size_t busyShards = 0;
+    bool pinned = true;
+    for(size_t i = 0;i<SHARDS;i++){
+        socketstuffs::ShardStats stats;
+        server.getStats(i, stats);
+        if(stats.accepted > 0){
+            busyShards++;
+        }
+        if(stats.cpu == -1){
+            pinned = false;
+        }
+    }
+    t.test("stats add up", server.getTotalStats(total) == 1 && total.accepted == PEERS
+                            && total.clients == PEERS && total.packets == PEERS);
+    t.test("the kernel spread the connections", busyShards > 1);
+    t.test("every shard is pinned", pinned);
+    socketstuffs::ShardStats stats;
+    t.test("no shard past the last", server.getStats(SHARDS, stats) == socketstuffs::UNKNOWNSHARD);
+
+    server.stop();
+    server.closeIt();
+    t.test("closeIt drops everyone", server.getTotalStats(total) == 1 && total.clients == 0
+                                        && testing::readExactly(peerFds[0], 1).empty());
+    for(int fd : peerFds){
+        close(fd);
+    }
+
+    t.printFinalOutput();
+}
+
+int main(){
+    testClientTable();
+    testEchoServer();
+    testShardedServer();
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "shardedServer.hpp"
+#include "packetHelpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+/*How a ShardedServer scales with its shard count: 1, 2, 4, ... up
+to every CPU this process may use, one shard (pinned) per CPU
+
+LOADERS threads each keep CONNECTIONS connections busy, sending one
+100 byte packet on every connection and then reading all the echoes
+back, for SECONDS per row. Each row is the echoes per second, and
+the fewest and most packets a single shard handled (how evenly the
+kernel spread the connections)
+
+everything goes to stdout as CSV:
+    make -s shardBench > bench_output.txt
+*/
+
+const int LOADERS = 4;              // threads making the load
+const int CONNECTIONS = 16;         // connections per loader
+const double SECONDS = 1.0;         // how long each row runs
+
+/*one loader: echoes on every one of its connections until stop*/
+void load(int port, std::atomic<bool>& stop, std::atomic<uint64_t>& echoes){
+    std::string packet = testing::makePacket("bench", std::string(100, 'b'));
+    std::vector<char> dest(packet.size());
+    std::vector<int> fds;
+    for(int i = 0;i<CONNECTIONS;i++){
+        int fd = testing::connectTo(port);
+        if(fd != -1){
+            fds.push_back(fd);
+        }
+    }
+    uint64_t done = 0;
+    while(!stop.load(std::memory_order_relaxed)){
+        for(int fd : fds){
+            send(fd, packet.data(), packet.size(), MSG_NOSIGNAL);
+        }
+        for(int fd : fds){
+            if(testing::readInto(fd, dest.data(), dest.size())){
+                done++;
+            }
+        }
+    }
+    echoes += done;
+    for(int fd : fds){
+        close(fd);
+    }
+}
+
+int main(){
+    std::vector<int> validPorts;
+    socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    if(validPorts.empty()){
+        std::cout << "no free port to bench on" << std::endl;
+        return 1;
+    }
+    int port = validPorts[0];
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    sched_getaffinity(0, sizeof(set), &set);
+    size_t cpus = std::max(CPU_COUNT(&set), 1);
+    std::vector<size_t> shardCounts;
+    for(size_t n = 1;n<cpus;n *= 2){
+        shardCounts.push_back(n);
+    }
+    shardCounts.push_back(cpus);
+
+    std::cout << "shards,pinned,connections,seconds,echoes_per_sec,min_shard_packets,max_shard_packets" << std::endl;
+    for(size_t shards : shardCounts){
+        socketstuffs::ShardedServer server(shards,
+            [](socketstuffs::Client& client, const std::string& id, std::string& message){
+                client.sendPacket(id, message);
+            });
+        if(server.openIt(port) != 1){
+            std::cout << "could not open the server" << std::endl;
+            return 1;
+        }
+        bool pinned = server.start(true) == 1;
+
+        std::atomic<bool> stop(false);
+        std::atomic<uint64_t> echoes(0);
+        std::vector<std::thread> loaders;
+        auto begin = std::chrono::steady_clock::now();
+        for(int i = 0;i<LOADERS;i++){
+            loaders.emplace_back(load, port, std::ref(stop), std::ref(echoes));
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(SECONDS));
+        stop.store(true);
+        for(std::thread& loader : loaders){
+            loader.join();
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        uint64_t fewest = UINT64_MAX, most = 0;
+        for(size_t i = 0;i<shards;i++){
+            socketstuffs::ShardStats stats{};
+            int val = server.getStats(i, stats);
+            if(val != 1){
+                std::cout << "could not get the stats of shard " << i << ": "
+                            << socketstuffs::interpretError(val) << std::endl;
+                server.closeIt();
+                return 1;
+            }
+            fewest = std::min(fewest, stats.packets);
+            most = std::max(most, stats.packets);
+        }
+        server.closeIt();
+
+        std::cout << shards << "," << pinned << "," << LOADERS * CONNECTIONS << ","
+                    << secs << "," << echoes.load() / secs << ","
+                    << fewest << "," << most << std::endl;
+    }
+    return 0;
+}
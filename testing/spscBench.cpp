@@ -0,0 +1,82 @@
+#include "ring.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <span>
+
+/*Two-thread throughput of the SPSCRingBuffer (one thread pushes,
+the other pops) against a RingBufferS guarded by a std::mutex,
+which is what we'd have to do without the SPSC ring*/
+
+const size_t RINGSIZE = 2 * 1024 * 1024;
+const size_t TOTALBYTES = 1024 * 1024 * 1024;   //bytes moved per measurement
+
+/*pushes TOTALBYTES in chunkSize pieces from another thread
+while this thread pops them, and returns GB/s
+pushOnce/popOnce return how much they moved (0 if they couldn't)*/
+template<typename Push, typename Pop>
+double measure(size_t chunkSize, Push pushOnce, Pop popOnce){
+    std::vector<char> in(chunkSize, 'x');
+    std::vector<char> out(chunkSize);
+
+    auto begin = std::chrono::steady_clock::now();
+    std::thread producer([&](){
+        size_t sent = 0;
+        while(sent < TOTALBYTES){
+            if(pushOnce(std::span<const char>(in.data(), in.size()))){
+                sent += chunkSize;
+            }
+            else{
+                std::this_thread::yield();
+            }
+        }
+    });
+    size_t received = 0;
+    while(received < TOTALBYTES){
+        size_t got = popOnce(std::span<char>(out.data(), out.size()));
+        if(got == 0){
+            std::this_thread::yield();
+        }
+        received += got;
+    }
+    producer.join();
+    auto finish = std::chrono::steady_clock::now();
+
+    double secs = std::chrono::duration<double>(finish - begin).count();
+    return (double)TOTALBYTES / secs / 1e9;
+}
+
+int main(){
+    std::vector<size_t> sizes = {64, 1024, 16 * 1024, 64 * 1024};
+
+    std::cout << "chunkSize,mutex_GBps,spsc_GBps" << std::endl;
+    for(size_t chunkSize : sizes){
+        ringbuffer::RingBufferS locked(RINGSIZE);
+        std::mutex lock;
+        double mutexRate = measure(chunkSize,
+            [&](std::span<const char> piece){
+                std::lock_guard<std::mutex> guard(lock);
+                return locked.push(piece) == 1;
+            },
+            [&](std::span<char> dest){
+                std::lock_guard<std::mutex> guard(lock);
+                return locked.pop_into(dest);
+            });
+
+        ringbuffer::SPSCRingBuffer spsc(RINGSIZE);
+        double spscRate = measure(chunkSize,
+            [&](std::span<const char> piece){
+                return spsc.push(piece) == 1;
+            },
+            [&](std::span<char> dest){
+                return spsc.pop_into(dest);
+            });
+
+        std::cout << chunkSize << "," << mutexRate << "," << spscRate << std::endl;
+    }
+    return 0;
+}
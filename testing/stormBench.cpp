@@ -0,0 +1,126 @@
+#include "server.hpp"
+#include "packetHelpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+/*How fast one Server (on one Reactor thread) takes connections:
+    churn -> CONNECTORS threads each connect and hang up right away,
+                over and over (a connection storm)
+    held  -> the same, but every connection stays open until all of
+                them are in, so the client table has to hold them all
+
+Each row is how long it took until the Server had accepted (and seen
+the hang up of) every connection, and everything goes to stdout as CSV:
+    make -s stormBench > bench_output.txt
+*/
+
+const int CONNECTORS = 4;           // threads connecting at once
+const int CHURNCONNECTS = 20000;    // connections per churn row
+const int HELDCONNECTS = 2000;      // connections per held row
+
+std::atomic<int> closes(0);         // hang ups the Server saw
+
+/*closes with a reset instead of a FIN, so tens of thousands of
+connections don't use up the local ports sitting in TIME_WAIT*/
+void hangUp(int fd){
+    struct linger reset = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    close(fd);
+}
+
+/*CONNECTORS threads make total connections between them and return
+how many seconds it took until the Server saw every one hang up*/
+double storm(int port, int total, bool hold){
+    closes.store(0);
+    std::atomic<int> connected(0);
+    std::atomic<int> failed(0);
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> connectors;
+    for(int i = 0;i<CONNECTORS;i++){
+        connectors.emplace_back([&, i]{
+            std::vector<int> held;
+            for(int j = i;j<total;j += CONNECTORS){
+                int fd = testing::connectTo(port);
+                if(fd == -1){
+                    failed++;
+                    continue;
+                }
+                connected++;
+                if(hold){
+                    held.push_back(fd);
+                }
+                else{
+                    hangUp(fd);
+                }
+            }
+            if(hold){
+                //everyone is in before anyone leaves
+                while(connected.load() + failed.load() < total){
+                    std::this_thread::yield();
+                }
+                for(int fd : held){
+                    hangUp(fd);
+                }
+            }
+        });
+    }
+    for(std::thread& connector : connectors){
+        connector.join();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while(closes.load() < connected.load() && std::chrono::steady_clock::now() < deadline){
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    auto finish = std::chrono::steady_clock::now();
+    if(failed.load() > 0 || closes.load() < connected.load()){
+        std::cout << "only " << closes.load() << "/" << total << " connections made it" << std::endl;
+    }
+    return std::chrono::duration<double>(finish - begin).count();
+}
+
+int main(){
+    std::vector<int> validPorts;
+    socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    if(validPorts.empty()){
+        std::cout << "no free port to bench on" << std::endl;
+        return 1;
+    }
+    int port = validPorts[0];
+
+    socketstuffs::Reactor reactor;
+    socketstuffs::Server server(reactor,
+        [](socketstuffs::Client&, const std::string&, std::string&){},
+        [](int, int){
+            closes++;
+        });
+    if(server.openIt(port) != 1){
+        std::cout << "could not open the server" << std::endl;
+        return 1;
+    }
+
+    std::cout << "mode,connections,threads,seconds,connects_per_sec,peak_clients,slabs" << std::endl;
+    for(bool hold : {false, true}){
+        int total = hold ? HELDCONNECTS : CHURNCONNECTS;
+        std::thread loop([&]{
+            reactor.run();
+        });
+        double secs = storm(port, total, hold);
+        reactor.stop();
+        loop.join();
+
+        //only read once the reactor thread is done with it
+        std::cout << (hold ? "held" : "churn") << "," << total << "," << CONNECTORS << ","
+                    << secs << "," << total / secs << ","
+                    << server.getPeakClients() << "," << server.getSlabCount() << std::endl;
+    }
+
+    server.closeIt();
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "socketLib.hpp"
+#include "packetHelpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+
+/*What getPacket()/sendPacket() cost per 100 byte packet on loopback,
+with the poll() + recv()/sendmsg() path and with useUring():
+    stream   -> the peer sends PACKETS packets as fast as it can,
+                the Client takes them out with getPacket()
+    pingpong -> the Client sends a packet and waits for the peer to
+                echo it back, PINGS times
+    batch    -> sendPackets() of MAXSENDBATCH packets at a time to a
+                peer that only reads
+
+everything goes to stdout as CSV:
+    make -s uringBench > bench_output.txt
+*/
+
+const int PACKETS = 200000;     // packets per stream row
+const int PINGS = 20000;        // round trips per pingpong row
+const int BATCHES = 2000;       // sendPackets() calls per batch row
+const size_t PACKETSIZE = 100;  // message bytes in every packet
+
+enum PeerMode{
+    STREAM,
+    ECHO,
+    DRAIN
+};
+
+/*the other end of the connection, a plain socket*/
+void peer(int port, PeerMode mode){
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1){
+        std::cout << "peer could not connect" << std::endl;
+        close(fd);
+        return;
+    }
+    std::vector<char> dest(256 * 1024);
+    if(mode == STREAM){
+        //a lot of packets per send(), like a busy sender would
+        std::string packet = testing::makePacket("bench", std::string(PACKETSIZE, 's'));
+        std::string chunk;
+        for(int i = 0;i<64;i++){
+            chunk += packet;
+        }
+        for(int sent = 0;sent<PACKETS;sent += 64){
+            size_t off = 0;
+            while(off < chunk.size()){
+                ssize_t val = send(fd, chunk.data() + off, chunk.size() - off, MSG_NOSIGNAL);
+                if(val <= 0){
+                    close(fd);
+                    return;
+                }
+                off += val;
+            }
+        }
+    }
+    //ECHO sends back whatever comes in, DRAIN just reads it
+    ssize_t val;
+    while((val = recv(fd, dest.data(), dest.size(), 0)) > 0){
+        if(mode == ECHO && send(fd, dest.data(), val, MSG_NOSIGNAL) != val){
+            break;
+        }
+    }
+    close(fd);
+}
+
+void printRow(const std::string& backend, const std::string& test, int packets,
+                double secs, uint64_t sendCalls){
+    std::cout << backend << "," << test << "," << packets << ","
+                << secs * 1e9 / packets << ","
+                << (double)sendCalls / packets << std::endl;
+}
+
+/*runs one row: connects a peer in mode, moves c onto io_uring if
+uring, and times test on it*/
+template<typename Test>
+void bench(socketstuffs::Socket& s, bool uring, PeerMode mode, const std::string& name,
+            int packets, Test test){
+    std::thread other(peer, s.getPort(), mode);
+    socketstuffs::Client c;
+    if(c.connectIt(s) != 1){
+        std::cout << "could not connect the client" << std::endl;
+        other.join();
+        return;
+    }
+    if(uring && c.useUring() != 1){
+        std::cout << "io_uring isn't available here" << std::endl;
+        c.closeIt();
+        other.join();
+        return;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    test(c);
+    auto finish = std::chrono::steady_clock::now();
+    printRow(uring ? "uring" : "poll", name, packets,
+                std::chrono::duration<double>(finish - begin).count(), c.getSendCalls());
+    c.closeIt();
+    other.join();
+}
+
+int main(){
+    std::vector<int> validPorts;
+    socketstuffs::getValidScannedPorts(9000, 9100, validPorts);
+    if(validPorts.empty()){
+        std::cout << "no free port to bench on" << std::endl;
+        return 1;
+    }
+    socketstuffs::Socket s;
+    if(s.openIt(validPorts[0]) != 1){
+        std::cout << "could not open the socket" << std::endl;
+        return 1;
+    }
+
+    std::string message(PACKETSIZE, 'p');
+    std::vector<socketstuffs::OutFrame> frames(socketstuffs::MAXSENDBATCH,
+                                                socketstuffs::OutFrame{"bench", message});
+
+    std::cout << "backend,test,packets,ns_per_packet,send_calls_per_packet" << std::endl;
+    for(bool uring : {false, true}){
+        bench(s, uring, STREAM, "stream", PACKETS, [](socketstuffs::Client& c){
+            std::string id, got;
+            for(int i = 0;i<PACKETS;i++){
+                got.clear();
+                if(c.getPacket(id, got) != 1){
+                    std::cout << "getPacket failed" << std::endl;
+                    return;
+                }
+            }
+        });
+        bench(s, uring, ECHO, "pingpong", PINGS, [&](socketstuffs::Client& c){
+            std::string id, got;
+            for(int i = 0;i<PINGS;i++){
+                got.clear();
+                if(c.sendPacket("bench", message) != 1 || c.getPacket(id, got) != 1){
+                    std::cout << "ping failed" << std::endl;
+                    return;
+                }
+            }
+        });
+        bench(s, uring, DRAIN, "batch", BATCHES * socketstuffs::MAXSENDBATCH, [&](socketstuffs::Client& c){
+            for(int i = 0;i<BATCHES;i++){
+                if(c.sendPackets(frames) != 1){
+                    std::cout << "sendPackets failed" << std::endl;
+                    return;
+                }
+            }
+        });
+    }
+
+    s.closeIt();
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "socketLib.hpp"
+#include "testingSuite.hpp"
+#include "packetHelpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+
+void testUring(){
+    testing::TestSuite t("io_uring backend", "uring.hpp");
+
+    socketstuffs::Client c;
+    t.test("not connected", c.useUring() == socketstuffs::NOTOPENED && !c.usingUring());
+
+    int pair[2];
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == -1){
+        throw std::runtime_error("could not make a socketpair\nin testUring() in uringTester.cpp");
+    }
+    c.connectIt(pair[0]);
+    //few small buffers, so a big packet uses all of them and the
+    // recv has to be started again once they're given back
+    int val = c.useUring(4, 4096);
+    if(val == socketstuffs::NOURING){
+        std::cout << "io_uring isn't available here, skipping" << std::endl;
+        c.closeIt();
+        close(pair[1]);
+        t.printFinalOutput();
+        return;
+    }
+    t.test("useUring", val == 1 && c.usingUring());
+
+    std::string id, message;
+    t.test("tryGetPacket with nothing there", c.tryGetPacket(id, message) == 0 && c.isDrained());
+
+    std::string big(100 * 1024, 'u');
+    std::thread peer([&]{
+        std::string burst;
+        for(int i = 0;i<10;i++){
+            burst += testing::makePacket("p" + std::to_string(i), "packet " + std::to_string(i));
+        }
+        burst += testing::makePacket("big", big);
+        testing::sendAll(pair[1], burst);
+    });
+    int inOrder = 0;
+    for(int i = 0;i<10;i++){
+        //getPacket appends to message
+        message.clear();
+        if(c.getPacket(id, message) == 1 && id == "p" + std::to_string(i)
+                && message == "packet " + std::to_string(i)){
+            inOrder++;
+        }
+    }
+    t.test("small packets in order", inOrder == 10);
+    message.clear();
+    t.test("a packet bigger than every buffer", c.getPacket(id, message) == 1 && id == "big" && message == big);
+    peer.join();
+
+    t.test("sendPacket", c.sendPacket("back", "hello") == 1
+                            && testing::readExactly(pair[1], testing::makePacket("back", "hello").size()) == testing::makePacket("back", "hello"));
+    std::vector<socketstuffs::OutFrame> frames = {{"a", "one"}, {"b", "two"}};
+    t.test("sendPackets", c.sendPackets(frames) == 1
+                            && testing::readExactly(pair[1], testing::makePacket("a", "one").size() * 2) == testing::makePacket("a", "one") + testing::makePacket("b", "two"));
+
+    t.test("the reader thread can't run with it", c.startReader() == socketstuffs::BADRINGTYPE);
+
+    close(pair[1]);
+    message.clear();
+    t.test("hang up", c.getPacket(id, message) == socketstuffs::READCLOSE);
+
+    c.closeIt();
+    t.test("closeIt turns it off", !c.usingUring() && c.getFd() == -1);
+
+    t.printFinalOutput();
+}
+
+void testSetupFailing(){
+    testing::TestSuite t("io_uring setup failing half way", "uring.hpp");
+
+    int pair[2];
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == -1){
+        throw std::runtime_error("could not make a socketpair\nin testSetupFailing() in uringTester.cpp");
+    }
+    uring::Transport transport;
+    //the rings are made, then the buffers are too big to map
+    auto begin = std::chrono::steady_clock::now();
+    int val = transport.open(pair[0], 1, (size_t)1 << 50);
+    auto took = std::chrono::steady_clock::now() - begin;
+    if(val == uring::SETUPFAILED && transport.open(pair[0], 4, 4096) == uring::SETUPFAILED){
+        std::cout << "io_uring isn't available here, skipping" << std::endl;
+    }
+    else{
+        t.test("buffers that can't be mapped", val == uring::SETUPFAILED);
+        t.test("the failed open doesn't wait on a recv that never started", took < std::chrono::milliseconds(50));
+        t.test("opening it again after that", transport.isOpen());
+    }
+    transport.closeIt();
+    close(pair[0]);
+    close(pair[1]);
+
+    t.printFinalOutput();
+}
+
+int main(){
+    testUring();
+    testSetupFailing();
+
+    return 0;
+}